@@ -14,6 +14,7 @@
 
 #define CAGD_BEZ_CLIP_TOLERANCE 1e-4 
 #define MULTIPLE_INTRS_TOLERANCE 0.60
+#define CAGD_RAY_TRACE_BBOX_EPS 1e-6
 
 IRIT_STATIC_DATA CagdRType
     MultipleIntrsTol = MULTIPLE_INTRS_TOLERANCE;
@@ -23,6 +24,23 @@ typedef struct CagdRayStruct {
     IrtVecType Direction;
 } CagdRayStruct;
 
+typedef struct CagdRayTrcPatchStruct {	   /* A Bezier patch of input surface. */
+    CagdSrfStruct *BzrSrf;
+    CagdBBoxStruct BBox;
+    CagdRType UMin, UMax, VMin, VMax;	      /* Domain in the input surface. */
+} CagdRayTrcPatchStruct;
+
+typedef struct CagdRayTrcSrfStruct {	    /* Bounds all patches of a surface. */
+    CagdBBoxStruct BBox;
+    int FirstPatch, NumPatches;
+} CagdRayTrcSrfStruct;
+
+typedef struct CagdRayTrcPrepStruct {
+    int NumSrfs, NumPatches;
+    CagdRayTrcSrfStruct *Srfs;
+    CagdRayTrcPatchStruct *Patches;
+} CagdRayTrcPrepStruct;
+
 static int BzrClipping(CagdSrfStruct *Srf,
                        CagdSrfDirType Dir,
                        CagdRType RealU0,
@@ -83,6 +101,12 @@ static CagdBType SmallPatchCheck(CagdSrfStruct *Srf,
                                  CagdRType MaxU,
                                  CagdRType MinV,
                                  CagdRType MaxV);
+static CagdSrfStruct *RayTrcSrf2BzrPatches(const CagdSrfStruct *Srf);
+static CagdBType RayTrcHitBBox(const CagdRType *StPt,
+			       const CagdRType *Dir,
+			       const CagdBBoxStruct *BBox,
+			       CagdRType MaxT,
+			       CagdRType *EntryT);
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -154,7 +178,7 @@ CagdBType CagdRayTraceBzrSrf(CagdPType StPt,
         TempListOfPrm=CagdUVNew();
         TempListOfPrm -> UV[0] = (MinU + MaxU) * 0.5;
         TempListOfPrm -> UV[1] = (MinV + MaxV) * 0.5;
-        TempListOfPrm = *IntrPrm; 
+        TempListOfPrm -> Pnext = *IntrPrm;
         *IntrPrm = TempListOfPrm;
         
         MyBzrSrfEvalAtParam(BzrSrf,
@@ -165,7 +189,7 @@ CagdBType CagdRayTraceBzrSrf(CagdPType StPt,
         TempListOfPt -> Pt[0] = TempPt[0];
         TempListOfPt -> Pt[1] = TempPt[1];
         TempListOfPt -> Pt[2] = TempPt[2];
-        TempListOfPt = *IntrPt;
+        TempListOfPt -> Pnext = *IntrPt;
         *IntrPt = TempListOfPt;
         CagdSrfFree(ProjectedSrf);
         return TRUE;
@@ -235,6 +259,369 @@ CagdRType CagdRayTraceMultIntrsTol(CagdRType Tol)
     return OldVal;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Splits a freeform surface into Bezier patches, each holding the domain   *
+* it covers in the input surface as "BspDomainMin/Max" attributes.           *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Srf:      Surface to split into Bezier patches.                          *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdSrfStruct *:   List of Bezier patches, or NULL if unsupported type.  *
+*****************************************************************************/
+static CagdSrfStruct *RayTrcSrf2BzrPatches(const CagdSrfStruct *Srf)
+{
+    CagdSrfStruct *TSrf, *BzrSrfs;
+
+    switch (Srf -> GType) {
+	case CAGD_SBEZIER_TYPE:
+	    BzrSrfs = CagdSrfCopy(Srf);
+	    AttrSetUVAttrib(&BzrSrfs -> Attr, "BspDomainMin", 0.0, 0.0);
+	    AttrSetUVAttrib(&BzrSrfs -> Attr, "BspDomainMax", 1.0, 1.0);
+	    return BzrSrfs;
+	case CAGD_SBSPLINE_TYPE:
+	    if (CAGD_IS_PERIODIC_SRF(Srf)) {
+		TSrf = CagdCnvrtPeriodic2FloatSrf(Srf);
+		BzrSrfs = CagdCnvrtBsp2BzrSrf(TSrf);
+		CagdSrfFree(TSrf);
+	    }
+	    else
+		BzrSrfs = CagdCnvrtBsp2BzrSrf(Srf);
+	    return BzrSrfs;
+	case CAGD_SPOWER_TYPE:
+	    BzrSrfs = CagdCnvrtPwr2BzrSrf(Srf);
+	    AttrSetUVAttrib(&BzrSrfs -> Attr, "BspDomainMin", 0.0, 0.0);
+	    AttrSetUVAttrib(&BzrSrfs -> Attr, "BspDomainMax", 1.0, 1.0);
+	    return BzrSrfs;
+	default:
+	    CAGD_FATAL_ERROR(CAGD_ERR_UNDEF_SRF);
+	    return NULL;
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Prepares a list of freeform surfaces for packet ray tracing.  Every      M
+* surface is split once into its Bezier patches, and a two level bounding    M
+* box hierarchy (surface, patch) is built over them so rays are culled       M
+* before the (expensive) Bezier clipping is invoked.                         M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Srfs:      List of surfaces to prepare for ray tracing.                  M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   VoidPtr:   A handle to the prepared data, or NULL if error.  Free with   M
+*	       CagdRayTraceFreePrepSrfs.				     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   CagdRayTraceSrfsPacket, CagdRayTraceFreePrepSrfs, CagdRayTraceBzrSrf     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   CagdRayTracePrepSrfs                                                     M
+*****************************************************************************/
+VoidPtr CagdRayTracePrepSrfs(const CagdSrfStruct *Srfs)
+{
+    int i, j;
+    const CagdSrfStruct *Srf;
+    CagdSrfStruct *BzrSrf, **SrfsBzrs;
+    CagdRayTrcPrepStruct *Prep;
+
+    Prep = (CagdRayTrcPrepStruct *) IritMalloc(sizeof(CagdRayTrcPrepStruct));
+    Prep -> NumSrfs = CagdListLength(Srfs);
+    Prep -> NumPatches = 0;
+    if (Prep -> NumSrfs == 0) {
+        IritFree(Prep);
+	return NULL;
+    }
+
+    /* Split all surfaces into Bezier patches first, to count the patches. */
+    SrfsBzrs = (CagdSrfStruct **) IritMalloc(sizeof(CagdSrfStruct *) *
+					     Prep -> NumSrfs);
+    for (Srf = Srfs, i = 0; Srf != NULL; Srf = Srf -> Pnext, i++) {
+        SrfsBzrs[i] = RayTrcSrf2BzrPatches(Srf);
+	Prep -> NumPatches += CagdListLength(SrfsBzrs[i]);
+    }
+
+    Prep -> Srfs = (CagdRayTrcSrfStruct *)
+        IritMalloc(sizeof(CagdRayTrcSrfStruct) * Prep -> NumSrfs);
+    Prep -> Patches = (CagdRayTrcPatchStruct *)
+        IritMalloc(sizeof(CagdRayTrcPatchStruct) *
+		   IRIT_MAX(Prep -> NumPatches, 1));
+
+    for (i = j = 0; i < Prep -> NumSrfs; i++) {
+        CagdRayTrcSrfStruct
+	    *SrfNode = &Prep -> Srfs[i];
+	CagdBBoxStruct
+	    *SrfBBox = &SrfNode -> BBox;
+
+	SrfNode -> FirstPatch = j;
+	SrfNode -> NumPatches = 0;
+	CAGD_RESET_BBOX(SrfBBox);
+
+	while ((BzrSrf = SrfsBzrs[i]) != NULL) {
+	    float *UV;
+	    CagdRayTrcPatchStruct
+	        *Patch = &Prep -> Patches[j++];
+
+	    SrfsBzrs[i] = BzrSrf -> Pnext;
+	    BzrSrf -> Pnext = NULL;
+
+	    Patch -> BzrSrf = BzrSrf;
+	    CagdSrfBBox(BzrSrf, &Patch -> BBox);
+	    CagdMergeBBox(SrfBBox, &Patch -> BBox);
+
+	    if ((UV = AttrGetUVAttrib(BzrSrf -> Attr,
+				      "BspDomainMin")) != NULL) {
+	        Patch -> UMin = UV[0];
+	        Patch -> VMin = UV[1];
+	    }
+	    else
+	        Patch -> UMin = Patch -> VMin = 0.0;
+	    if ((UV = AttrGetUVAttrib(BzrSrf -> Attr,
+				      "BspDomainMax")) != NULL) {
+	        Patch -> UMax = UV[0];
+	        Patch -> VMax = UV[1];
+	    }
+	    else
+	        Patch -> UMax = Patch -> VMax = 1.0;
+
+	    SrfNode -> NumPatches++;
+	}
+    }
+
+    IritFree(SrfsBzrs);
+
+    return Prep;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Releases the data allocated by CagdRayTracePrepSrfs.                     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   RayTrcPrep:   Handle returned by CagdRayTracePrepSrfs.                   M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   CagdRayTracePrepSrfs                                                     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   CagdRayTraceFreePrepSrfs                                                 M
+*****************************************************************************/
+void CagdRayTraceFreePrepSrfs(VoidPtr RayTrcPrep)
+{
+    int i;
+    CagdRayTrcPrepStruct
+        *Prep = (CagdRayTrcPrepStruct *) RayTrcPrep;
+
+    if (Prep == NULL)
+        return;
+
+    for (i = 0; i < Prep -> NumPatches; i++)
+        CagdSrfFree(Prep -> Patches[i].BzrSrf);
+
+    IritFree(Prep -> Patches);
+    IritFree(Prep -> Srfs);
+    IritFree(Prep);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Slab test of a ray against an (slightly enlarged) axis parallel box.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   StPt, Dir:   The ray, as StPt + t * Dir, t >= 0.                         *
+*   BBox:        Box to test against.                                        *
+*   MaxT:        Entry parameters beyond MaxT are considered a miss.         *
+*   EntryT:      Ray parameter where the ray enters the box.                 *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdBType:   TRUE if the ray hits the box before MaxT.                   *
+*****************************************************************************/
+static CagdBType RayTrcHitBBox(const CagdRType *StPt,
+			       const CagdRType *Dir,
+			       const CagdBBoxStruct *BBox,
+			       CagdRType MaxT,
+			       CagdRType *EntryT)
+{
+    int l;
+    CagdRType
+        TMin = 0.0,
+        TMax = MaxT;
+
+    for (l = 0; l < 3; l++) {
+        CagdRType t1, t2,
+	    Min = BBox -> Min[l] - CAGD_RAY_TRACE_BBOX_EPS,
+	    Max = BBox -> Max[l] + CAGD_RAY_TRACE_BBOX_EPS;
+
+	if (IRIT_FABS(Dir[l]) < IRIT_UEPS) {
+	    if (StPt[l] < Min || StPt[l] > Max)
+	        return FALSE;
+	    continue;
+	}
+
+	t1 = (Min - StPt[l]) / Dir[l];
+	t2 = (Max - StPt[l]) / Dir[l];
+	if (t1 > t2)
+	    IRIT_SWAP(CagdRType, t1, t2);
+	if (t1 > TMin)
+	    TMin = t1;
+	if (t2 < TMax)
+	    TMax = t2;
+	if (TMin > TMax)
+	    return FALSE;
+    }
+
+    *EntryT = TMin;
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Traces a packet of (typically coherent) rays against surfaces prepared   M
+* by CagdRayTracePrepSrfs, finding the closest hit of every ray.             M
+*   The packet is culled as a whole against every surface's bounding box     M
+* and then against every patch's bounding box, so Bezier clipping (see       M
+* CagdRayTraceBzrSrf) is only invoked for ray-patch pairs whose boxes are    M
+* hit closer than the closest hit found so far for that ray.		     M
+*   An optional HitTest call back can reject hits, for example outside the   M
+* trimming curves of a trimmed surface (see TrimRayTraceSrfsPacket).  A ray  M
+* with a rejected hit continues to look for farther hits.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   RayTrcPrep: Handle returned by CagdRayTracePrepSrfs.                     M
+*   NumRays:    Number of rays in the packet.                                M
+*   StPts:      Start points of the rays, NumRays of them.                   M
+*   Dirs:       Directions of the rays, NumRays of them.                     M
+*   SrfIndices: Index of the hit surface in the list given to                M
+*		CagdRayTracePrepSrfs, per ray, or -1 if the ray missed.      M
+*   InterUVs:   UV parameters of the closest hit, in the domain of the hit   M
+*		surface, per ray.  Undefined where missed.		     M
+*   InterTs:    Ray parameter t of the closest hit, StPt + t * Dir, per ray. M
+*		Undefined where missed.					     M
+*   HitTest:    Optional call back to accept (TRUE) or reject (FALSE) a hit, M
+*		given the surface index and the UV of the hit.  Can be NULL. M
+*   HitTestData: Passed to HitTest as is.				     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:        Number of rays in the packet that hit some surface.          M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   CagdRayTracePrepSrfs, CagdRayTraceBzrSrf, TrimRayTraceSrfsPacket         M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   CagdRayTraceSrfsPacket                                                   M
+*****************************************************************************/
+int CagdRayTraceSrfsPacket(VoidPtr RayTrcPrep,
+			   int NumRays,
+			   const CagdPType *StPts,
+			   const CagdVType *Dirs,
+			   int *SrfIndices,
+			   CagdUVType *InterUVs,
+			   CagdRType *InterTs,
+			   CagdRayTraceHitTestFuncType HitTest,
+			   VoidPtr HitTestData)
+{
+    int i, j, k, NumSrfRays, NumPatchRays,
+        NumHits = 0;
+    int *SrfRays, *PatchRays;
+    CagdRType t, DirLenSqr;
+    CagdRayTrcPrepStruct
+        *Prep = (CagdRayTrcPrepStruct *) RayTrcPrep;
+
+    for (i = 0; i < NumRays; i++) {
+        SrfIndices[i] = -1;
+	InterTs[i] = IRIT_INFNTY;
+    }
+    if (Prep == NULL || NumRays <= 0)
+        return 0;
+
+    SrfRays = (int *) IritMalloc(sizeof(int) * NumRays * 2);
+    PatchRays = &SrfRays[NumRays];
+
+    for (i = 0; i < Prep -> NumSrfs; i++) {
+        const CagdRayTrcSrfStruct
+	    *SrfNode = &Prep -> Srfs[i];
+
+	/* Cull the packet against the bounding box of the entire surface. */
+        for (k = NumSrfRays = 0; k < NumRays; k++) {
+	    if (RayTrcHitBBox(StPts[k], Dirs[k], &SrfNode -> BBox,
+			      InterTs[k], &t))
+	        SrfRays[NumSrfRays++] = k;
+	}
+	if (NumSrfRays == 0)
+	    continue;
+
+	for (j = 0; j < SrfNode -> NumPatches; j++) {
+	    const CagdRayTrcPatchStruct
+	        *Patch = &Prep -> Patches[SrfNode -> FirstPatch + j];
+
+	    /* Cull the surviving rays against this patch's bounding box. */
+	    for (k = NumPatchRays = 0; k < NumSrfRays; k++) {
+	        int r = SrfRays[k];
+
+	        if (RayTrcHitBBox(StPts[r], Dirs[r], &Patch -> BBox,
+				  InterTs[r], &t))
+		    PatchRays[NumPatchRays++] = r;
+	    }
+
+	    for (k = 0; k < NumPatchRays; k++) {
+	        int r = PatchRays[k];
+		CagdPType StPt;
+		CagdVType Dir;
+		CagdUVStruct *UV, *IntrPrm;
+		CagdPtStruct *Pt, *IntrPt;
+
+		IRIT_PT_COPY(StPt, StPts[r]);
+		IRIT_VEC_COPY(Dir, Dirs[r]);
+		if (!CagdRayTraceBzrSrf(StPt, Dir, Patch -> BzrSrf,
+					&IntrPrm, &IntrPt)) {
+		    CagdUVFreeList(IntrPrm);
+		    CagdPtFreeList(IntrPt);
+		    continue;
+		}
+
+		DirLenSqr = IRIT_DOT_PROD(Dir, Dir);
+		for (UV = IntrPrm, Pt = IntrPt;
+		     UV != NULL && Pt != NULL;
+		     UV = UV -> Pnext, Pt = Pt -> Pnext) {
+		    CagdVType V;
+		    CagdUVType SrfUV;
+
+		    IRIT_PT_SUB(V, Pt -> Pt, StPt);
+		    t = IRIT_DOT_PROD(V, Dir) / DirLenSqr;
+		    if (t < 0.0 || t >= InterTs[r])
+		        continue;
+
+		    SrfUV[0] = Patch -> UMin +
+				 UV -> UV[0] * (Patch -> UMax - Patch -> UMin);
+		    SrfUV[1] = Patch -> VMin +
+				 UV -> UV[1] * (Patch -> VMax - Patch -> VMin);
+		    if (HitTest != NULL && !HitTest(i, SrfUV, HitTestData))
+		        continue;
+
+		    if (SrfIndices[r] < 0)
+		        NumHits++;
+		    SrfIndices[r] = i;
+		    InterTs[r] = t;
+		    InterUVs[r][0] = SrfUV[0];
+		    InterUVs[r][1] = SrfUV[1];
+		}
+
+		CagdUVFreeList(IntrPrm);
+		CagdPtFreeList(IntrPt);
+	    }
+	}
+    }
+
+    IritFree(SrfRays);
+
+    return NumHits;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 *   Bezier Clipping of projected rational Bezier surface patch to R^2.       *
@@ -558,8 +945,9 @@ static CagdSrfStruct *ProjectionToR2(CagdRayStruct Ray,
         y = Srf -> Points[2][i];
         z = Srf -> Points[3][i];
         
-        Dist1 = w * (Pl1[0] * x + Pl1[1] * y + Pl1[2] * z + Pl1[3]);
-        Dist2 = w * (Pl2[0] * x + Pl2[1] * y + Pl2[2] * z + Pl2[3]);
+        /* Rational control points are already premultiplied by w. */
+        Dist1 = Pl1[0] * x + Pl1[1] * y + Pl1[2] * z + Pl1[3] * w;
+        Dist2 = Pl2[0] * x + Pl2[1] * y + Pl2[2] * z + Pl2[3] * w;
         
         ProjectedSrf -> Points[1][i] = Dist1;
         ProjectedSrf -> Points[2][i] = Dist2;
@@ -95,13 +95,18 @@ CagdCrvStruct *BspCrvKnotInsert(const CagdCrvStruct *Crv, CagdRType t)
 	CAGD_GEN_COPY(NewPoints[i], Points[i],
 		      sizeof(CagdRType) * (Index - k + 2));
 
-    /* Case 2: Convex blend of exactly 2 points. */
-    for (j = Index - k + 2; j <= Index; j++)
+    /* Case 2: Convex blend of exactly 2 points.  The blending factor only */
+    /* depends on the knots so compute it once for all coordinates.	    */
+    for (j = Index - k + 2; j <= Index; j++) {
+        CagdRType
+	    Alpha = (t - KnotVector[j]) /
+				     (KnotVector[j + k - 1] - KnotVector[j]),
+	    Alpha1 = 1.0 - Alpha;
+
 	for (i = IsNotRational; i <= MaxCoord; i++)
-	    NewPoints[i][j] =
-	       ((t - KnotVector[j]) * Points[i][j] +
-		(KnotVector[j + k - 1] - t) * Points[i][j - 1]) /
-				      (KnotVector[j + k - 1] - KnotVector[j]);
+	    NewPoints[i][j] = Alpha * Points[i][j] +
+			      Alpha1 * Points[i][j - 1];
+    }
 
     /* Case 3: Copy all points upto the end. */
     for (i = IsNotRational; i <= MaxCoord; i++)
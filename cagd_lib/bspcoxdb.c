@@ -71,9 +71,29 @@ CagdRType *BspCrvEvalCoxDeBoor(const CagdCrvStruct *Crv, CagdRType t)
     else {
 	for (i = IsNotRational; i <= MaxCoord; i++, pPt++) {
 	    pPoints = &Crv -> Points[i][IndexFirst];
-	    pBasisFunc = BasisFunc;
-	    for (l = 0; l++ < k; )
-	        *pPt += *pPoints++ * *pBasisFunc++;
+
+	    switch (k) {
+	        case 2:
+		    *pPt = pPoints[0] * BasisFunc[0] +
+		           pPoints[1] * BasisFunc[1];
+		    break;
+	        case 3:
+		    *pPt = pPoints[0] * BasisFunc[0] +
+		           pPoints[1] * BasisFunc[1] +
+		           pPoints[2] * BasisFunc[2];
+		    break;
+	        case 4:
+		    *pPt = pPoints[0] * BasisFunc[0] +
+		           pPoints[1] * BasisFunc[1] +
+		           pPoints[2] * BasisFunc[2] +
+		           pPoints[3] * BasisFunc[3];
+		    break;
+	        default:
+		    pBasisFunc = BasisFunc;
+		    for (l = 0; l++ < k; )
+		        *pPt += *pPoints++ * *pBasisFunc++;
+		    break;
+	    }
 	}
     }
 
@@ -18,9 +18,22 @@
 void CagdDbgPrintAlphaMat(BspKnotAlphaCoeffStruct *A);
 #endif /* DEBUG */
 
+IRIT_STATIC_DATA int
+    GlblAlphaCacheLen = 0,
+    GlblAlphaCacheSize = CAGD_DEF_ALPHA_COEF_CACHE_SIZE;
+IRIT_STATIC_DATA long
+    GlblAlphaCacheBytes = 0;		  /* Total size of cached matrices. */
 IRIT_STATIC_DATA BspKnotAlphaCoeffStruct
-    *GlblCachedA = NULL;
-
+    *GlblAlphaCache[CAGD_MAX_ALPHA_COEF_CACHE_SIZE];  /* Most recent first. */
+
+static BspKnotAlphaCoeffStruct *BspKnotAlphaCacheFetch(int k,
+						       CagdRType *KVT,
+						       int LengthKVT,
+						       CagdRType *KVt,
+						       int LengthKVt,
+						       int Periodic,
+						       CagdBType *Exact);
+static long BspKnotAlphaCoefBytes(const BspKnotAlphaCoeffStruct *A);
 static void BspKnotAlphaCoefFree(BspKnotAlphaCoeffStruct *A);
 
 /*****************************************************************************
@@ -90,6 +103,7 @@ BspKnotAlphaCoeffStruct *BspKnotEvalAlphaCoef(int k,
 	NoZeroKVtLen = 0,
 	*NoZeroKVtMin = NULL,
 	*NoZeroKVtMax = NULL;
+    CagdBType Exact;
     int Size, i, j, o, NextStart, *ColLen, *ColIdx;
     CagdRType *m, **r, **Rows, **RowsTransp;
     BspKnotAlphaCoeffStruct *A;
@@ -118,22 +132,14 @@ BspKnotAlphaCoeffStruct *BspKnotEvalAlphaCoef(int k,
 
     Size = (LengthKVT + 1) * (LengthKVt + 1);
 
-    if (GlblCachedA != NULL &&
-	GlblCachedA -> RefLength == LengthKVt &&
-	GlblCachedA -> Length == LengthKVT &&
-	GlblCachedA -> Order == k &&
-	GlblCachedA -> Periodic == Periodic) {
-	A = GlblCachedA;
-	GlblCachedA = NULL;
-
-        if (IRIT_GEN_CMP(KVt, A -> _CacheKVt,
-		    sizeof(CagdRType) * (LengthKVt + k)) == 0 &&
-	    IRIT_GEN_CMP(KVT, A -> _CacheKVT,
-		    sizeof(CagdRType) * (LengthKVT + k)) == 0) {
+    if ((A = BspKnotAlphaCacheFetch(k, KVT, LengthKVT, KVt, LengthKVt,
+				    Periodic, &Exact)) != NULL) {
+        if (Exact) {
 	    /* We found exact match - return cached matrix. */
 	    return A;
 	}
 	else {
+	    /* Same dimensions - recycle the memory of the cached matrix. */
 	    Rows = A -> Rows;
 	    RowsTransp = A -> RowsTransp;
 	    ColIdx = A -> ColIndex;
@@ -434,6 +440,120 @@ BspKnotAlphaCoeffStruct *BspKnotEvalAlphaCoef(int k,
     return A;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Searches the cache of alpha matrices for one that refines KVT into KVt.  *
+* A matrix with identical knot sequences is preferred.  Otherwise, the least *
+* recently used matrix of identical dimensions is returned so its memory can *
+* be recycled.  The returned matrix is removed from the cache and is owned   *
+* by the caller until released via BspKnotFreeAlphaCoef.		     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   k:           Order of geometry.                                          *
+*   KVT:         Original knot vector.                                       *
+*   LengthKVT:   Length of original control polygon with KVT knot vector.    *
+*   KVt:         Refined knot vector.					     *
+*   LengthKVt:   Length of refined control polygon with KVt knot vector.     *
+*   Periodic:    If the refinement is for a periodic entity.		     *
+*   Exact:       Set to TRUE if the returned matrix is for KVT and KVt.	     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   BspKnotAlphaCoeffStruct *:   Cached matrix or NULL if none is found.     *
+*****************************************************************************/
+static BspKnotAlphaCoeffStruct *BspKnotAlphaCacheFetch(int k,
+						       CagdRType *KVT,
+						       int LengthKVT,
+						       CagdRType *KVt,
+						       int LengthKVt,
+						       int Periodic,
+						       CagdBType *Exact)
+{
+    int i,
+	Found = -1;
+    BspKnotAlphaCoeffStruct *A;
+
+    *Exact = FALSE;
+
+    for (i = 0; i < GlblAlphaCacheLen; i++) {
+        A = GlblAlphaCache[i];
+
+	if (A -> RefLength == LengthKVt &&
+	    A -> Length == LengthKVT &&
+	    A -> Order == k &&
+	    A -> Periodic == Periodic) {
+	    if (IRIT_GEN_CMP(KVt, A -> _CacheKVt,
+			     sizeof(CagdRType) * (LengthKVt + k)) == 0 &&
+		IRIT_GEN_CMP(KVT, A -> _CacheKVT,
+			     sizeof(CagdRType) * (LengthKVT + k)) == 0) {
+	        *Exact = TRUE;
+		Found = i;
+		break;
+	    }
+
+	    Found = i;		     /* Keep the least recently used match. */
+	}
+    }
+
+    if (Found < 0)
+        return NULL;
+
+    A = GlblAlphaCache[Found];
+    for (i = Found + 1; i < GlblAlphaCacheLen; i++)
+        GlblAlphaCache[i - 1] = GlblAlphaCache[i];
+    GlblAlphaCacheLen--;
+    GlblAlphaCacheBytes -= BspKnotAlphaCoefBytes(A);
+
+    return A;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Sets the maximal number of alpha matrices kept in the refinement cache.  M
+* Released matrices (see BspKnotFreeAlphaCoef) are kept in this cache and    M
+* are returned as is by BspKnotEvalAlphaCoef if the same refinement, i.e.    M
+* same order and same original and refined knot sequences, is requested     M
+* again.  The least recently used matrix is purged when the cache is full.   M
+*   A size of zero disables the cache and frees all cached matrices.	     M
+*   Regardless of CacheSize, the cached matrices never take more than	     M
+* CAGD_MAX_ALPHA_COEF_CACHE_BYTES (16MB) in total: least recently used	     M
+* matrices are purged to make room and a larger matrix is never cached.      M
+* An alpha matrix of Length original and RefLength refined coefficients      M
+* takes about 2 * 8 * Length * RefLength bytes, so refining a curve with     M
+* 1000 coefficients into 2000 takes 32MB and is not cached.		     M
+*   The cache is global and is not locked, so it is not thread safe.  Set    M
+* the size to zero before refining B-spline geometry from several threads.  M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   CacheSize:  New size of cache, between zero and			     M
+*		CAGD_MAX_ALPHA_COEF_CACHE_SIZE.				     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:        Old size of cache.                                           M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   BspKnotEvalAlphaCoef, BspKnotFreeAlphaCoef                               M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   BspKnotSetAlphaCoefCacheSize, alpha matrix, refinement, caching          M
+*****************************************************************************/
+int BspKnotSetAlphaCoefCacheSize(int CacheSize)
+{
+    int OldSize = GlblAlphaCacheSize;
+    BspKnotAlphaCoeffStruct *A;
+
+    GlblAlphaCacheSize = IRIT_BOUND(CacheSize, 0,
+				    CAGD_MAX_ALPHA_COEF_CACHE_SIZE);
+
+    /* Purge the least recently used matrices that no longer fit. */
+    while (GlblAlphaCacheLen > GlblAlphaCacheSize) {
+        A = GlblAlphaCache[--GlblAlphaCacheLen];
+	GlblAlphaCacheBytes -= BspKnotAlphaCoefBytes(A);
+        BspKnotAlphaCoefFree(A);
+    }
+
+    return OldSize;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Copies the BspKnotAlphaCoeffStruct data structrure.                      M
@@ -536,6 +656,8 @@ BspKnotAlphaCoeffStruct *BspKnotCopyAlphaCoef(const BspKnotAlphaCoeffStruct *A)
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 * Frees the BspKnotAlphaCoeffStruct data structure.                          M
+*   The matrix is actually kept in a cache of recently used matrices so a    M
+* later identical refinement can reuse it.  See BspKnotSetAlphaCoefCacheSize.M
 *                                                                            *
 * PARAMETERS:                                                                M
 *   A:      Alpha matrix to free.                                            M
@@ -545,17 +667,56 @@ BspKnotAlphaCoeffStruct *BspKnotCopyAlphaCoef(const BspKnotAlphaCoeffStruct *A)
 *                                                                            *
 * SEE ALSO:                                                                  M
 *   BspKnotEvalAlphaCoef, BspKnotEvalAlphaCoefMerge, BspKnotCopyAlphaCoef,   M
-*   BspCrvKnotInsert, BspSrfKnotInsert	                                     M
+*   BspCrvKnotInsert, BspSrfKnotInsert, BspKnotSetAlphaCoefCacheSize         M
 *                                                                            *
 * KEYWORDS:                                                                  M
 *   BspKnotFreeAlphaCoef, alpha matrix, refinement                           M
 *****************************************************************************/
 void BspKnotFreeAlphaCoef(BspKnotAlphaCoeffStruct *A)
 {
-    if (GlblCachedA != NULL)
-        BspKnotAlphaCoefFree(GlblCachedA);
+    int i;
+    long
+	Bytes = BspKnotAlphaCoefBytes(A);
 
-    GlblCachedA = A;
+    if (GlblAlphaCacheSize == 0 || Bytes > CAGD_MAX_ALPHA_COEF_CACHE_BYTES) {
+        BspKnotAlphaCoefFree(A);
+	return;
+    }
+
+    /* Purge the least recently used matrices until A fits in the cache. */
+    while (GlblAlphaCacheLen >= GlblAlphaCacheSize ||
+	   GlblAlphaCacheBytes + Bytes > CAGD_MAX_ALPHA_COEF_CACHE_BYTES) {
+        BspKnotAlphaCoeffStruct
+	    *LRUA = GlblAlphaCache[--GlblAlphaCacheLen];
+
+	GlblAlphaCacheBytes -= BspKnotAlphaCoefBytes(LRUA);
+        BspKnotAlphaCoefFree(LRUA);
+    }
+
+    for (i = GlblAlphaCacheLen++; i > 0; i--)
+        GlblAlphaCache[i] = GlblAlphaCache[i - 1];
+    GlblAlphaCache[0] = A;
+    GlblAlphaCacheBytes += Bytes;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the memory size of the given alpha matrix, for the cache.       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   A:      Alpha matrix to compute its size.                                *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   long:   Size of A, in bytes.                                             *
+*****************************************************************************/
+static long BspKnotAlphaCoefBytes(const BspKnotAlphaCoeffStruct *A)
+{
+    return (long) sizeof(BspKnotAlphaCoeffStruct) +
+	2 * (long) sizeof(CagdRType) * (A -> Length + 1) * A -> RefLength +
+	(long) sizeof(CagdRType *) * (A -> Length + A -> RefLength + 2) +
+	2 * (long) sizeof(int) * A -> RefLength +
+	(long) sizeof(CagdRType) * (A -> Length + A -> RefLength +
+				    2 * A -> Order);
 }
 
 /*****************************************************************************
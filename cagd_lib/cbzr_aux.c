@@ -17,6 +17,13 @@ IRIT_STATIC_DATA CagdBType
 static CagdVecStruct *BzrCrvTangentAux(const CagdCrvStruct *Crv,
 				       CagdRType t,
 				       CagdBType Normalize);
+static void BzrCrvSubdivCtlPolyLowOrd(CagdRType * const *Points,
+				      CagdRType **LPoints,
+				      CagdRType **RPoints,
+				      int Length,
+				      CagdPointType PType,
+				      CagdRType t,
+				      int Step);
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -54,6 +61,12 @@ void BzrCrvSubdivCtlPoly(CagdRType * const *Points,
     CagdRType
 	t1 = 1.0 - t;
 
+    if (Length <= 4) {
+        BzrCrvSubdivCtlPolyLowOrd(Points, LPoints, RPoints, Length, PType,
+				  t, 1);
+	return;
+    }
+
     /* Copy Points into RPoints, so we can apply the recursive algo. to it.  */
     for (j = IsNotRational; j <= MaxCoord; j++)
         IRIT_GEN_COPY(RPoints[j], Points[j], Length * sizeof(CagdRType));
@@ -114,6 +127,12 @@ void BzrCrvSubdivCtlPolyStep(CagdRType * const *Points,
     CagdRType
 	t1 = 1.0 - t;
 
+    if (Length <= 4) {
+        BzrCrvSubdivCtlPolyLowOrd(Points, LPoints, RPoints, Length, PType,
+				  t, Step);
+	return;
+    }
+
     /* Copy Points into RPoints, so we can apply the recursive algo. to it.  */
     for (j = IsNotRational; j <= MaxCoord; j++) {
         CagdRType const
@@ -146,6 +165,97 @@ void BzrCrvSubdivCtlPolyStep(CagdRType * const *Points,
     }
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Fixed order de Casteljau subdivision of linear, quadratic and cubic      *
+* control polygons, fully unrolled.  All input coefficients of a coordinate  *
+* are fetched before any output is written so Points may be aliased with     *
+* either LPoints or RPoints.						     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Points:            To subdivide at parametr value t.                     *
+*   LPoints, RPoints:  Where the results are kept.			     *
+*   Length:	       Of this Bezier curve, between 1 and 4.		     *
+*   PType:	       Points types we have here.			     *
+*   t:                 Parameter value to subdivide data at.                 *
+*   Step:	       Stride along the data, 1 for curves.		     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void BzrCrvSubdivCtlPolyLowOrd(CagdRType * const *Points,
+				      CagdRType **LPoints,
+				      CagdRType **RPoints,
+				      int Length,
+				      CagdPointType PType,
+				      CagdRType t,
+				      int Step)
+{
+    CagdBType
+	IsNotRational = !CAGD_IS_RATIONAL_PT(PType);
+    int j,
+	Step2 = Step * 2,
+	Step3 = Step * 3,
+	MaxCoord = CAGD_NUM_OF_PT_COORD(PType);
+    CagdRType P0, P1, P2, P3, P01, P12, P23, P012, P123,
+	t1 = 1.0 - t;
+
+    for (j = IsNotRational; j <= MaxCoord; j++) {
+        CagdRType const
+	    *Pts = Points[j];
+	CagdRType
+	    *LPts = LPoints[j],
+	    *RPts = RPoints[j];
+
+	switch (Length) {
+	    case 1:
+		LPts[0] = RPts[0] = Pts[0];
+		break;
+	    case 2:
+		P0 = Pts[0];
+		P1 = Pts[Step];
+		P01 = t1 * P0 + t * P1;
+		LPts[0] = P0;
+		LPts[Step] = RPts[0] = P01;
+		RPts[Step] = P1;
+		break;
+	    case 3:
+		P0 = Pts[0];
+		P1 = Pts[Step];
+		P2 = Pts[Step2];
+		P01 = t1 * P0 + t * P1;
+		P12 = t1 * P1 + t * P2;
+		LPts[0] = P0;
+		LPts[Step] = P01;
+		LPts[Step2] = RPts[0] = t1 * P01 + t * P12;
+		RPts[Step] = P12;
+		RPts[Step2] = P2;
+		break;
+	    case 4:
+		P0 = Pts[0];
+		P1 = Pts[Step];
+		P2 = Pts[Step2];
+		P3 = Pts[Step3];
+		P01 = t1 * P0 + t * P1;
+		P12 = t1 * P1 + t * P2;
+		P23 = t1 * P2 + t * P3;
+		P012 = t1 * P01 + t * P12;
+		P123 = t1 * P12 + t * P23;
+		LPts[0] = P0;
+		LPts[Step] = P01;
+		LPts[Step2] = P012;
+		LPts[Step3] = RPts[0] = t1 * P012 + t * P123;
+		RPts[Step] = P123;
+		RPts[Step2] = P23;
+		RPts[Step3] = P3;
+		break;
+	    default:
+		assert(0);
+		break;
+	}
+    }
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 * Given a Bezier curve - subdivides it into two sub-curves at the given      M
@@ -263,11 +373,15 @@ CagdCrvStruct *BzrCrvDegreeRaise(const CagdCrvStruct *Crv)
     for (j = IsNotRational; j <= MaxCoord; j++)			    /* Q(0). */
 	RaisedCrv -> Points[j][0] = Crv -> Points[j][0];
 
-    for (i = 1; i < k; i++)					    /* Q(i). */
+    for (i = 1; i < k; i++) {					    /* Q(i). */
+        CagdRType
+	    Alpha = i / ((CagdRType) k),
+	    Alpha1 = 1.0 - Alpha;
+
 	for (j = IsNotRational; j <= MaxCoord; j++)
-	    RaisedCrv -> Points[j][i] =
-		Crv -> Points[j][i-1] * (i / ((CagdRType) k)) +
-		Crv -> Points[j][i] * ((k - i) / ((CagdRType) k));
+	    RaisedCrv -> Points[j][i] = Crv -> Points[j][i-1] * Alpha +
+					Crv -> Points[j][i] * Alpha1;
+    }
 
     for (j = IsNotRational; j <= MaxCoord; j++)			    /* Q(k). */
 	RaisedCrv -> Points[j][k] = Crv -> Points[j][k-1];
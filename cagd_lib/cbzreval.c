@@ -11,11 +11,15 @@
 #include <string.h>
 #include "cagd_loc.h"
 
+#define CAGD_MAX_ICHOOSEK_ROW	1020  /* Higher rows overflow a CagdRType. */
+
 IRIT_STATIC_DATA int
     BezierCacheEnabled = FALSE,
     GlblCacheFineNess = 0;
 IRIT_STATIC_DATA CagdRType *BezierCache[CAGD_MAX_BEZIER_CACHE_ORDER + 1]
 			               [CAGD_MAX_BEZIER_CACHE_ORDER + 1];
+IRIT_STATIC_DATA CagdRType
+    *GlblIChooseKRows[CAGD_MAX_ICHOOSEK_ROW - CAGD_MAX_BEZIER_CACHE_ORDER + 1];
 
 static CagdRType IntPow(CagdRType x, int i);
 
@@ -99,9 +103,29 @@ CagdRType BzrCrvEvalVecAtParam(const CagdRType *Vec,
 			       CagdRType t)
 {
     int i;
-    CagdRType
-        *BasisFuncs = BzrCrvEvalBasisFuncs(Order, t),
-	R = 0.0;
+    CagdRType *BasisFuncs, R, t1;
+
+    /* Low orders are evaluated directly, avoiding the basis vector. */
+    switch (Order) {
+	case 2:
+	    return (1.0 - t) * Vec[0] + t * Vec[VecInc];
+	case 3:
+	    t1 = 1.0 - t;
+	    return t1 * t1 * Vec[0] +
+		   2.0 * t * t1 * Vec[VecInc] +
+		   t * t * Vec[VecInc * 2];
+	case 4:
+	    t1 = 1.0 - t;
+	    return t1 * t1 * t1 * Vec[0] +
+		   3.0 * t * t1 * t1 * Vec[VecInc] +
+		   3.0 * t * t * t1 * Vec[VecInc * 2] +
+		   t * t * t * Vec[VecInc * 3];
+	default:
+	    break;
+    }
+
+    BasisFuncs = BzrCrvEvalBasisFuncs(Order, t);
+    R = 0.0;
 
     if (VecInc == 1)
 	for (i = 0; i < Order; i++)
@@ -150,11 +174,47 @@ CagdRType *BzrCrvEvalAtParam(const CagdCrvStruct *Crv, CagdRType t)
     int i, j,
 	k = Crv -> Order,
 	MaxCoord = CAGD_NUM_OF_PT_COORD(Crv -> PType);
-    CagdRType B,
-        *BasisFuncs = BzrCrvEvalBasisFuncs(k, t);
+    CagdRType B, B0, B1, B2, B3, *BasisFuncs,
+	t1 = 1.0 - t;
     CagdRType
 	* const *Points = Crv -> Points;
 
+    /* Linear, quadratic and cubic curves are handled with fixed Bernstein */
+    /* coefficients, unrolled over the control points.			    */
+    switch (k) {
+	case 2:
+	    for (j = IsNotRational; j <= MaxCoord; j++)
+		Pt[j] = t1 * Points[j][0] + t * Points[j][1];
+	    return Pt;
+	case 3:
+	    B0 = t1 * t1;
+	    B1 = 2.0 * t * t1;
+	    B2 = t * t;
+	    for (j = IsNotRational; j <= MaxCoord; j++) {
+		CagdRType const
+		    *P = Points[j];
+
+		Pt[j] = B0 * P[0] + B1 * P[1] + B2 * P[2];
+	    }
+	    return Pt;
+	case 4:
+	    B0 = t1 * t1 * t1;
+	    B1 = 3.0 * t * t1 * t1;
+	    B2 = 3.0 * t * t * t1;
+	    B3 = t * t * t;
+	    for (j = IsNotRational; j <= MaxCoord; j++) {
+		CagdRType const
+		    *P = Points[j];
+
+		Pt[j] = B0 * P[0] + B1 * P[1] + B2 * P[2] + B3 * P[3];
+	    }
+	    return Pt;
+	default:
+	    break;
+    }
+
+    BasisFuncs = BzrCrvEvalBasisFuncs(k, t);
+
     for (j = IsNotRational; j <= MaxCoord; j++)
 	Pt[j] = 0.0;
 
@@ -450,3 +510,56 @@ CagdRType CagdIChooseK(int i, int k)
 
     return c;
 }
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Returns the row of all the combinatorial coefficients of k:		     M
+*			 k         k!					     V
+*			( ) = -------------,  i = 0, ..., k.		     V
+*			 i    i! * (k - i)!				     V
+*   For k less than CAGD_MAX_BEZIER_CACHE_ORDER, the row of the precomputed  M
+* CagdIChooseKTable is returned.  Higher rows, up to k of 1020 beyond which  M
+* the coefficients overflow, are computed once, on demand, and are kept for  M
+* the next invocations.  At most about 4MB are so kept.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   k:      Row of the combinatorial coefficients to fetch.                  M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   const CagdRType *:   A vector of size k + 1 of (i choose k) values.      M
+*			 This vector should not be freed or modified.	     M
+*                        NULL if k is too large, after the fatal error       M
+*                        CAGD_ERR_WRONG_ORDER is raised, which callers       M
+*			 must check for.				     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   CagdIChooseK                                                             M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   CagdIChooseKRow, evaluation, combinatorics                               M
+*****************************************************************************/
+const CagdRType *CagdIChooseKRow(int k)
+{
+    int i;
+    CagdRType *Row;
+
+    if (k < CAGD_MAX_BEZIER_CACHE_ORDER)
+	return CagdIChooseKTable[k];
+
+    if (k > CAGD_MAX_ICHOOSEK_ROW) {
+        CAGD_FATAL_ERROR(CAGD_ERR_WRONG_ORDER);
+	return NULL;
+    }
+
+    if ((Row = GlblIChooseKRows[k - CAGD_MAX_BEZIER_CACHE_ORDER]) == NULL) {
+        Row = GlblIChooseKRows[k - CAGD_MAX_BEZIER_CACHE_ORDER] =
+	    (CagdRType *) IritMalloc(sizeof(CagdRType) * (k + 1));
+
+	/* Use (i choose k) = (i-1 choose k) (k - i + 1) / i and symmetry. */
+	Row[0] = Row[k] = 1.0;
+	for (i = 1; i <= (k >> 1); i++)
+	    Row[i] = Row[k - i] = Row[i - 1] * (k - i + 1) / i;
+    }
+
+    return Row;
+}
@@ -21,7 +21,8 @@
 IRIT_STATIC_DATA int
     GMPlUseCubicFit = FALSE;
 
-static IrtPtType *GMPlEstimateQuadratic(IPPolyVrtxIdxStruct *PVIdx,
+static IrtPtType *GMPlEstimateQuadratic(const IPPolyVrtxIdxStruct *PVIdx,
+					GMPolyVrtxAdjStruct *Adj,
 					IrtHmgnMatType Mat,
 					int VrtxIdx,
 					int NumOfRings);
@@ -44,7 +45,8 @@ static IrtPtType *GMPlEstimateQuadratic(IPPolyVrtxIdxStruct *PVIdx,
 *   void                                                                     M
 *                                                                            *
 * SEE ALSO:                                                                  M
-*   GMPlCrvtrSetFitDegree, SymbEvalSrfCurvPrep, SymbEvalSrfCurvature         M
+*   GMPlCrvtrSetFitDegree, SymbEvalSrfCurvPrep, SymbEvalSrfCurvature,        M
+*   GMPlCrvtrEvalVrtcs							     M
 *                                                                            *
 * KEYWORDS:                                                                  M
 *   GMPlCrvtrSetCurvatureAttr                                                M
@@ -55,17 +57,12 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 {
     int i;
     IPPolygonStruct *Pl;
-    IPObjectStruct
-        *PObj = IPGenPOLYObject(PolyList);
-    IPPolyVrtxIdxStruct
-	*PVIdx = IPCnvPolyToPolyVrtxIdxStruct(PObj, TRUE, 0);
-    IPVertexStruct
-	**Vertices = PVIdx -> Vertices;
-
-    if (EstimateNrmls)
-	GMBlendNormalsToVertices(PObj -> U.Pl, GMPL_MAX_NRML_BLEND_ANGLE);
+    IPObjectStruct *PObj;
+    IPPolyVrtxIdxStruct *PVIdx;
+    IPVertexStruct **Vertices;
+    GMPlCrvtrVrtxStruct *Crvtr;
 
-    /* Verify triangles only with normals. */
+    /* Verify triangles only. */
     for (Pl = PolyList; Pl != NULL; Pl = Pl -> Pnext) {
         int i = 0;
         IPVertexStruct
@@ -84,11 +81,124 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 	}
     }
 
+    PObj = IPGenPOLYObject(PolyList);
+    PVIdx = IPCnvPolyToPolyVrtxIdxStruct(PObj, FALSE, 0);
+    Vertices = PVIdx -> Vertices;
+
+    if (EstimateNrmls)
+	GMBlendNormalsToVertices(PObj -> U.Pl, GMPL_MAX_NRML_BLEND_ANGLE);
+
+    Crvtr = GMPlCrvtrEvalVrtcs(PVIdx, NULL, NumOfRings);
+
     for (i = 0; i < PVIdx -> NumVrtcs; i++) {
         char SDirection[IRIT_LINE_LEN_LONG];
+	IPVertexStruct
+	    *V = Vertices[i];
+
+	AttrSetRealAttrib(&V -> Attr, "KCurv", Crvtr[i].K);
+	AttrSetRealAttrib(&V -> Attr, "HCurv", Crvtr[i].H);
+	AttrSetRealAttrib(&V -> Attr, "K1Curv", Crvtr[i].K1);
+	AttrSetRealAttrib(&V -> Attr, "K2Curv", Crvtr[i].K2);
+
+	if (IRIT_PT_EQ_ZERO(Crvtr[i].D1))
+	    AttrSetStrAttrib(&V -> Attr, "D1", "0,0,0");
+	else {
+	    sprintf(SDirection, "%g, %g, %g",
+		    Crvtr[i].D1[0], Crvtr[i].D1[1], Crvtr[i].D1[2]);
+	    AttrSetStrAttrib(&V -> Attr, "D1", SDirection);
+	}
+	if (IRIT_PT_EQ_ZERO(Crvtr[i].D2))
+	    AttrSetStrAttrib(&V -> Attr, "D2", "0,0,0");
+	else {
+	    sprintf(SDirection, "%g, %g, %g",
+		    Crvtr[i].D2[0], Crvtr[i].D2[1], Crvtr[i].D2[2]);
+	    AttrSetStrAttrib(&V -> Attr, "D2", SDirection);
+	}
+    }
+
+    IritFree(Crvtr);
+
+    /* Propagate the curvature properties to all the vertices in PolyList. */
+    for (Pl = PolyList; Pl != NULL; Pl = Pl -> Pnext) {
+        IPVertexStruct
+	    *V = Pl -> PVertex;
+
+	do {
+	    int VIndex = AttrGetIntAttrib(V -> Attr, "_VIdx");
+
+	    VIndex = IRIT_ABS(VIndex) - 1;
+
+	    if (!IP_ATTR_IS_BAD_INT(VIndex)) {
+	        IPVertexStruct
+		    *VOrig = Vertices[VIndex];
+
+		if (V != VOrig) {
+		    IP_ATTR_FREE_ATTRS(V -> Attr);
+		    V -> Attr = IP_ATTR_COPY_ATTRS(VOrig -> Attr);
+		}
+	    }
+	    else {
+	        GEOM_FATAL_ERROR(GEOM_ERR_MISS_VRTX_IDX);
+	    }
+
+	    V = V -> Pnext;
+	}
+	while (V != NULL && V != Pl -> PVertex);
+    }
+
+    IPPolyVrtxIdxFree(PVIdx);
+
+    PObj -> U.Pl = NULL;
+    IPFreeObject(PObj);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Estimates the Gaussian, Mean and principal curvatures and the principal  M
+* directions at all the vertices of the given mesh, into a dense vector.     M
+*   Uses a least sqaures osculating quadratic function in the estimate, as   M
+* GMPlCrvtrSetCurvatureAttr does, with the rings around each vertex	     M
+* collected over a compact vertex adjacency.				     M
+*   The vertices of PVIdx must have normals.  Vertices with no normal, or    M
+* with a failed fit, get all zero values.				     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   PVIdx:       The mesh, as constructed by IPCnvPolyToPolyVrtxIdxStruct.   M
+*		 PPolys lists are not required.				     M
+*   Adj:         The vertex adjacency of PVIdx, or NULL to compute it here.  M
+*   NumOfRings:  Number of rings around a vertex in the paraboloid fitting.  M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   GMPlCrvtrVrtxStruct *:  A vector of PVIdx -> NumVrtcs curvature	     M
+*		 estimates, by vertex index.  Free with IritFree.	     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   GMPlCrvtrSetCurvatureAttr, GMPlCrvtrSetFitDegree, GMPolyVrtxAdjNew       M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   GMPlCrvtrEvalVrtcs                                                       M
+*****************************************************************************/
+GMPlCrvtrVrtxStruct *GMPlCrvtrEvalVrtcs(const IPPolyVrtxIdxStruct *PVIdx,
+					GMPolyVrtxAdjStruct *Adj,
+					int NumOfRings)
+{
+    int i,
+        FreeAdj = Adj == NULL;
+    IPVertexStruct
+	**Vertices = PVIdx -> Vertices;
+    GMPlCrvtrVrtxStruct
+        *Crvtr = (GMPlCrvtrVrtxStruct *)
+	    IritMalloc(sizeof(GMPlCrvtrVrtxStruct) * (PVIdx -> NumVrtcs + 1));
+
+    if (FreeAdj)
+        Adj = GMPolyVrtxAdjNew(PVIdx);
+
+    IRIT_ZAP_MEM(Crvtr, sizeof(GMPlCrvtrVrtxStruct) * (PVIdx -> NumVrtcs + 1));
+
+    for (i = 0; i < PVIdx -> NumVrtcs; i++) {
         int Rings;
-	IrtRType Theta, A, B, C, k1, k2, D, H, K;
-	IrtVecType Dir, E3Dir;
+	IrtRType Theta, A, B, C, D, H, K;
+	IrtVecType Dir;
 	IrtPtType
 	    *Quad = NULL;
         IrtHmgnMatType InvMat, Mat;
@@ -97,14 +207,6 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 
 	if (!IP_HAS_NORMAL_VRTX(V)) {
 	    IRIT_WARNING_MSG("A vertex with no normal detected and ignored.\n");
-
-	    AttrSetRealAttrib(&V -> Attr, "KCurv", 0.0);
-	    AttrSetRealAttrib(&V -> Attr, "HCurv", 0.0);
-	    AttrSetRealAttrib(&V -> Attr, "K1Curv", 0.0);
-	    AttrSetRealAttrib(&V -> Attr, "K2Curv", 0.0);
-	    AttrSetStrAttrib(&V -> Attr, "D1", "0,0,0");
-	    AttrSetStrAttrib(&V -> Attr, "D2", "0,0,0");
-
 	    continue;
 	}
 
@@ -114,19 +216,12 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 	for (Rings = NumOfRings;
 	     Rings <= NumOfRings + GMPL_MAX_EXPAND_RINGS;
 	     Rings++) {
-	    if ((Quad = GMPlEstimateQuadratic(PVIdx, Mat, i, Rings)) != NULL)
+	    if ((Quad = GMPlEstimateQuadratic(PVIdx, Adj, Mat,
+					      i, Rings)) != NULL)
 	        break;
 	}
 	if (Quad == NULL) {
 	    IRIT_WARNING_MSG("Failed to compute quadratic osculating fit; ignored.\n");
-
-	    AttrSetRealAttrib(&V -> Attr, "KCurv", 0.0);
-	    AttrSetRealAttrib(&V -> Attr, "HCurv", 0.0);
-	    AttrSetRealAttrib(&V -> Attr, "K1Curv", 0.0);
-	    AttrSetRealAttrib(&V -> Attr, "K2Curv", 0.0);
-	    AttrSetStrAttrib(&V -> Attr, "D1", "0,0,0");
-	    AttrSetStrAttrib(&V -> Attr, "D2", "0,0,0");
-
 	    continue;
 	}
 
@@ -138,16 +233,13 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 	K = 4 * A * C - IRIT_SQR(B);
 	H = A + C;
 
-	AttrSetRealAttrib(&V -> Attr, "KCurv", GMPL_BOUND_CRVTR(K));
-	AttrSetRealAttrib(&V -> Attr, "HCurv", GMPL_BOUND_CRVTR(H));
+	Crvtr[i].K = GMPL_BOUND_CRVTR(K);
+	Crvtr[i].H = GMPL_BOUND_CRVTR(H);
 
 	D = IRIT_SQR(H) - K;
 	D = D < 0 ? 0 : sqrt(D);
-	k1 = H + D;
-	k2 = H - D;
-
-	AttrSetRealAttrib(&V -> Attr, "K1Curv", GMPL_BOUND_CRVTR(k1));
-	AttrSetRealAttrib(&V -> Attr, "K2Curv", GMPL_BOUND_CRVTR(k2));
+	Crvtr[i].K1 = GMPL_BOUND_CRVTR(H + D);
+	Crvtr[i].K2 = GMPL_BOUND_CRVTR(H - D);
 
 	/* Compute the curvature directions of the osculating quadratic. */
 	/* See "Geometric Nodeling with Splines - An Introduction by     */
@@ -158,49 +250,17 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 	Dir[1] = sin(Theta);
 	Dir[2] = 0.0;
 	IRIT_VEC2D_NORMALIZE(Dir);
-	MatMultVecby4by4(E3Dir, Dir, InvMat);
-	sprintf(SDirection, "%g, %g, %g", E3Dir[0], E3Dir[1], E3Dir[2]);
-	AttrSetStrAttrib(&V -> Attr, "D1", SDirection);
+	MatMultVecby4by4(Crvtr[i].D1, Dir, InvMat);
 
 	IRIT_SWAP(IrtRType, Dir[0], Dir[1]);
 	Dir[0] = -Dir[0];
-	MatMultVecby4by4(E3Dir, Dir, InvMat);
-	sprintf(SDirection, "%g, %g, %g", E3Dir[0], E3Dir[1], E3Dir[2]);
-	AttrSetStrAttrib(&V -> Attr, "D2", SDirection);
+	MatMultVecby4by4(Crvtr[i].D2, Dir, InvMat);
     }
 
-    /* Propagate the curvature properties to all the vertices in PolyList. */
-    for (Pl = PolyList; Pl != NULL; Pl = Pl -> Pnext) {
-        IPVertexStruct
-	    *V = Pl -> PVertex;
-
-	do {
-	    int VIndex = AttrGetIntAttrib(V -> Attr, "_VIdx");
-
-	    VIndex = IRIT_ABS(VIndex) - 1;
-
-	    if (!IP_ATTR_IS_BAD_INT(VIndex)) {
-	        IPVertexStruct
-		    *VOrig = Vertices[VIndex];
-
-		if (V != VOrig) {
-		    IP_ATTR_FREE_ATTRS(V -> Attr);
-		    V -> Attr = IP_ATTR_COPY_ATTRS(VOrig -> Attr);
-		}
-	    }
-	    else {
-	        GEOM_FATAL_ERROR(GEOM_ERR_MISS_VRTX_IDX);
-	    }
-
-	    V = V -> Pnext;
-	}
-	while (V != NULL && V != Pl -> PVertex);
-    }
+    if (FreeAdj)
+        GMPolyVrtxAdjFree(Adj);
 
-    IPPolyVrtxIdxFree(PVIdx);
-
-    PObj -> U.Pl = NULL;
-    IPFreeObject(PObj);
+    return Crvtr;
 }
 
 /*****************************************************************************
@@ -209,6 +269,7 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 *                                                                            *
 * PARAMETERS:                                                                *
 *   PVIdx:       Data structure of mesh.				     *
+*   Adj:         Vertex adjacency of the mesh.				     *
 *   Mat:	 The matrix that take the vertex to the origin and its       *
 *		 normal to the Z axis.					     *
 *   VrtxIdx:     Index of vertex to process.				     *
@@ -217,13 +278,14 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 * RETURN VALUE:                                                              *
 *   IrtPtType *:    The fitted quadratic or NULL if failed.                  *
 *****************************************************************************/
-static IrtPtType *GMPlEstimateQuadratic(IPPolyVrtxIdxStruct *PVIdx,
+static IrtPtType *GMPlEstimateQuadratic(const IPPolyVrtxIdxStruct *PVIdx,
+					GMPolyVrtxAdjStruct *Adj,
 					IrtHmgnMatType Mat,
 					int VrtxIdx,
 					int NumOfRings)
 {
-    int j,
-	*Nbrs = IPCnvPolyVrtxNeighbors(PVIdx, VrtxIdx, NumOfRings);
+    int j, n,
+	Nbrs[GMPL_CRVTR_MAX_FIT];
     IrtPtType ParamDomainPts[GMPL_CRVTR_MAX_FIT], 
 	      EuclideanPts[GMPL_CRVTR_MAX_FIT];
     IPVertexStruct
@@ -231,11 +293,11 @@ static IrtPtType *GMPlEstimateQuadratic(IPPolyVrtxIdxStruct *PVIdx,
     IPVertexStruct
         *V = Vertices[VrtxIdx];
 
-    for (j = 0; Nbrs[j] >= 0; j++) {
+    n = GMPolyVrtxAdjRings(Adj, VrtxIdx, NumOfRings,
+			   Nbrs, GMPL_CRVTR_MAX_FIT - 2);
+    for (j = 0; j < n; j++) {
 	MatMultPtby4by4(ParamDomainPts[j], Vertices[Nbrs[j]] -> Coord, Mat);
 	EuclideanPts[j][0] = ParamDomainPts[j][2];
-	if (j >= GMPL_CRVTR_MAX_FIT - 2)
-	    break;
     }
 
     if (j <= 2) /* At least 3 constraints are required. */
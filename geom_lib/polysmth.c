@@ -102,6 +102,306 @@ IPObjectStruct *GMPolyMeshSmoothing(IPObjectStruct *PolyObj, int NumTimes)
     return PolyObj; 
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*    Taubin (lambda/mu) smoothing of a polygonal mesh.  In every iteration,  M
+* each vertex that is not on the boundary is moved Lambda of the way toward  M
+* the average of its (edge) neighbors and then, in a second pass, Mu of the  M
+* way.  Mu < -Lambda < 0 prevents the shrinkage of plain Laplacian	     M
+* smoothing, which is what Mu = 0 yields.				     M
+*    Unlike GMPolyMeshSmoothing, the 1-rings are not reconstructed and the   M
+* kernel of the 1-ring is not verified: all passes run over the compact     M
+* adjacency of GMPolyVrtxAdjNew and over dense coordinate arrays, with      M
+* every vertex of a pass depending on the previous pass only.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   PolyObj:   Polygonal object to smooth, in place.			     M
+*   NumTimes:  Number of lambda/mu iterations to perform.		     M
+*   Lambda:    Positive smoothing factor, typically 0.3 to 0.6.		     M
+*   Mu:        Negative inflating factor, typically -(Lambda + 0.01), or     M
+*	       zero for Laplacian smoothing.				     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IPObjectStruct *: The smoothed out polygons, in place. Same as PolyObj.  M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   GMPolyMeshSmoothing, GMPolyVrtxAdjNew				     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   GMPolyMeshTaubinSmoothing						     M
+*****************************************************************************/
+IPObjectStruct *GMPolyMeshTaubinSmoothing(IPObjectStruct *PolyObj,
+					  int NumTimes,
+					  IrtRType Lambda,
+					  IrtRType Mu)
+{
+    IPPolyVrtxIdxStruct
+	*PVIdx = IPCnvPolyToPolyVrtxIdxStruct(PolyObj, FALSE, 0); 
+    GMPolyVrtxAdjStruct
+        *Adj = GMPolyVrtxAdjNew(PVIdx);
+    int i, j, k, Pass; 
+    IrtRType Factor;
+    IrtPtType Avg,
+	*Pts = (IrtPtType *) IritMalloc(sizeof(IrtPtType) *
+					(PVIdx -> NumVrtcs + 1)),
+	*NewPts = (IrtPtType *) IritMalloc(sizeof(IrtPtType) *
+					   (PVIdx -> NumVrtcs + 1));
+    const IPPolygonStruct *Pl; 
+
+    for (i = 0; i < PVIdx -> NumVrtcs; i++)
+        IRIT_PT_COPY(Pts[i], PVIdx -> Vertices[i] -> Coord);
+
+    for (j = 0; j < NumTimes; j++) {
+        for (Pass = 0; Pass < 2; Pass++) {
+	    if ((Factor = Pass == 0 ? Lambda : Mu) == 0.0)
+	        continue;
+
+	    for (i = 0; i < PVIdx -> NumVrtcs; i++) {
+	        int Start = Adj -> VNbrsStart[i],
+		    End = Adj -> VNbrsStart[i + 1];
+
+	        if (Adj -> Boundary[i]) {
+		    IRIT_PT_COPY(NewPts[i], Pts[i]);
+		    continue;
+		}
+
+		IRIT_PT_RESET(Avg);
+		for (k = Start; k < End; k++)
+		    IRIT_PT_ADD(Avg, Avg, Pts[Adj -> VNbrs[k]]);
+		IRIT_PT_SCALE(Avg, 1.0 / (End - Start));
+
+		/* NewPt = Pt + Factor * (Avg - Pt). */
+		IRIT_PT_SUB(Avg, Avg, Pts[i]);
+		IRIT_PT_SCALE(Avg, Factor);
+		IRIT_PT_ADD(NewPts[i], Pts[i], Avg);
+	    }
+
+	    IRIT_SWAP(IrtPtType *, Pts, NewPts);
+	}
+    }
+
+    /* Copy back all smoothed data back into original poly mesh. */
+    for (Pl = PolyObj -> U.Pl, i = 0; Pl != NULL; Pl = Pl -> Pnext, i++) {
+        IPVertexStruct
+	    *V = Pl -> PVertex; 
+
+	j = 0; 
+	do {
+	    IRIT_PT_COPY(V -> Coord, Pts[PVIdx -> Polygons[i][j++]]); 
+	    V = V -> Pnext; 
+	}
+	while (V != Pl -> PVertex && V != NULL); 
+    }
+
+    IritFree(Pts); 
+    IritFree(NewPts); 
+    GMPolyVrtxAdjFree(Adj);
+    IPPolyVrtxIdxFree(PVIdx); 
+
+    return PolyObj; 
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*    Constructs the vertex adjacency of a vertex/polygon index mesh, in      M
+* compressed arrays: the polygons sharing each vertex and the neighbors of   M
+* each vertex, where two vertices are neighbors if they are consecutive in   M
+* some polygon.  A vertex is on the boundary if some neighbor is	     M
+* consecutive to it an odd number of times, or if it has no neighbors.       M
+*    Construction time is linear in the size of the mesh, and the PPolys     M
+* lists of PVIdx are not needed.					     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   PVIdx:    The mesh to compute its vertex adjacency.			     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   GMPolyVrtxAdjStruct *:  The vertex adjacency.  Free with		     M
+*			    GMPolyVrtxAdjFree.				     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   GMPolyVrtxAdjFree, GMPolyVrtxAdjRings, IPCnvPolyToPolyVrtxIdxStruct      M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   GMPolyVrtxAdjNew							     M
+*****************************************************************************/
+GMPolyVrtxAdjStruct *GMPolyVrtxAdjNew(const IPPolyVrtxIdxStruct *PVIdx)
+{
+    int i, j, k, n, v, w, Start, NumCrnrs,
+        NumVrtcs = PVIdx -> NumVrtcs,
+	*Fill, *Cnt, *Nbrs;
+    GMPolyVrtxAdjStruct
+	*Adj = (GMPolyVrtxAdjStruct *) IritMalloc(sizeof(GMPolyVrtxAdjStruct));
+
+    Adj -> NumVrtcs = NumVrtcs;
+    Adj -> NumPlys = PVIdx -> NumPlys;
+    Adj -> VPlysStart = (int *) IritMalloc(sizeof(int) * (NumVrtcs + 1));
+    Adj -> VNbrsStart = (int *) IritMalloc(sizeof(int) * (NumVrtcs + 1));
+    Adj -> Boundary = (IrtBType *) IritMalloc(sizeof(IrtBType) *
+					      (NumVrtcs + 1));
+    Adj -> _Marks = (int *) IritMalloc(sizeof(int) * (NumVrtcs + 1));
+    Adj -> _MarkNum = 0;
+    Fill = (int *) IritMalloc(sizeof(int) * (NumVrtcs + 1));
+    Cnt = Adj -> _Marks;
+
+    /* Count polygons per vertex and bucket the polygons by vertex. */
+    IRIT_ZAP_MEM(Adj -> VPlysStart, sizeof(int) * (NumVrtcs + 1));
+    for (i = 0; i < PVIdx -> NumPlys; i++)
+        for (j = 0; PVIdx -> Polygons[i][j] >= 0; j++)
+	    Adj -> VPlysStart[PVIdx -> Polygons[i][j] + 1]++;
+    for (v = 0; v < NumVrtcs; v++)
+        Adj -> VPlysStart[v + 1] += Adj -> VPlysStart[v];
+    IRIT_GEN_COPY(Fill, Adj -> VPlysStart, sizeof(int) * NumVrtcs);
+
+    NumCrnrs = Adj -> VPlysStart[NumVrtcs];
+    Adj -> VPlys = (int *) IritMalloc(sizeof(int) * (NumCrnrs + 1));
+    Nbrs = (int *) IritMalloc(sizeof(int) * (2 * NumCrnrs + 1));
+
+    /* Place the previous and next vertex of each polygon corner in the    */
+    /* two slots of the corner, so vertex v owns Nbrs[2 * VPlysStart[v]]   */
+    /* to Nbrs[2 * VPlysStart[v + 1] - 1], with repetitions.		   */
+    for (i = 0; i < PVIdx -> NumPlys; i++) {
+        const int
+	    *Pl = PVIdx -> Polygons[i];
+
+        for (n = 0; Pl[n] >= 0; n++);
+        for (j = 0; j < n; j++) {
+	    k = Fill[Pl[j]]++;
+	    Adj -> VPlys[k] = i;
+	    Nbrs[2 * k] = Pl[j == 0 ? n - 1 : j - 1];
+	    Nbrs[2 * k + 1] = Pl[j == n - 1 ? 0 : j + 1];
+	}
+    }
+
+    /* Remove repetitions in place, counting them for the boundary test.   */
+    /* Fill[w] == v marks w as already seen for vertex v.		   */
+    for (v = 0; v < NumVrtcs; v++)
+        Fill[v] = -1;
+    for (v = k = 0; v < NumVrtcs; v++) {
+        Adj -> VNbrsStart[v] = Start = k;
+
+	for (j = 2 * Adj -> VPlysStart[v];
+	     j < 2 * Adj -> VPlysStart[v + 1];
+	     j++) {
+	    if ((w = Nbrs[j]) == v)
+	        continue;		       /* Degenerated, repeated vertex. */
+
+	    if (Fill[w] != v) {
+	        Fill[w] = v;
+		Cnt[w] = 0;
+		Nbrs[k++] = w;
+	    }
+	    Cnt[w]++;
+	}
+
+	Adj -> Boundary[v] = k == Start;
+	for (j = Start; j < k; j++) {
+	    if (Cnt[Nbrs[j]] & 0x01) {
+	        Adj -> Boundary[v] = TRUE;
+		break;
+	    }
+	}
+    }
+    Adj -> VNbrsStart[NumVrtcs] = k;
+    Adj -> VNbrs = (int *) IritMalloc(sizeof(int) * (k + 1));
+    IRIT_GEN_COPY(Adj -> VNbrs, Nbrs, sizeof(int) * k);
+    IritFree(Nbrs);
+
+    IRIT_ZAP_MEM(Adj -> _Marks, sizeof(int) * (NumVrtcs + 1));
+    IritFree(Fill);
+
+    return Adj;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*    Frees the vertex adjacency constructed by GMPolyVrtxAdjNew.	     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Adj:    The vertex adjacency to free.				     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   GMPolyVrtxAdjNew							     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   GMPolyVrtxAdjFree							     M
+*****************************************************************************/
+void GMPolyVrtxAdjFree(GMPolyVrtxAdjStruct *Adj)
+{
+    IritFree(Adj -> VPlysStart);
+    IritFree(Adj -> VPlys);
+    IritFree(Adj -> VNbrsStart);
+    IritFree(Adj -> VNbrs);
+    IritFree(Adj -> Boundary);
+    IritFree(Adj -> _Marks);
+    IritFree(Adj);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*    Collects the vertices of topological distance 1 to NumOfRings from      M
+* vertex VIdx, in a breadth first order, excluding VIdx itself.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Adj:         The vertex adjacency of the mesh.			     M
+*   VIdx:        Index of the source vertex, zero based.		     M
+*   NumOfRings:  Maximal topological distance from VIdx.		     M
+*   Nbrs:        Where to place the indices of the collected vertices.	     M
+*   MaxNbrs:     Size of Nbrs.  Collection stops when Nbrs is full.	     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:     Number of vertices placed in Nbrs.				     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   GMPolyVrtxAdjNew, IPCnvPolyVrtxNeighbors				     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   GMPolyVrtxAdjRings							     M
+*****************************************************************************/
+int GMPolyVrtxAdjRings(GMPolyVrtxAdjStruct *Adj,
+		       int VIdx,
+		       int NumOfRings,
+		       int *Nbrs,
+		       int MaxNbrs)
+{
+    int i, k, r, v, w, RingStart, RingEnd,
+        n = 0,
+	*Marks = Adj -> _Marks;
+
+    /* Marks[w] == _MarkNum flags w as collected in this traversal. */
+    if (++Adj -> _MarkNum >= IRIT_MAX_INT) {
+        IRIT_ZAP_MEM(Marks, sizeof(int) * (Adj -> NumVrtcs + 1));
+	Adj -> _MarkNum = 1;
+    }
+    Marks[VIdx] = Adj -> _MarkNum;
+
+    for (r = RingStart = RingEnd = 0; r < NumOfRings; r++) {
+        /* Expand the last ring, or VIdx itself for the first ring. */
+        for (i = r == 0 ? -1 : RingStart; i < RingEnd; i++) {
+	    v = i < 0 ? VIdx : Nbrs[i];
+
+	    for (k = Adj -> VNbrsStart[v]; k < Adj -> VNbrsStart[v + 1]; k++) {
+	        if (Marks[w = Adj -> VNbrs[k]] != Adj -> _MarkNum) {
+		    if (n >= MaxNbrs)
+		        return n;
+
+		    Marks[w] = Adj -> _MarkNum;
+		    Nbrs[n++] = w;
+		}
+	    }
+	}
+
+	if (n == RingEnd)
+	    break;				  /* No more vertices to reach. */
+	RingStart = RingEnd;
+	RingEnd = n;
+    }
+
+    return n;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Finds the normal of polygon that can be none-convex.		     M
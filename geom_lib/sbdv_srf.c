@@ -85,6 +85,54 @@ static void GMSubCreateButterflyVertexPts(
 				       GMSubSrfsVrtcsStruct *GMSubBtrflyVrtcs);
 static IPObjectStruct* GMSubCreateRefineObject(GMSubParamStruct *GMSubParam);
 
+/* GMSubMeshStruct - a polygonal mesh held in flat arrays for the multi      */
+/* level refinement of GMSubSrfsRefine.  Face f owns the consecutive half    */
+/* edges FaceStart[f] to FaceStart[f + 1] - 1, and half edge h leads from    */
+/* vertex HVrtx[h] to the origin of the next half edge of the same face.    */
+/* The outgoing half edges of vertex v are VHEdges[VStart[v]] to	     */
+/* VHEdges[VStart[v + 1] - 1].  The HFace to VHEdges arrays are only valid  */
+/* after GMSubMeshTopology.						     */
+typedef struct GMSubMeshStruct {
+    IrtPtType *Pts;			  /* Vertices' coordinates.	     */
+    int *FaceStart;		      /* Faces to half edges, NumFaces + 1. */
+    int *HVrtx;				  /* Origin vertex of half edge.     */
+    int *HFace;				  /* Face of half edge.		     */
+    int *HTwin;			/* Opposite half edge, -1 if a boundary. */
+    int *HEdge;			      /* Index of (undirected) edge of h.   */
+    int *VStart;		/* Vertices to VHEdges, NumVrtcs + 1.	     */
+    int *VHEdges;		      /* Outgoing half edges by vertex.     */
+    int NumVrtcs;
+    int NumFaces;
+    int NumHEdges;
+    int NumEdges;
+} GMSubMeshStruct;
+
+#define GM_SUB_MESH_NEXT(M, h) ((h) + 1 < (M) -> FaceStart[(M) -> HFace[h] + 1] \
+				  ? (h) + 1 : (M) -> FaceStart[(M) -> HFace[h]])
+#define GM_SUB_MESH_PREV(M, h) ((h) > (M) -> FaceStart[(M) -> HFace[h]] \
+			      ? (h) - 1 : (M) -> FaceStart[(M) -> HFace[h] + 1] - 1)
+#define GM_SUB_MESH_DEST(M, h)	((M) -> HVrtx[GM_SUB_MESH_NEXT(M, h)])
+
+static void GMSubMeshFromPVIdx(const IPPolyVrtxIdxStruct *PVIdx,
+			       GMSubMeshStruct *M);
+static void GMSubMeshTopology(GMSubMeshStruct *M);
+static void GMSubMeshFree(GMSubMeshStruct *M);
+static void GMSubMeshRefine(const GMSubMeshStruct *M,
+			    GMSubSrfsSchemeType Scheme,
+			    IrtRType ButterflyWCoef,
+			    GMSubMeshStruct *R);
+static void GMSubMeshEdgePts(const GMSubMeshStruct *M,
+			     GMSubSrfsSchemeType Scheme,
+			     IrtRType ButterflyWCoef,
+			     IrtPtType *FacePts,
+			     IrtPtType *EdgePts);
+static void GMSubMeshVertexPts(const GMSubMeshStruct *M,
+			       GMSubSrfsSchemeType Scheme,
+			       IrtPtType *FacePts,
+			       IrtPtType *VertexPts);
+static IPObjectStruct *GMSubMeshToPolyObj(const GMSubMeshStruct *M,
+					  IPPolyVrtxIdxStruct **PVIdx);
+
 /******************************************************************************
 * DESCRIPTION:                                                                M
 *   Refines a polygonal object according to Catmull-Clark subdivision rules.  M
@@ -163,6 +211,80 @@ IPObjectStruct *GMSubButterfly(IPObjectStruct *OriginalObj,
 				  GMSubCreateRefineObject);
 }
 
+/******************************************************************************
+* DESCRIPTION:                                                                M
+*   Refines a polygonal object Levels times according to the given           M
+* subdivision scheme.  Unlike GMSubCatmullClark, GMSubLoop and		      M
+* GMSubButterfly, the mesh is converted only once into flat index arrays     M
+* with half edge adjacency, all the levels are computed over these arrays    M
+* and polygons are constructed for the final level only.		      M
+*   Catmull-Clark accepts triangles and quadrangles (larger polygons are     M
+* split into quadrangles first) while Loop and Butterfly are applied to a    M
+* triangulation of the input.						      M
+*                                                                             *
+* PARAMETERS:		                                                      M
+*   OriginalObj:    A pointer to the original polygonal object.	    	      M
+*   Scheme:	    The subdivision scheme to apply.			      M
+*   Levels:	    Number of refinement iterations to perform.		      M
+*   ButterflyWCoef: The scalar butterfly blending coeefficient.  Used by the M
+*		    Butterfly scheme only.				      M
+*   PVIdx:	    If not NULL, also returns here a vertex/polygon index     M
+*		    view of the refined mesh.  Its vertices are part of the   M
+*		    returned object.  Free with IPPolyVrtxIdxFree.	      M
+*                                                                             *
+* RETURN VALUE:                                                               M
+*   IPObjectStruct *: Pointer to refined polygonal object after subdivision.  M
+*                                                                             *
+* SEE ALSO:                                                                   M
+*   GMSubCatmullClark, GMSubLoop, GMSubButterfly			      M
+*                                                                             *
+* KEYWORDS:                                                                   M
+*   GMSubSrfsRefine							      M
+******************************************************************************/
+IPObjectStruct *GMSubSrfsRefine(IPObjectStruct *OriginalObj,
+				GMSubSrfsSchemeType Scheme,
+				int Levels,
+				IrtRType ButterflyWCoef,
+				IPPolyVrtxIdxStruct **PVIdx)
+{
+    int i;
+    IPPolyVrtxIdxStruct *OrigPVIdx;
+    IPObjectStruct *PObjNGons, *RefObj;
+    GMSubMeshStruct Mesh, RefMesh;
+
+    if (Scheme != GM_SUB_SRFS_CATMULL_CLARK) {
+	if (GMObjectHasUptoNGonsOnly(OriginalObj, 3))
+	    PObjNGons = OriginalObj;
+	else 
+	    PObjNGons = GMConvertPolysToTriangles(OriginalObj);
+    }
+    else {
+	if (GMObjectHasUptoNGonsOnly(OriginalObj, 4))
+	    PObjNGons = OriginalObj;
+        else 
+	    PObjNGons = GMConvertPolysToNGons(OriginalObj, 4);
+    }
+
+    /* Merge identical vertices once, and move to flat arrays. */
+    OrigPVIdx = IPCnvPolyToPolyVrtxIdxStruct(PObjNGons, FALSE, 0);
+    GMSubMeshFromPVIdx(OrigPVIdx, &Mesh);
+    IPPolyVrtxIdxFree(OrigPVIdx);
+    if (PObjNGons != OriginalObj)
+	IPFreeObject(PObjNGons);
+
+    for (i = 0; i < Levels; i++) {
+        GMSubMeshTopology(&Mesh);
+	GMSubMeshRefine(&Mesh, Scheme, ButterflyWCoef, &RefMesh);
+	GMSubMeshFree(&Mesh);
+	Mesh = RefMesh;
+    }
+
+    RefObj = GMSubMeshToPolyObj(&Mesh, PVIdx);
+    GMSubMeshFree(&Mesh);
+
+    return RefObj;
+}
+
 /******************************************************************************
 * DESCRIPTION:								      *
 *   Main entry function. Refines a polygonal object according to selected     *
@@ -1249,3 +1371,494 @@ static void GMSubCreateButterflyVertexPts(
     }
 }
 
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Copies a vertex/polygon index mesh into the flat arrays of M.  Only the  *
+* vertices and faces are set here - see GMSubMeshTopology.		     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   PVIdx:   Mesh to copy.						     *
+*   M:       Mesh arrays to allocate and fill.				     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void							             *
+*****************************************************************************/
+static void GMSubMeshFromPVIdx(const IPPolyVrtxIdxStruct *PVIdx,
+			       GMSubMeshStruct *M)
+{
+    int i, j, n, h, f;
+
+    IRIT_ZAP_MEM(M, sizeof(GMSubMeshStruct));
+
+    M -> NumVrtcs = PVIdx -> NumVrtcs;
+    M -> Pts = (IrtPtType *) IritMalloc(sizeof(IrtPtType) * 
+					(M -> NumVrtcs + 1));
+    for (i = 0; i < M -> NumVrtcs; i++)
+        IRIT_PT_COPY(M -> Pts[i], PVIdx -> Vertices[i] -> Coord);
+
+    /* Count faces and half edges, ignoring degenerated polygons. */
+    for (i = 0; i < PVIdx -> NumPlys; i++) {
+        for (n = 0; PVIdx -> Polygons[i][n] >= 0; n++);
+	if (n >= 3) {
+	    M -> NumFaces++;
+	    M -> NumHEdges += n;
+	}
+    }
+
+    M -> FaceStart = (int *) IritMalloc(sizeof(int) * (M -> NumFaces + 1));
+    M -> HVrtx = (int *) IritMalloc(sizeof(int) * (M -> NumHEdges + 1));
+    for (i = f = h = 0; i < PVIdx -> NumPlys; i++) {
+        for (n = 0; PVIdx -> Polygons[i][n] >= 0; n++);
+	if (n < 3)
+	    continue;
+
+	M -> FaceStart[f++] = h;
+	for (j = 0; j < n; j++)
+	    M -> HVrtx[h++] = PVIdx -> Polygons[i][j];
+    }
+    M -> FaceStart[f] = h;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the adjacency arrays of M out of its faces, in linear time:     *
+* the face of each half edge, the outgoing half edges of each vertex (by a   *
+* counting sort on the origin vertex), the twin of each half edge (the half  *
+* edge in the reversed direction, found among the outgoing half edges of    *
+* the destination vertex) and a running index for the undirected edges.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   M:       Mesh to update.						     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void							             *
+*****************************************************************************/
+static void GMSubMeshTopology(GMSubMeshStruct *M)
+{
+    int f, h, k, v, a, b, g,
+        NumHEdges = M -> NumHEdges,
+	*Pos = (int *) IritMalloc(sizeof(int) * (M -> NumVrtcs + 1));
+
+    M -> HFace = (int *) IritMalloc(sizeof(int) * (NumHEdges + 1));
+    M -> HTwin = (int *) IritMalloc(sizeof(int) * (NumHEdges + 1));
+    M -> HEdge = (int *) IritMalloc(sizeof(int) * (NumHEdges + 1));
+    M -> VHEdges = (int *) IritMalloc(sizeof(int) * (NumHEdges + 1));
+    M -> VStart = (int *) IritMalloc(sizeof(int) * (M -> NumVrtcs + 1));
+
+    for (f = 0; f < M -> NumFaces; f++)
+        for (h = M -> FaceStart[f]; h < M -> FaceStart[f + 1]; h++)
+	    M -> HFace[h] = f;
+
+    /* Bucket the half edges by their origin vertex. */
+    IRIT_ZAP_MEM(Pos, sizeof(int) * (M -> NumVrtcs + 1));
+    for (h = 0; h < NumHEdges; h++)
+        Pos[M -> HVrtx[h] + 1]++;
+    for (v = 0; v < M -> NumVrtcs; v++)
+        Pos[v + 1] += Pos[v];
+    IRIT_GEN_COPY(M -> VStart, Pos, sizeof(int) * (M -> NumVrtcs + 1));
+    for (h = 0; h < NumHEdges; h++)
+        M -> VHEdges[Pos[M -> HVrtx[h]]++] = h;
+    IritFree(Pos);
+
+    /* Pair opposite half edges.  An edge shared by more than two faces is */
+    /* paired once and its other half edges are considered boundaries.     */
+    for (h = 0; h < NumHEdges; h++)
+        M -> HTwin[h] = -1;
+    for (h = 0; h < NumHEdges; h++) {
+        if (M -> HTwin[h] >= 0)
+	    continue;
+
+	a = M -> HVrtx[h];
+	b = GM_SUB_MESH_DEST(M, h);
+	for (k = M -> VStart[b]; k < M -> VStart[b + 1]; k++) {
+	    g = M -> VHEdges[k];
+	    if (g != h &&
+		M -> HTwin[g] < 0 &&
+		GM_SUB_MESH_DEST(M, g) == a) {
+	        M -> HTwin[h] = g;
+		M -> HTwin[g] = h;
+		break;
+	    }
+	}
+    }
+
+    for (h = M -> NumEdges = 0; h < NumHEdges; h++) {
+        if (M -> HTwin[h] < 0 || h < M -> HTwin[h])
+	    M -> HEdge[h] = M -> NumEdges++;
+	else
+	    M -> HEdge[h] = M -> HEdge[M -> HTwin[h]];
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Deallocates all the arrays of M.					     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   M:       Mesh to free its arrays.					     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void							             *
+*****************************************************************************/
+static void GMSubMeshFree(GMSubMeshStruct *M)
+{
+    IritFree(M -> Pts);
+    IritFree(M -> FaceStart);
+    IritFree(M -> HVrtx);
+    if (M -> HFace != NULL) {
+        IritFree(M -> HFace);
+	IritFree(M -> HTwin);
+	IritFree(M -> HEdge);
+	IritFree(M -> VStart);
+	IritFree(M -> VHEdges);
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Performs one subdivision step of mesh M into R.  The new vertices are    *
+* ordered as all vertex points (by old vertex index), then all edge points   *
+* (by HEdge) and then, for Catmull-Clark, all face points (by face).         *
+*   Catmull-Clark creates a quadrangle per half edge h, connecting the edge *
+* point of h, the vertex point of its destination, the edge point of the    *
+* next half edge and the face point.  The triangle schemes create a corner  *
+* triangle per half edge in the same way and a central triangle per face.   *
+*   Only the faces and vertices of R are set.				     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   M:		    Mesh to refine, with valid topology.		     *
+*   Scheme:	    The subdivision scheme to apply.			     *
+*   ButterflyWCoef: The scalar butterfly blending coeefficient.		     *
+*   R:		    Refined mesh arrays to allocate and fill.		     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void							             *
+*****************************************************************************/
+static void GMSubMeshRefine(const GMSubMeshStruct *M,
+			    GMSubSrfsSchemeType Scheme,
+			    IrtRType ButterflyWCoef,
+			    GMSubMeshStruct *R)
+{
+    int f, h, hn, Start, End, i, k,
+        IsCC = Scheme == GM_SUB_SRFS_CATMULL_CLARK,
+	EOffset = M -> NumVrtcs,
+	FOffset = EOffset + M -> NumEdges;
+    IrtPtType *FacePts;
+
+    IRIT_ZAP_MEM(R, sizeof(GMSubMeshStruct));
+    R -> NumVrtcs = FOffset + (IsCC ? M -> NumFaces : 0);
+    R -> NumFaces = IsCC ? M -> NumHEdges : M -> NumHEdges + M -> NumFaces;
+    R -> NumHEdges = 4 * M -> NumHEdges;
+    R -> Pts = (IrtPtType *) IritMalloc(sizeof(IrtPtType) *
+					(R -> NumVrtcs + 1));
+    R -> FaceStart = (int *) IritMalloc(sizeof(int) * (R -> NumFaces + 1));
+    R -> HVrtx = (int *) IritMalloc(sizeof(int) * (R -> NumHEdges + 1));
+
+    /* Face points are the averages of the faces' vertices. */
+    FacePts = IsCC ? &R -> Pts[FOffset] : NULL;
+    for (f = 0; IsCC && f < M -> NumFaces; f++) {
+        Start = M -> FaceStart[f];
+	End = M -> FaceStart[f + 1];
+
+	IRIT_PT_RESET(FacePts[f]);
+	for (h = Start; h < End; h++)
+	    IRIT_PT_ADD(FacePts[f], FacePts[f], M -> Pts[M -> HVrtx[h]]);
+	IRIT_PT_SCALE(FacePts[f], 1.0 / (End - Start));
+    }
+
+    GMSubMeshEdgePts(M, Scheme, ButterflyWCoef, FacePts, &R -> Pts[EOffset]);
+    GMSubMeshVertexPts(M, Scheme, FacePts, R -> Pts);
+
+    /* And the refined faces. */
+    for (f = i = k = 0; f < M -> NumFaces; f++) {
+        Start = M -> FaceStart[f];
+	End = M -> FaceStart[f + 1];
+
+	for (h = Start; h < End; h++) {
+	    hn = h + 1 < End ? h + 1 : Start;
+
+	    R -> FaceStart[i++] = k;
+	    R -> HVrtx[k++] = EOffset + M -> HEdge[h];
+	    R -> HVrtx[k++] = M -> HVrtx[hn];
+	    R -> HVrtx[k++] = EOffset + M -> HEdge[hn];
+	    if (IsCC)
+	        R -> HVrtx[k++] = FOffset + f;
+	}
+
+	if (!IsCC) {
+	    R -> FaceStart[i++] = k;
+	    for (h = Start; h < End; h++)
+	        R -> HVrtx[k++] = EOffset + M -> HEdge[h];
+	}
+    }
+    R -> FaceStart[i] = k;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the edge point of every (undirected) edge of M.  Boundary edges *
+* always get their mid point.  Otherwise, for edge (a, b):		     *
+* Catmull-Clark: (a + b + F1 + F2) / 4, F1, F2 the two face points.	     *
+* Loop:		 3/8 (a + b) + 1/8 (c + d), c, d opposite the edge.	     *
+* Butterfly:	 (a + b) / 2 + (1/8 + 2w) (c + d) - (1/16 + w) (sum of the   *
+*		 four wing vertices), if both a and b are of valence five or *
+*		 more and the stencil is complete, and (a + b) / 2 otherwise.*
+*                                                                            *
+* PARAMETERS:                                                                *
+*   M:		    Mesh to refine, with valid topology.		     *
+*   Scheme:	    The subdivision scheme to apply.			     *
+*   ButterflyWCoef: The scalar butterfly blending coeefficient.		     *
+*   FacePts:	    Face points of M, Catmull-Clark only.		     *
+*   EdgePts:	    Where to place the edge points, by HEdge index.	     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void							             *
+*****************************************************************************/
+static void GMSubMeshEdgePts(const GMSubMeshStruct *M,
+			     GMSubSrfsSchemeType Scheme,
+			     IrtRType ButterflyWCoef,
+			     IrtPtType *FacePts,
+			     IrtPtType *EdgePts)
+{
+    int h, t, a, b, k, v, Wing[4],
+        *Valence = NULL;
+    IrtPtType Pt;
+    IrtRType *E;
+
+    if (Scheme == GM_SUB_SRFS_BUTTERFLY) {
+        /* Valence is the size of the 1-ring: the outgoing half edges plus */
+        /* the incoming boundary half edge, if any.			   */
+        Valence = (int *) IritMalloc(sizeof(int) * (M -> NumVrtcs + 1));
+	for (v = 0; v < M -> NumVrtcs; v++) {
+	    Valence[v] = M -> VStart[v + 1] - M -> VStart[v];
+	    for (k = M -> VStart[v]; k < M -> VStart[v + 1]; k++)
+	        if (M -> HTwin[GM_SUB_MESH_PREV(M, M -> VHEdges[k])] < 0)
+		    Valence[v]++;
+	}
+    }
+
+    for (h = 0; h < M -> NumHEdges; h++) {
+        t = M -> HTwin[h];
+        if (t >= 0 && t < h)
+	    continue;				       /* Edge done via its twin. */
+
+	a = M -> HVrtx[h];
+	b = GM_SUB_MESH_DEST(M, h);
+	E = EdgePts[M -> HEdge[h]];
+	IRIT_PT_ADD(E, M -> Pts[a], M -> Pts[b]);
+	IRIT_PT_SCALE(E, 0.5);
+	if (t < 0)
+	    continue;
+
+	switch (Scheme) {
+	    case GM_SUB_SRFS_CATMULL_CLARK:
+	        IRIT_PT_ADD(Pt, FacePts[M -> HFace[h]], FacePts[M -> HFace[t]]);
+		IRIT_PT_SCALE(Pt, 0.25);
+		IRIT_PT_SCALE(E, 0.5);
+		IRIT_PT_ADD(E, E, Pt);
+		break;
+	    case GM_SUB_SRFS_LOOP:
+		IRIT_PT_ADD(Pt, M -> Pts[M -> HVrtx[GM_SUB_MESH_PREV(M, h)]],
+			        M -> Pts[M -> HVrtx[GM_SUB_MESH_PREV(M, t)]]);
+		IRIT_PT_SCALE(E, 0.75);
+		IRIT_PT_SCALE(Pt, 0.125);
+		IRIT_PT_ADD(E, E, Pt);
+		break;
+	    case GM_SUB_SRFS_BUTTERFLY:
+		if (Valence[a] < 5 || Valence[b] < 5)
+		    break;
+
+		/* The wings are across the other edges of the two faces. */
+		Wing[0] = M -> HTwin[GM_SUB_MESH_PREV(M, h)];
+		Wing[1] = M -> HTwin[GM_SUB_MESH_NEXT(M, h)];
+		Wing[2] = M -> HTwin[GM_SUB_MESH_NEXT(M, t)];
+		Wing[3] = M -> HTwin[GM_SUB_MESH_PREV(M, t)];
+		if (Wing[0] < 0 || Wing[1] < 0 || Wing[2] < 0 || Wing[3] < 0)
+		    break;
+		for (k = 0; k < 4; k++)
+		    Wing[k] = M -> HVrtx[GM_SUB_MESH_PREV(M, Wing[k])];
+		if (Wing[0] == Wing[1] || Wing[2] == Wing[3])
+		    break;
+
+		IRIT_PT_ADD(Pt, M -> Pts[M -> HVrtx[GM_SUB_MESH_PREV(M, h)]],
+			        M -> Pts[M -> HVrtx[GM_SUB_MESH_PREV(M, t)]]);
+		IRIT_PT_SCALE(Pt, 0.125 + 2.0 * ButterflyWCoef);
+		IRIT_PT_ADD(E, E, Pt);
+		IRIT_PT_ADD(Pt, M -> Pts[Wing[0]], M -> Pts[Wing[1]]);
+		IRIT_PT_ADD(Pt, Pt, M -> Pts[Wing[2]]);
+		IRIT_PT_ADD(Pt, Pt, M -> Pts[Wing[3]]);
+		IRIT_PT_SCALE(Pt, -0.0625 - ButterflyWCoef);
+		IRIT_PT_ADD(E, E, Pt);
+		break;
+	}
+    }
+
+    if (Valence != NULL)
+        IritFree(Valence);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the vertex point of every vertex of M.  A vertex is interior if *
+* none of its incident half edges is a boundary.  Then, with n neighbors:    *
+* Catmull-Clark: (F + 2R + (n - 3) V) / n, F and R the averages of the	     *
+*		 adjacent face points and edge mid points.		     *
+* Loop:		 (1 - n s) V + s (sum of neighbors), s = (5/8 - (3/8 +	     *
+*		 cos(2 Pi / n) / 4)^2) / n.				     *
+* On the boundary, Catmull-Clark averages V with the mid points of its k     *
+* boundary edges and Loop uses (1 - k/8) V + 1/8 (sum of boundary	     *
+* neighbors).  Butterfly is interpolating and keeps V.  Interior vertices   *
+* with less than three neighbors are kept as well.			     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   M:		    Mesh to refine, with valid topology.		     *
+*   Scheme:	    The subdivision scheme to apply.			     *
+*   FacePts:	    Face points of M, Catmull-Clark only.		     *
+*   VertexPts:	    Where to place the vertex points, by vertex index.	     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void							             *
+*****************************************************************************/
+static void GMSubMeshVertexPts(const GMSubMeshStruct *M,
+			       GMSubSrfsSchemeType Scheme,
+			       IrtPtType *FacePts,
+			       IrtPtType *VertexPts)
+{
+    int v, k, h, p, n, NumBndry;
+    IrtRType s;
+    IrtPtType FSum, NSum, BSum, Pt;
+    const IrtRType *V;
+
+    if (Scheme == GM_SUB_SRFS_BUTTERFLY) {
+        IRIT_GEN_COPY(VertexPts, M -> Pts, sizeof(IrtPtType) * M -> NumVrtcs);
+	return;
+    }
+
+    for (v = 0; v < M -> NumVrtcs; v++) {
+        V = M -> Pts[v];
+        n = M -> VStart[v + 1] - M -> VStart[v];
+	NumBndry = 0;
+	IRIT_PT_RESET(FSum);
+	IRIT_PT_RESET(NSum);
+	IRIT_PT_RESET(BSum);
+
+	for (k = M -> VStart[v]; k < M -> VStart[v + 1]; k++) {
+	    h = M -> VHEdges[k];
+	    p = GM_SUB_MESH_PREV(M, h);
+
+	    IRIT_PT_ADD(NSum, NSum, M -> Pts[GM_SUB_MESH_DEST(M, h)]);
+	    if (FacePts != NULL)
+	        IRIT_PT_ADD(FSum, FSum, FacePts[M -> HFace[h]]);
+
+	    if (M -> HTwin[h] < 0) {
+	        IRIT_PT_ADD(BSum, BSum, M -> Pts[GM_SUB_MESH_DEST(M, h)]);
+		NumBndry++;
+	    }
+	    if (M -> HTwin[p] < 0) {
+	        IRIT_PT_ADD(BSum, BSum, M -> Pts[M -> HVrtx[p]]);
+		NumBndry++;
+	    }
+	}
+
+	if (NumBndry == 0 && n < 3) {
+	    IRIT_PT_COPY(VertexPts[v], V);
+	    continue;
+	}
+
+	switch (Scheme) {
+	    case GM_SUB_SRFS_CATMULL_CLARK:
+	        if (NumBndry == 0) {
+		    /* (F + 2R + (n - 3) V) / n = (F + N / n + (n - 2) V) / n */
+		    /* where N / n is the average of the neighbors.	       */
+		    IRIT_PT_ADD(Pt, FSum, NSum);
+		    IRIT_PT_SCALE(Pt, 1.0 / n);
+		    IRIT_PT_SCALE2(VertexPts[v], V, n - 2.0);
+		    IRIT_PT_ADD(VertexPts[v], VertexPts[v], Pt);
+		    IRIT_PT_SCALE(VertexPts[v], 1.0 / n);
+		}
+		else {
+		    /* (V + sum of k mid points) / (k + 1). */
+		    IRIT_PT_SCALE2(Pt, V, 1.0 + NumBndry * 0.5);
+		    IRIT_PT_SCALE(BSum, 0.5);
+		    IRIT_PT_ADD(VertexPts[v], Pt, BSum);
+		    IRIT_PT_SCALE(VertexPts[v], 1.0 / (NumBndry + 1.0));
+		}
+		break;
+	    case GM_SUB_SRFS_LOOP:
+	        if (NumBndry == 0) {
+		    s = 0.375 + 0.25 * cos(M_PI_MUL_2 / n);
+		    s = (0.625 - s * s) / n;
+		    IRIT_PT_SCALE2(VertexPts[v], V, 1.0 - n * s);
+		    IRIT_PT_SCALE(NSum, s);
+		    IRIT_PT_ADD(VertexPts[v], VertexPts[v], NSum);
+		}
+		else {
+		    IRIT_PT_SCALE2(VertexPts[v], V, 1.0 - NumBndry * 0.125);
+		    IRIT_PT_SCALE(BSum, 0.125);
+		    IRIT_PT_ADD(VertexPts[v], VertexPts[v], BSum);
+		}
+		break;
+	    default:
+		break;
+	}
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Constructs a polygonal object out of mesh M, polygons in the order of    *
+* M's faces.  Optionally also returns a vertex/polygon index view of it.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   M:       Mesh to convert.  Only the faces and vertices are used.	     *
+*   PVIdx:   If not NULL, the vertex/polygon index structure is set here.    *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   IPObjectStruct *:  The polygonal object.				     *
+*****************************************************************************/
+static IPObjectStruct *GMSubMeshToPolyObj(const GMSubMeshStruct *M,
+					  IPPolyVrtxIdxStruct **PVIdx)
+{
+    int f, h, *Idx;
+    IPVertexStruct *V,
+        **Vrtcs = NULL;
+    IPObjectStruct
+        *PObj = IPGenPOLYObject(NULL);
+
+    if (PVIdx != NULL) {
+        *PVIdx = IPPolyVrtxIdxNew(M -> NumVrtcs, M -> NumFaces);
+	(*PVIdx) -> PObj = PObj;
+	(*PVIdx) -> TriangularMesh = TRUE;
+	(*PVIdx) -> _AuxVIndices = Idx = (int *)
+	    IritMalloc(sizeof(int) * (M -> NumHEdges + M -> NumFaces + 1));
+	Vrtcs = (*PVIdx) -> Vertices;
+	IRIT_ZAP_MEM(Vrtcs, sizeof(IPVertexStruct *) * (M -> NumVrtcs + 1));
+
+	for (f = 0; f < M -> NumFaces; f++) {
+	    (*PVIdx) -> Polygons[f] = Idx;
+	    if (M -> FaceStart[f + 1] - M -> FaceStart[f] > 3)
+	        (*PVIdx) -> TriangularMesh = FALSE;
+	    for (h = M -> FaceStart[f]; h < M -> FaceStart[f + 1]; h++)
+	        *Idx++ = M -> HVrtx[h];
+	    *Idx++ = -1;
+	}
+	(*PVIdx) -> Polygons[M -> NumFaces] = NULL;
+    }
+
+    /* Build backwards so the polygon list follows the faces' order. */
+    for (f = M -> NumFaces - 1; f >= 0; f--) {
+        V = NULL;
+        for (h = M -> FaceStart[f + 1] - 1; h >= M -> FaceStart[f]; h--) {
+	    V = IPAllocVertex2(V);
+	    IRIT_PT_COPY(V -> Coord, M -> Pts[M -> HVrtx[h]]);
+	    if (Vrtcs != NULL)
+	        Vrtcs[M -> HVrtx[h]] = V;
+	}
+
+	PObj -> U.Pl = IPAllocPolygon(0, V, PObj -> U.Pl);
+	IPUpdatePolyPlane(PObj -> U.Pl);
+    }
+
+    return PObj;
+}
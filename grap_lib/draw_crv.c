@@ -98,41 +98,23 @@ void IGDrawCurve(IPObjectStruct *PObj)
 *****************************************************************************/
 void IGDrawCurveGenPolylines(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolylines;
 
-    if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								    == NULL) {
+    if ((PObjPolylines = IGGetCachedObjApprox(PObj,
+					      "_IsolinesHiRes",
+					      "_IsolinesLoRes",
+					      IGGenCurvePolylines,
+					      &FreeApprox)) == NULL)
+	return;
 
-	PObjPolylines = IGGenCurvePolylines(PObj, 1.0);
-
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesHiRes",
-				   PObjPolylines, FALSE);
-	else {
-	    if (PObjPolylines != NULL) {
-		IGDrawPolyFuncPtr(PObjPolylines);
-		
-		IPFreeObject(PObjPolylines);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_IsolinesLoRes", PObjPolylines);
-	}
-	else {
-	    PObjPolylines = IGGenCurvePolylines(PObj, IGGlblRelLowresFineNess);
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesLoRes",
-				   PObjPolylines, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolylines);
+	IPFreeObject(PObjPolylines);
+	return;
     }
 
-    PObjPolylines = IGGetObjIsoLines(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolylines != NULL)
-	IGDrawPolyFuncPtr(PObjPolylines);
+    IGDrawPolyFuncPtr(PObjPolylines);
 }
 
 /*****************************************************************************
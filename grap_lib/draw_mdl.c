@@ -17,6 +17,9 @@
 #include "geom_lib.h"
 #include "grap_loc.h"
 
+#define IG_MDL_TRIM_CRV_TOL_RATIO	0.05  /* Tol. of trim crvs vs. srfs. */
+#define IG_MDL_TRIM_CRV_MAX_TOL		0.01
+
 static IPObjectStruct *IGGenModelPolygons(IPObjectStruct *PObj,
 					    IrtRType FineNess);
 static void IGDrawModelSketch(IPObjectStruct *PObj);
@@ -136,41 +139,23 @@ void IGDrawModel(IPObjectStruct *PObj)
 *****************************************************************************/
 void IGDrawModelGenPolygons(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolygons;
 
-    if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								    == NULL) {
-	PObjPolygons = IGGenModelPolygons(PObj, 1.0);
-
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsHiRes",
-				   PObjPolygons, FALSE);
-	else {
-	    if (PObjPolygons != NULL) {
-		IGDrawPolyFuncPtr(PObjPolygons);
-		
-		IPFreeObject(PObjPolygons);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_PolygonsLoRes", PObjPolygons);
-	}
-	else {
-	    PObjPolygons = IGGenModelPolygons(PObj, IGGlblRelLowresFineNess);
+    if ((PObjPolygons = IGGetCachedObjApprox(PObj,
+					     "_PolygonsHiRes",
+					     "_PolygonsLoRes",
+					     IGGenModelPolygons,
+					     &FreeApprox)) == NULL)
+	return;
 
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsLoRes",
-				   PObjPolygons, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolygons);
+	IPFreeObject(PObjPolygons);
+	return;
     }
 
-    PObjPolygons = IGGetObjPolygons(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolygons != NULL)
-	IGDrawPolyFuncPtr(PObjPolygons);
+    IGDrawPolyFuncPtr(PObjPolygons);
 }
 
 /*****************************************************************************
@@ -189,8 +174,7 @@ static IPObjectStruct *IGGenModelPolygons(IPObjectStruct *PObj,
 					  IrtRType FineNess)
 {
     int OldVal;
-    TrimSrfStruct *TSrf,
-	*TrimSrfs = MdlCnvrtMdl2TrimmedSrfs(PObj -> U.Mdls);
+    TrimSrfStruct *TSrf, *TrimSrfs;
     IrtRType RelativeFineNess;
     IPPolygonStruct *PPolygons, *PPolygonTemp;
     IPObjectStruct *PObjPolygons;
@@ -207,6 +191,15 @@ static IPObjectStruct *IGGenModelPolygons(IPObjectStruct *PObj,
     RelativeFineNess *= IGGlblPolygonOptiApprox ? 1.0 / (FineNess + IRIT_EPS)
 					        : FineNess;;
 
+    /* Sample edges shared by two faces once, so the faces' polygons meet. */
+    if (IGGlblPolygonOptiApprox)
+        TrimSrfs = MdlCnvrtMdl2TrimmedSrfs(PObj -> U.Mdls);
+    else
+        TrimSrfs = MdlCnvrtMdl2TrimmedSrfs2(PObj -> U.Mdls,
+		    IRIT_MIN(IG_MDL_TRIM_CRV_TOL_RATIO /
+			       (RelativeFineNess * IGGlblPlgnFineness + IRIT_EPS),
+			     IG_MDL_TRIM_CRV_MAX_TOL));
+
     for (TSrf = TrimSrfs; TSrf != NULL; TSrf = TSrf -> Pnext) {
         int HasTexture = IGInitSrfTexture(PObj);
 	IrtRType t;
@@ -359,41 +352,23 @@ static IPObjectStruct *IGGenModelSketches(IPObjectStruct *PObj,
 *****************************************************************************/
 static void IGDrawModelPolylines(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolylines;
 
-    if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								    == NULL) {
-	if ((PObjPolylines = IGGenModelPolylines(PObj, 1.0)) == NULL)
-	    return;
-
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesHiRes",
-				   PObjPolylines, FALSE);
-	else {
-	    if (PObjPolylines != NULL) {
-		IGDrawPolyFuncPtr(PObjPolylines);
-		
-		IPFreeObject(PObjPolylines);
-	    }
-	    return;
-	}
+    if ((PObjPolylines = IGGetCachedObjApprox(PObj,
+					      "_IsolinesHiRes",
+					      "_IsolinesLoRes",
+					      IGGenModelPolylines,
+					      &FreeApprox)) == NULL)
+	return;
 
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_IsolinesLoRes", PObjPolylines);
-	}
-	else {
-	    PObjPolylines = IGGenModelPolylines(PObj, IGGlblRelLowresFineNess);
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesLoRes",
-				   PObjPolylines, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolylines);
+	IPFreeObject(PObjPolylines);
+	return;
     }
 
-    PObjPolylines = IGGetObjIsoLines(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolylines != NULL)
-	IGDrawPolyFuncPtr(PObjPolylines);
+    IGDrawPolyFuncPtr(PObjPolylines);
 }
 
 /*****************************************************************************
@@ -157,39 +157,22 @@ void IGDrawSurface(IPObjectStruct *PObj)
 *****************************************************************************/
 void IGDrawSurfaceGenPolygons(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolygons, *PObjPl;
 
-    if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								    == NULL) {
-	PObjPolygons = IGGenSurfacePolygons(PObj, 1.0);
+    if ((PObjPolygons = IGGetCachedObjApprox(PObj,
+					     "_PolygonsHiRes",
+					     "_PolygonsLoRes",
+					     IGGenSurfacePolygons,
+					     &FreeApprox)) == NULL)
+	return;
 
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsHiRes",
-				   PObjPolygons, FALSE);
-	else {
-	    if (PObjPolygons != NULL) {
-		IGDrawPolyFuncPtr(PObjPolygons);
-		
-		IPFreeObject(PObjPolygons);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_PolygonsLoRes", PObjPolygons);
-	}
-	else {
-	    PObjPolygons = IGGenSurfacePolygons(PObj, IGGlblRelLowresFineNess);
-
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsLoRes",
-				   PObjPolygons, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolygons);
+	IPFreeObject(PObjPolygons);
+	return;
     }
 
-    PObjPolygons = IGGetObjPolygons(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
     if (PObjPolygons != NULL) {
 	/* Propagate geom info if has it only on original surface. */
 	if (AttrGetObjectObjAttrib(PObjPolygons, "_Disconts") == NULL &&
@@ -396,42 +379,23 @@ static IPObjectStruct *IGGenSurfaceSketches(IPObjectStruct *PObj,
 *****************************************************************************/
 static void IGDrawSurfaceGenPolylines(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolylines;
 
-    if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								    == NULL) {
-	if ((PObjPolylines = IGGenSurfacePolylines(PObj, 1.0)) == NULL)
-	    return;
+    if ((PObjPolylines = IGGetCachedObjApprox(PObj,
+					      "_IsolinesHiRes",
+					      "_IsolinesLoRes",
+					      IGGenSurfacePolylines,
+					      &FreeApprox)) == NULL)
+	return;
 
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesHiRes",
-				   PObjPolylines, FALSE);
-	else {
-	    if (PObjPolylines != NULL) {
-		IGDrawPolyFuncPtr(PObjPolylines);
-		
-		IPFreeObject(PObjPolylines);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_IsolinesLoRes", PObjPolylines);
-	}
-	else {
-	    PObjPolylines = IGGenSurfacePolylines(PObj,
-						  IGGlblRelLowresFineNess);
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesLoRes",
-				   PObjPolylines, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolylines);
+	IPFreeObject(PObjPolylines);
+	return;
     }
 
-    PObjPolylines = IGGetObjIsoLines(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolylines != NULL)
-	IGDrawPolyFuncPtr(PObjPolylines);
+    IGDrawPolyFuncPtr(PObjPolylines);
 }
 
 /*****************************************************************************
@@ -120,42 +120,23 @@ void IGDrawTriangSrf(IPObjectStruct *PObj)
 *****************************************************************************/
 void IGDrawTriangGenSrfPolygons(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolygons;
 
-    if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								    == NULL) {
-	PObjPolygons = IGGenTriangSrfPolygons(PObj, 1.0);
-
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsHiRes",
-				   PObjPolygons, FALSE);
-	else {
-	    if (PObjPolygons != NULL) {
-		IGDrawPolyFuncPtr(PObjPolygons);
-		
-		IPFreeObject(PObjPolygons);
-	    }
-	    return;
-	}
+    if ((PObjPolygons = IGGetCachedObjApprox(PObj,
+					     "_PolygonsHiRes",
+					     "_PolygonsLoRes",
+					     IGGenTriangSrfPolygons,
+					     &FreeApprox)) == NULL)
+	return;
 
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_PolygonsLoRes", PObjPolygons);
-	}
-	else {
-	    PObjPolygons = IGGenTriangSrfPolygons(PObj,
-						  IGGlblRelLowresFineNess);
-
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsLoRes",
-				   PObjPolygons, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolygons);
+	IPFreeObject(PObjPolygons);
+	return;
     }
 
-    PObjPolygons = IGGetObjPolygons(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolygons != NULL)
-	IGDrawPolyFuncPtr(PObjPolygons);
+    IGDrawPolyFuncPtr(PObjPolygons);
 }
 
 /*****************************************************************************
@@ -242,42 +223,23 @@ static void IGDrawTriangSrfSketch(IPObjectStruct *PObj)
 *****************************************************************************/
 static void IGDrawTriangSrfPolylines(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolylines;
 
-    if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								    == NULL) {
-	if ((PObjPolylines = IGGenTriangSrfPolylines(PObj, 1.0)) == NULL)
-	    return;
-
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesHiRes",
-				   PObjPolylines, FALSE);
-	else {
-	    if (PObjPolylines != NULL) {
-		IGDrawPolyFuncPtr(PObjPolylines);
-		
-		IPFreeObject(PObjPolylines);
-	    }
-	    return;
-	}
+    if ((PObjPolylines = IGGetCachedObjApprox(PObj,
+					      "_IsolinesHiRes",
+					      "_IsolinesLoRes",
+					      IGGenTriangSrfPolylines,
+					      &FreeApprox)) == NULL)
+	return;
 
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_IsolinesLoRes", PObjPolylines);
-	}
-	else {
-	    PObjPolylines = IGGenTriangSrfPolylines(PObj,
-						    IGGlblRelLowresFineNess);
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesLoRes",
-				   PObjPolylines, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolylines);
+	IPFreeObject(PObjPolylines);
+	return;
     }
 
-    PObjPolylines = IGGetObjIsoLines(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolylines != NULL)
-	IGDrawPolyFuncPtr(PObjPolylines);
+    IGDrawPolyFuncPtr(PObjPolylines);
 }
 
 /*****************************************************************************
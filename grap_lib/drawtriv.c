@@ -134,42 +134,23 @@ void IGDrawTrivar(IPObjectStruct *PObj)
 *****************************************************************************/
 void IGDrawTrivarGenSrfPolygons(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolygons;
 
-    if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								    == NULL) {
-	PObjPolygons = IGGenTrivarSrfPolygons(PObj, 1.0);
+    if ((PObjPolygons = IGGetCachedObjApprox(PObj,
+					     "_PolygonsHiRes",
+					     "_PolygonsLoRes",
+					     IGGenTrivarSrfPolygons,
+					     &FreeApprox)) == NULL)
+	return;
 
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsHiRes",
-				   PObjPolygons, FALSE);
-	else {
-	    if (PObjPolygons != NULL) {
-		IGDrawPolyFuncPtr(PObjPolygons);
-		
-		IPFreeObject(PObjPolygons);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_PolygonsLoRes", PObjPolygons);
-	}
-	else {
-	    PObjPolygons = IGGenTrivarSrfPolygons(PObj,
-						  IGGlblRelLowresFineNess);
-
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsLoRes",
-				   PObjPolygons, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolygons);
+	IPFreeObject(PObjPolygons);
+	return;
     }
 
-    PObjPolygons = IGGetObjPolygons(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolygons != NULL)
-	IGDrawPolyFuncPtr(PObjPolygons);
+    IGDrawPolyFuncPtr(PObjPolygons);
 }
 
 /*****************************************************************************
@@ -335,42 +316,23 @@ static IPObjectStruct *IGGenTrivarSrfSketch(IPObjectStruct *PObj,
 *****************************************************************************/
 static void IGDrawTrivarSrfPolylines(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolylines;
 
-    if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								    == NULL) {
-	if ((PObjPolylines = IGGenTrivarSrfPolylines(PObj, 1.0)) == NULL)
-	    return;
+    if ((PObjPolylines = IGGetCachedObjApprox(PObj,
+					      "_IsolinesHiRes",
+					      "_IsolinesLoRes",
+					      IGGenTrivarSrfPolylines,
+					      &FreeApprox)) == NULL)
+	return;
 
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesHiRes",
-				   PObjPolylines, FALSE);
-	else {
-	    if (PObjPolylines != NULL) {
-		IGDrawPolyFuncPtr(PObjPolylines);
-		
-		IPFreeObject(PObjPolylines);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_IsolinesLoRes", PObjPolylines);
-	}
-	else {
-	    PObjPolylines = IGGenTrivarSrfPolylines(PObj,
-						    IGGlblRelLowresFineNess);
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesLoRes",
-				   PObjPolylines, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolylines);
+	IPFreeObject(PObjPolylines);
+	return;
     }
 
-    PObjPolylines = IGGetObjIsoLines(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolylines != NULL)
-	IGDrawPolyFuncPtr(PObjPolylines);
+    IGDrawPolyFuncPtr(PObjPolylines);
 }
 
 /*****************************************************************************
@@ -141,41 +141,23 @@ void IGDrawTrimSrf(IPObjectStruct *PObj)
 *****************************************************************************/
 void IGDrawTrimSrfGenPolygons(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolygons;
 
-    if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								    == NULL) {
-	PObjPolygons = IGGenTrimSrfPolygons(PObj, 1.0);
+    if ((PObjPolygons = IGGetCachedObjApprox(PObj,
+					     "_PolygonsHiRes",
+					     "_PolygonsLoRes",
+					     IGGenTrimSrfPolygons,
+					     &FreeApprox)) == NULL)
+	return;
 
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsHiRes",
-				   PObjPolygons, FALSE);
-	else {
-	    if (PObjPolygons != NULL) {
-		IGDrawPolyFuncPtr(PObjPolygons);
-		
-		IPFreeObject(PObjPolygons);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_PolygonsLoRes", PObjPolygons);
-	}
-	else {
-	    PObjPolygons = IGGenTrimSrfPolygons(PObj, IGGlblRelLowresFineNess);
-
-	    AttrSetObjectObjAttrib(PObj, "_PolygonsLoRes",
-				   PObjPolygons, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolygons);
+	IPFreeObject(PObjPolygons);
+	return;
     }
 
-    PObjPolygons = IGGetObjPolygons(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolygons != NULL)
-	IGDrawPolyFuncPtr(PObjPolygons);
+    IGDrawPolyFuncPtr(PObjPolygons);
 }
 
 /*****************************************************************************
@@ -356,42 +338,23 @@ static IPObjectStruct *IGGenTrimSrfSketches(IPObjectStruct *PObj,
 *****************************************************************************/
 static void IGDrawTrimSrfGenPolylines(IPObjectStruct *PObj)
 {
+    int FreeApprox;
     IPObjectStruct *PObjPolylines;
 
-    if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								    == NULL) {
-	if ((PObjPolylines = IGGenTrimSrfPolylines(PObj, 1.0)) == NULL)
-	    return;
+    if ((PObjPolylines = IGGetCachedObjApprox(PObj,
+					      "_IsolinesHiRes",
+					      "_IsolinesLoRes",
+					      IGGenTrimSrfPolylines,
+					      &FreeApprox)) == NULL)
+	return;
 
-	if (IGGlblCacheGeom)
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesHiRes",
-				   PObjPolylines, FALSE);
-	else {
-	    if (PObjPolylines != NULL) {
-		IGDrawPolyFuncPtr(PObjPolylines);
-		
-		IPFreeObject(PObjPolylines);
-	    }
-	    return;
-	}
-
-	if (IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0)) {
-	    AttrSetObjectPtrAttrib(PObj, "_IsolinesLoRes", PObjPolylines);
-	}
-	else {
-	    PObjPolylines = IGGenTrimSrfPolylines(PObj,
-						  IGGlblRelLowresFineNess);
-	    AttrSetObjectObjAttrib(PObj, "_IsolinesLoRes",
-				   PObjPolylines, FALSE);
-	}
+    if (FreeApprox) {
+	IGDrawPolyFuncPtr(PObjPolylines);
+	IPFreeObject(PObjPolylines);
+	return;
     }
 
-    PObjPolylines = IGGetObjIsoLines(PObj);
-
-    IGGlblLastLowResDraw = IGGlblManipulationActive;
-
-    if (PObjPolylines != NULL)
-	IGDrawPolyFuncPtr(PObjPolylines);
+    IGDrawPolyFuncPtr(PObjPolylines);
 }
 
 /*****************************************************************************
@@ -29,6 +29,7 @@ IRIT_GLOBAL_DATA int
     IGGlblAdapIsoDir = CAGD_CONST_U_DIR,
     IGGlblBackFaceCull = FALSE,
     IGGlblCacheGeom = TRUE,
+    IGGlblCacheGeomMemLimit = 0,		/* In MBytes, zero to disable. */
     IGGlblCountNumPolys = FALSE,
     IGGlblDepthCue = TRUE,
     IGGlblDrawInternal = FALSE,
@@ -162,6 +163,39 @@ IRIT_STATIC_DATA IrtVecType
     IGGlblIsophotesDir = { 0.0, 0.0, 1.0 },
     IGGlblContoursDir = { 0.0, 0.0, 1.0 };
 
+/* Cached approximations not drawn in that many frames may be purged. */
+#define IG_CACHE_GEOM_STALE_FRAMES	2
+
+typedef struct IGCacheGeomEntryStruct {
+    IPObjectStruct *PObjApprox;	       /* Referenced by the cache as well. */
+    long Size;
+    int Frame;					    /* Frame last drawn in. */
+} IGCacheGeomEntryStruct;
+
+IRIT_STATIC_DATA IGCacheGeomEntryStruct
+    *IGGlblCacheGeomEntries = NULL;
+IRIT_STATIC_DATA int
+    IGGlblCacheGeomNumEntries = 0,
+    IGGlblCacheGeomMaxEntries = 0,
+    IGGlblCacheGeomHand = 0,
+    IGGlblCacheGeomIdleSteps = 0,
+    IGGlblCacheGeomFrame = 0,
+    IGGlblCacheGeomSweptFrame = -1;
+IRIT_STATIC_DATA long
+    IGGlblCacheGeomTotalSize = 0;
+
+static IPObjectStruct *IGGetObjApproxAux(IPObjectStruct *PObj,
+					 const char *HiResName,
+					 const char *LoResName);
+static IPObjectStruct *IGCacheGeomGetApprox(IPObjectStruct *PObj,
+					    const char *Name);
+static long IGCacheGeomApproxSize(const IPObjectStruct *PObj);
+static void IGCacheGeomInsert(IPObjectStruct *PObjApprox);
+static void IGCacheGeomTouch(IPObjectStruct *PObjApprox);
+static void IGCacheGeomRemove(int Slot, int Purge);
+static int IGCacheGeomMakeRoom(void);
+static void IGCacheGeomFlush(void);
+
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -634,8 +668,7 @@ IrtRType IGFindMinimalDist(IPObjectStruct *PObj,
 		*MinPlIsPolyline = IP_IS_POLYLINE_OBJ(PObj);
 		break;
 	    case IP_OBJ_CURVE:
-		if ((PObjTmp = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								     != NULL) {
+		if ((PObjTmp = IGGetObjIsoLines(PObj)) != NULL) {
 		    Dist = UserMinDistLinePolylineList(LinePos, LineDir,
 						       PObjTmp -> U.Pl, FALSE,
 						       MinPl, MinPt, 
@@ -650,8 +683,7 @@ IrtRType IGFindMinimalDist(IPObjectStruct *PObj,
 	    case IP_OBJ_MODEL:
 		d1 = d2 = IRIT_INFNTY;
 		if (IGGlblDrawSurfacePoly &&
-		    (PObjTmp = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								     != NULL) {
+		    (PObjTmp = IGGetObjPolygons(PObj)) != NULL) {
 		    if (IGGlblDrawStyle == IG_STATE_DRAW_STYLE_SOLID)
 		        d1 = UserMinDistLinePolygonList(LinePos, LineDir,
 							PObjTmp -> U.Pl,
@@ -668,8 +700,7 @@ IrtRType IGFindMinimalDist(IPObjectStruct *PObj,
 		}
 
 		if (IGGlblDrawSurfaceWire &&
-		    (PObjTmp = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes"))
-								     != NULL) {
+		    (PObjTmp = IGGetObjIsoLines(PObj)) != NULL) {
 		    d2 = UserMinDistLinePolylineList(LinePos, LineDir,
 						     PObjTmp -> U.Pl, FALSE,
 						     MinPl, MinPt,
@@ -912,7 +943,7 @@ void IGDrawPolyContours(IPObjectStruct *PObj)
 	    IrtRType Dz, Z, ZMax;
 	    GMBBBboxStruct *BBox;
 	    IPObjectStruct
-	        *PObjPl = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes");
+	        *PObjPl = IGGetObjPolygons(PObj);
 	    IrtHmgnMatType Mat, InvMat;
 	
 	    if (PObjPl == NULL)
@@ -1039,7 +1070,7 @@ void IGDrawPolyIsophotes(IPObjectStruct *PObj)
 	    int NumZIsophotes;
 	    IrtRType DAlpha, Alpha;
 	    IPObjectStruct
-	        *PObjPl = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes");
+	        *PObjPl = IGGetObjPolygons(PObj);
 				
 	    if (PObjPl == NULL)
 	        PObjPl = PObj;
@@ -1123,7 +1154,9 @@ void IGDrawPolyDiscontinuities(IPObjectStruct *PObj)
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
-*   Get the proper isoparametric curve approximation of the object.          M
+*   Get the proper isoparametric curve approximation of the object.  If the  M
+* approximation in the level of details of the current drawing is not       M
+* cached, the other level of details is used, if cached.		     M
 *                                                                            *
 * PARAMETERS:                                                                M
 *   PObj:     To get the iso curves' approximation                           M
@@ -1131,28 +1164,22 @@ void IGDrawPolyDiscontinuities(IPObjectStruct *PObj)
 * RETURN VALUE:                                                              M
 *   IPObjectStruct *:   The iso curve's approximation.                       M
 *                                                                            *
+* SEE ALSO:                                                                  M
+*   IGGetObjPolygons, IGGetCachedObjApprox                                   M
+*                                                                            *
 * KEYWORDS:                                                                  M
 *   IGGetObjIsoLines                                                         M
 *****************************************************************************/
 IPObjectStruct *IGGetObjIsoLines(IPObjectStruct *PObj)
 {
-    IPObjectStruct *PObjPolylines;
-
-    if (IGGlblManipulationActive) {
-	if ((PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesLoRes"))
-								      == NULL)
-	    PObjPolylines = (IPObjectStruct *)
-		AttrGetObjectPtrAttrib(PObj, "_IsolinesLoRes");
-    }
-    else
-	PObjPolylines = AttrGetObjectObjAttrib(PObj, "_IsolinesHiRes");
-
-    return PObjPolylines;
+    return IGGetObjApproxAux(PObj, "_IsolinesHiRes", "_IsolinesLoRes");
 }
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
-*   Get the proper polygonal approximation of the object.                    M
+*   Get the proper polygonal approximation of the object.  If the            M
+* approximation in the level of details of the current drawing is not       M
+* cached, the other level of details is used, if cached.		     M
 *                                                                            *
 * PARAMETERS:                                                                M
 *   PObj:     To get the polygonal approximation                             M
@@ -1160,23 +1187,391 @@ IPObjectStruct *IGGetObjIsoLines(IPObjectStruct *PObj)
 * RETURN VALUE:                                                              M
 *   IPObjectStruct *:   The polygonal approximation.                         M
 *                                                                            *
+* SEE ALSO:                                                                  M
+*   IGGetObjIsoLines, IGGetCachedObjApprox                                   M
+*                                                                            *
 * KEYWORDS:                                                                  M
 *   IGGetObjPolygons                                                         M
 *****************************************************************************/
 IPObjectStruct *IGGetObjPolygons(IPObjectStruct *PObj)
 {
-    IPObjectStruct *PObjPolygons;
+    return IGGetObjApproxAux(PObj, "_PolygonsHiRes", "_PolygonsLoRes");
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Auxiliary function of IGGetObjPolygons and IGGetObjIsoLines.             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   PObj:       To get its approximation.                                    *
+*   HiResName:  Name of high resolution approximation attribute.             *
+*   LoResName:  Name of low resolution approximation attribute.              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   IPObjectStruct *:   The cached approximation, NULL if none.              *
+*****************************************************************************/
+static IPObjectStruct *IGGetObjApproxAux(IPObjectStruct *PObj,
+					 const char *HiResName,
+					 const char *LoResName)
+{
+    IPObjectStruct *PObjApprox;
 
     if (IGGlblManipulationActive) {
-	if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsLoRes"))
-								       == NULL)
-	    PObjPolygons = (IPObjectStruct *)
-		AttrGetObjectPtrAttrib(PObj, "_PolygonsLoRes");
+	if ((PObjApprox = IGCacheGeomGetApprox(PObj, LoResName)) == NULL)
+	    PObjApprox = IGCacheGeomGetApprox(PObj, HiResName);
+    }
+    else {
+	if ((PObjApprox = IGCacheGeomGetApprox(PObj, HiResName)) == NULL)
+	    PObjApprox = IGCacheGeomGetApprox(PObj, LoResName);
     }
-    else
-	PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes");
 
-    return PObjPolygons;
+    return PObjApprox;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Get the piecewise linear approximation of PObj, in the level of details  M
+* needed by the current drawing, creating it on the fly if not cached yet.   M
+*   Only the level of details that is drawn is created so, while the scene  M
+* is being manipulated, only the (cheap) low resolution approximation is     M
+* computed.  The high resolution approximation is computed the first time   M
+* the object is drawn at rest.						     M
+*   If IGGlblCacheGeom is TRUE, the approximations are cached as HiResName   M
+* and LoResName attributes of PObj.  If IGGlblCacheGeomMemLimit is positive, M
+* the cached approximations are also accounted for in a cache registry that M
+* keeps their total size.  Once the total size exceeds                       M
+* IGGlblCacheGeomMemLimit megabytes, approximations of objects that were not M
+* drawn in the last frames are purged and, if that is not enough, objects   M
+* are drawn using their (cached) low resolution approximation instead of    M
+* creating new high resolution ones.  Hence, a scene larger than the limit  M
+* is not re-approximated every frame.					     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   PObj:          A freeform object to approximate.                         M
+*   HiResName:     Name of high resolution approximation attribute, i.e.    M
+*		   "_PolygonsHiRes" or "_IsolinesHiRes".		     M
+*   LoResName:     Name of low resolution approximation attribute, i.e.     M
+*		   "_PolygonsLoRes" or "_IsolinesLoRes".		     M
+*   GenApproxFunc: Function to create the approximation with a prescribed   M
+*		   relative fineness.					     M
+*   Free:          Set to TRUE if the returned approximation is not cached   M
+*		   and should be freed by the caller after it is drawn.      M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IPObjectStruct *:   The approximation to draw or NULL if none.           M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IGGetObjPolygons, IGGetObjIsoLines                                       M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IGGetCachedObjApprox                                                     M
+*****************************************************************************/
+IPObjectStruct *IGGetCachedObjApprox(IPObjectStruct *PObj,
+				     const char *HiResName,
+				     const char *LoResName,
+				     IGGenApproxFuncType GenApproxFunc,
+				     int *Free)
+{
+    int LoResIsHiRes = IRIT_APX_EQ(IGGlblRelLowresFineNess, 1.0),
+	LimitCache = IGGlblCacheGeom && IGGlblCacheGeomMemLimit > 0,
+	GenLoRes = IGGlblManipulationActive;
+    IPObjectStruct *PObjApprox;
+
+    *Free = FALSE;
+    IGGlblLastLowResDraw = IGGlblManipulationActive;
+
+    if (!LimitCache && IGGlblCacheGeomNumEntries > 0)
+        IGCacheGeomFlush();
+
+    if (!IGGlblCacheGeom) {
+        *Free = TRUE;
+	return GenApproxFunc(PObj, IGGlblManipulationActive ?
+					     IGGlblRelLowresFineNess : 1.0);
+    }
+
+    if (IGGlblManipulationActive) {
+        if ((PObjApprox = IGCacheGeomGetApprox(PObj, LoResName)) != NULL) {
+	    IGCacheGeomTouch(PObjApprox);
+	    return PObjApprox;
+	}
+
+	if (LoResIsHiRes &&
+	    (PObjApprox = IGCacheGeomGetApprox(PObj, HiResName)) != NULL) {
+	    AttrSetObjectPtrAttrib(PObj, LoResName, PObjApprox);
+	    IGCacheGeomTouch(PObjApprox);
+	    return PObjApprox;
+	}
+    }
+    else {
+        if ((PObjApprox = IGCacheGeomGetApprox(PObj, HiResName)) != NULL) {
+	    IGCacheGeomTouch(PObjApprox);
+	    return PObjApprox;
+	}
+
+	/* Out of cache memory - draw in low resolution instead. */
+	if (LimitCache && !LoResIsHiRes && !IGCacheGeomMakeRoom()) {
+	    if ((PObjApprox = IGCacheGeomGetApprox(PObj, LoResName)) != NULL) {
+	        IGCacheGeomTouch(PObjApprox);
+		return PObjApprox;
+	    }
+	    GenLoRes = TRUE;
+	}
+    }
+
+    if ((PObjApprox = GenApproxFunc(PObj, GenLoRes ? IGGlblRelLowresFineNess
+						   : 1.0)) == NULL)
+        return NULL;
+
+    if (GenLoRes && !LoResIsHiRes)
+        AttrSetObjectObjAttrib(PObj, LoResName, PObjApprox, FALSE);
+    else {
+	AttrSetObjectObjAttrib(PObj, HiResName, PObjApprox, FALSE);
+	if (LoResIsHiRes)
+	    AttrSetObjectPtrAttrib(PObj, LoResName, PObjApprox);
+    }
+
+    /* A new approximation was cached - make sure we are within limits. */
+    if (LimitCache) {
+        IGCacheGeomInsert(PObjApprox);
+	IGCacheGeomMakeRoom();
+    }
+
+    return PObjApprox;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Fetches the approximation cached as attribute Name of PObj, ignoring     *
+* approximations that were purged from the cache.                            *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   PObj:      Object to fetch its cached approximation.                     *
+*   Name:      Name of approximation attribute.                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   IPObjectStruct *:   The cached approximation or NULL if none.            *
+*****************************************************************************/
+static IPObjectStruct *IGCacheGeomGetApprox(IPObjectStruct *PObj,
+					    const char *Name)
+{
+    IPObjectStruct *PObjApprox;
+
+    if ((PObjApprox = AttrGetObjectObjAttrib(PObj, Name)) == NULL)
+        PObjApprox = (IPObjectStruct *) AttrGetObjectPtrAttrib(PObj, Name);
+
+    /* Purged approximations are left behind as undefined objects. */
+    return PObjApprox == NULL || PObjApprox -> ObjType == IP_OBJ_UNDEF ?
+							    NULL : PObjApprox;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Estimates the memory size, in bytes, of the given approximation.        *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   PObj:      Approximation to estimate its size.                           *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   long:      Estimated size in bytes.                                      *
+*****************************************************************************/
+static long IGCacheGeomApproxSize(const IPObjectStruct *PObj)
+{
+    long Size = sizeof(IPObjectStruct);
+
+    if (IP_IS_POLY_OBJ(PObj)) {
+        const IPPolygonStruct *Pl;
+
+	for (Pl = PObj -> U.Pl; Pl != NULL; Pl = Pl -> Pnext)
+	    Size += sizeof(IPPolygonStruct) +
+		    sizeof(IPVertexStruct) * IPVrtxListLen(Pl -> PVertex);
+    }
+    else if (IP_IS_OLST_OBJ(PObj)) {
+	int i = 0;
+	const IPObjectStruct *PTmp;
+
+	while ((PTmp = IPListObjectGet((IPObjectStruct *) PObj, i++)) != NULL)
+	    Size += IGCacheGeomApproxSize(PTmp);
+    }
+
+    return Size;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Registers a newly cached approximation in the cache registry.  The       *
+* registry holds a reference of its own to the approximation so an          *
+* approximation that was freed by its owner object (Count dropped to one)   *
+* can be detected and released without accessing the owner object.         *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   PObjApprox:  Approximation that was just cached as an attribute.         *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IGCacheGeomInsert(IPObjectStruct *PObjApprox)
+{
+    IGCacheGeomEntryStruct *Entry;
+
+    if (IGGlblCacheGeomNumEntries >= IGGlblCacheGeomMaxEntries) {
+        int NewMax = IRIT_MAX(IGGlblCacheGeomMaxEntries * 2, 64);
+	IGCacheGeomEntryStruct
+	    *NewEntries = (IGCacheGeomEntryStruct *)
+	        IritMalloc(sizeof(IGCacheGeomEntryStruct) * NewMax);
+
+	if (IGGlblCacheGeomEntries != NULL) {
+	    IRIT_GEN_COPY(NewEntries, IGGlblCacheGeomEntries,
+			  sizeof(IGCacheGeomEntryStruct) *
+			      IGGlblCacheGeomNumEntries);
+	    IritFree(IGGlblCacheGeomEntries);
+	}
+	IGGlblCacheGeomEntries = NewEntries;
+	IGGlblCacheGeomMaxEntries = NewMax;
+    }
+
+    /* One reference by the owner's attribute and one by the registry. */
+    PObjApprox -> Count = 2;
+    AttrSetObjectIntAttrib(PObjApprox, "_CacheSlot",
+			   IGGlblCacheGeomNumEntries);
+
+    Entry = &IGGlblCacheGeomEntries[IGGlblCacheGeomNumEntries++];
+    Entry -> PObjApprox = PObjApprox;
+    Entry -> Size = IGCacheGeomApproxSize(PObjApprox);
+    Entry -> Frame = IGGlblCacheGeomFrame;
+
+    IGGlblCacheGeomTotalSize += Entry -> Size;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Marks a cached approximation as drawn in the current frame.  A frame is  *
+* considered to end once an approximation is drawn again.		     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   PObjApprox:  Cached approximation that is about to be drawn.            *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IGCacheGeomTouch(IPObjectStruct *PObjApprox)
+{
+    int Slot;
+    IGCacheGeomEntryStruct *Entry;
+
+    if (IGGlblCacheGeomNumEntries == 0 ||
+	IP_ATTR_IS_BAD_INT(Slot = AttrGetObjectIntAttrib(PObjApprox,
+							 "_CacheSlot")) ||
+	Slot < 0 ||
+	Slot >= IGGlblCacheGeomNumEntries ||
+	(Entry = &IGGlblCacheGeomEntries[Slot]) -> PObjApprox != PObjApprox)
+        return;
+
+    if (Entry -> Frame == IGGlblCacheGeomFrame) {
+        IGGlblCacheGeomFrame++;
+	IGGlblCacheGeomIdleSteps = 0;
+    }
+    Entry -> Frame = IGGlblCacheGeomFrame;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Removes the given slot from the cache registry, releasing the           *
+* registry's reference to the approximation.  If Purge, the geometry of     *
+* the approximation is freed as well, leaving an undefined object behind in *
+* the owner's attribute, to be freed with its owner.			     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Slot:      Index of entry in registry to remove.                         *
+*   Purge:     TRUE to also free the geometry of the approximation.          *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IGCacheGeomRemove(int Slot, int Purge)
+{
+    IPObjectStruct
+	*PObjApprox = IGGlblCacheGeomEntries[Slot].PObjApprox;
+
+    IGGlblCacheGeomTotalSize -= IGGlblCacheGeomEntries[Slot].Size;
+
+    if (Purge && PObjApprox -> Count > 1) {
+        IPFreeObjectSlots(PObjApprox);
+	PObjApprox -> ObjType = IP_OBJ_UNDEF;
+    }
+    IPFreeObject(PObjApprox);
+
+    /* Move the last entry into the freed slot. */
+    if (Slot != --IGGlblCacheGeomNumEntries) {
+        IGGlblCacheGeomEntries[Slot] =
+	    IGGlblCacheGeomEntries[IGGlblCacheGeomNumEntries];
+	AttrSetObjectIntAttrib(IGGlblCacheGeomEntries[Slot].PObjApprox,
+			       "_CacheSlot", Slot);
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Purges approximations from the cache until the total cache size is      *
+* within IGGlblCacheGeomMemLimit.  Only approximations freed by their owner *
+* or not drawn in the last IG_CACHE_GEOM_STALE_FRAMES frames are purged, so  *
+* a cyclic redraw of a scene larger than the limit does not purge and       *
+* recreate approximations every frame.  The registry is swept by a clock    *
+* hand and at most once per frame in vain, so the amortized cost per drawn  *
+* approximation is constant.						     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if total cache size is within limits, FALSE otherwise.      *
+*****************************************************************************/
+static int IGCacheGeomMakeRoom(void)
+{
+    long MaxSize = ((long) IGGlblCacheGeomMemLimit) << 20;
+    IGCacheGeomEntryStruct *Entry;
+
+    while (IGGlblCacheGeomTotalSize > MaxSize &&
+	   IGGlblCacheGeomNumEntries > 0 &&
+	   IGGlblCacheGeomSweptFrame != IGGlblCacheGeomFrame) {
+        if (IGGlblCacheGeomHand >= IGGlblCacheGeomNumEntries)
+	    IGGlblCacheGeomHand = 0;
+	Entry = &IGGlblCacheGeomEntries[IGGlblCacheGeomHand];
+
+	if (Entry -> PObjApprox -> Count <= 1 ||
+	    Entry -> Frame + IG_CACHE_GEOM_STALE_FRAMES <=
+						       IGGlblCacheGeomFrame) {
+	    /* The hand now points to the entry moved into this slot. */
+	    IGCacheGeomRemove(IGGlblCacheGeomHand, TRUE);
+	    IGGlblCacheGeomIdleSteps = 0;
+	}
+	else {
+	    IGGlblCacheGeomHand++;
+	    if (++IGGlblCacheGeomIdleSteps >= IGGlblCacheGeomNumEntries)
+	        IGGlblCacheGeomSweptFrame = IGGlblCacheGeomFrame;
+	}
+    }
+
+    return IGGlblCacheGeomTotalSize <= MaxSize;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Empties the cache registry once the cache limit is disabled, keeping     *
+* all cached approximations with their owners.				     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IGCacheGeomFlush(void)
+{
+    while (IGGlblCacheGeomNumEntries > 0)
+        IGCacheGeomRemove(IGGlblCacheGeomNumEntries - 1, FALSE);
+
+    IGGlblCacheGeomHand = IGGlblCacheGeomIdleSteps = 0;
+    IGGlblCacheGeomSweptFrame = -1;
 }
 
 /*****************************************************************************
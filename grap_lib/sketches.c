@@ -425,8 +425,7 @@ IPObjectStruct *IGSketchGenSrfSketches(CagdSrfStruct *Srf,
     TrimSrfStruct
 	*TrimSrf = IP_IS_TRIMSRF_OBJ(PObj) ? PObj -> U.TrimSrfs : NULL;
 
-    if ((PObjPolygons = AttrGetObjectObjAttrib(PObj, "_PolygonsHiRes"))
-								    != NULL)
+    if ((PObjPolygons = IGGetObjPolygons(PObj)) != NULL)
 	Area = GMPolyObjectArea(PObjPolygons);
 
     /* Convert to the current view. */
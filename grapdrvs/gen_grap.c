@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
 #include <math.h>
 #include "irit_sm.h"
 #include "misc_lib.h"
@@ -187,6 +188,7 @@ IRIT_STATIC_DATA IritConfigStruct SetUp[] =
   { "NumOfIsolines",  "-I", (VoidPtr) &IGGlblNumOfIsolines,	IC_INTEGER_TYPE },
   { "LineWidth",      "-l", (VoidPtr) &IGGlblLineWidth,		IC_INTEGER_TYPE },
   { "AdapIsoDir",     "",   (VoidPtr) &IGGlblAdapIsoDir,	IC_INTEGER_TYPE },
+  { "CacheGeomMem",   "",   (VoidPtr) &IGGlblCacheGeomMemLimit,	IC_INTEGER_TYPE },
   { "PolygonOpti",    "-F", (VoidPtr) &IGGlblPolygonOptiApprox,	IC_INTEGER_TYPE },
   { "PolylineOpti",   "-f", (VoidPtr) &IGGlblPolylineOptiApprox,IC_INTEGER_TYPE },
   { "ShadingModel",   "-A", (VoidPtr) &IGGlblShadingModel,	IC_INTEGER_TYPE },
@@ -227,6 +229,7 @@ IRIT_STATIC_DATA const char
     *GenCtrlStr = " s%- u%- n%- N%- i%- c%- C%- m%- a%- q%- g%-\"x1,x2,y1,y2\"!s G%-\"x1,x2,y1,y2\"!s I%-#IsoLines!d F%-PlgnOpti|PlgnFineNess!d!F R%- f%-PllnOpti|PllnFineNess!d!F E%-RelLowRes!F p%-Point|Size!F l%-Line|Width!d r%- A%-Shader!d B%- 2%- d%- D%- L%-Normal|Size!F 4%- k%-SketchSilTyp|SilPwr|ShdTyp|ShdPwr|InvShd|ImpTyp|Imp!d!F!d!F!d!d!F K%- b%-\"R,B,G|(background)\"!s S%-\"x,y,z,w{,a,d,s}\"!s 1%- e%-PickDist!F O%-PickObjType!d Z%-ZMin|ZMax!F!F M%- W%-WireSetup!d P%- o%- x%-ExecAnimCmd!s X%-Min,Max,Dt,R{,flags}!s w%-InitWidget!d T%- z%- DFiles!*s";
 
 static void IGHandleStateCommand(char *Str);
+static int IGHandlePatchCommand(IPObjectStruct *DisplayList, char *Str);
 static void HandleAnimate(char *Params);
 static int ReplyWithObject(IPObjectStruct *DisplayList, char *ObjName);
 static int IGDeleteOneObjectAux(IPObjectStruct *PObj, IPObjectStruct *PLst);
@@ -921,6 +924,10 @@ int IGHandleObjectsFromSocket(int ViewMode,
 				    IGSaveCurrentMat(ViewMode, &Str[6]);
 				Redraw = FALSE;
 			    }
+			    else if (strnicmp(Str, "PATCH", 5) == 0) {
+			        Redraw = IGHandlePatchCommand(*DisplayList,
+							      &Str[5]);
+			    }
 			    else if (stricmp(Str, "PICKCRSR") == 0) {
 			        IGHandlePickObject(IG_PICK_ENTITY_CURSOR);
 				Redraw = FALSE;
@@ -975,6 +982,121 @@ int IGHandleObjectsFromSocket(int ViewMode,
 	return Redraw;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Process a command that patches control points of a displayed curve or    *
+* surface, as sent by the server instead of the entire object.  Only the     *
+* cached approximations of the patched object are purged.                    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   DisplayList:  Global object display list, to search the object in.       *
+*   Str:   Command parameters as "ObjName Index Coords... Index Coords...",  *
+*	   with all (projective) coordinates of each patched control point.  *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   TRUE if patched, FALSE otherwise, in which case nothing is        *
+*	   patched and the server is requested to resend the object in full. *
+*****************************************************************************/
+static int IGHandlePatchCommand(IPObjectStruct *DisplayList, char *Str)
+{
+    char Name[IRIT_LINE_LEN], *p;
+    int i, j, n, Len, IsNotRational, MaxCoord,
+	NumPts = 0,
+	Patched = FALSE;
+    CagdPointType PType;
+    CagdRType **Points,
+	*Coords = NULL;
+    IPObjectStruct *PObj, *PTmp;
+
+    while (isspace(*Str))
+        Str++;
+    if ((n = (int) strcspn(Str, " \t\r\n")) == 0 || n >= IRIT_LINE_LEN)
+        return FALSE;
+    strncpy(Name, Str, n);
+    Name[n] = 0;
+    Str = &Str[n];
+
+    /* Patches are sent for top level objects only. */
+    for (PObj = DisplayList; PObj != NULL; PObj = PObj -> Pnext) {
+        if (stricmp(Name, IP_GET_OBJ_NAME(PObj)) == 0)
+	    break;
+    }
+
+    if (PObj != NULL && IP_IS_CRV_OBJ(PObj)) {
+        PType = PObj -> U.Crvs -> PType;
+	Points = PObj -> U.Crvs -> Points;
+	Len = PObj -> U.Crvs -> Length;
+    }
+    else if (PObj != NULL && IP_IS_SRF_OBJ(PObj)) {
+        PType = PObj -> U.Srfs -> PType;
+	Points = PObj -> U.Srfs -> Points;
+	Len = PObj -> U.Srfs -> ULength * PObj -> U.Srfs -> VLength;
+    }
+    else
+        PObj = NULL;
+
+    /* An object that failed a patch before is out of sync until resent. */
+    if (PObj != NULL &&
+	AttrGetObjectIntAttrib(PObj, "_PatchFailed") != TRUE) {
+	IsNotRational = !CAGD_IS_RATIONAL_PT(PType);
+	MaxCoord = CAGD_NUM_OF_PT_COORD(PType);
+	n = MaxCoord + 2;		  /* Index followed by coordinates. */
+
+	/* Parse all the patch first, applying nothing unless all valid. */
+	Coords = (CagdRType *) IritMalloc(sizeof(CagdRType) * n * Len);
+	Patched = TRUE;
+	while (Patched && ((i = (int) strtol(Str, &p, 10)), p != Str)) {
+	    if (i < 0 || i >= Len || NumPts >= Len) {
+	        Patched = FALSE;
+	        break;
+	    }
+
+	    Coords[NumPts * n] = i;
+	    for (j = IsNotRational, Str = p; j <= MaxCoord; j++, Str = p) {
+	        Coords[NumPts * n + j + 1] = strtod(Str, &p);
+		if (p == Str) {
+		    Patched = FALSE;
+		    break;
+		}
+	    }
+	    NumPts++;
+	}
+
+	/* Nothing but white spaces should be left. */
+	while (isspace(*Str))
+	    Str++;
+	Patched = Patched && *Str == 0 && NumPts > 0;
+    }
+
+    if (!Patched) {
+        if (PObj != NULL)
+	    AttrSetObjectIntAttrib(PObj, "_PatchFailed", TRUE);
+	if (Coords != NULL)
+	    IritFree(Coords);
+
+	/* Request the server to send this object in full instead. */
+	PTmp = IPGenStrObject("_PATCHFAIL_", Name, NULL);
+	IPSocWriteOneObject(IGGlblIOHandle, PTmp);
+	IPFreeObject(PTmp);
+
+	return FALSE;
+    }
+
+    for (i = 0; i < NumPts; i++) {
+        int Idx = (int) Coords[i * n];
+
+        for (j = IsNotRational; j <= MaxCoord; j++)
+	    Points[j][Idx] = Coords[i * n + j + 1];
+    }
+    IritFree(Coords);
+
+    IGActiveFreePolyIsoAttribute(PObj, TRUE, TRUE, TRUE, TRUE);
+    IP_RST_BBOX_OBJ(PObj);
+    IGUpdateObjectBBox(PObj);
+
+    return TRUE;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 *   Process a command that is a view state command.                          *
@@ -245,9 +245,9 @@ static int IGCreateDdmDisplayList(IPObjectStruct *PObj)
 		n = IPPolyListLen(ObjPtrList[0] -> U.Pl);
 	    else {
 		IPObjectStruct
-    		*PTmp = AttrGetObjectObjAttrib(ObjPtrList[0], "_PolygonsHiRes");
+    		*PTmp = IGGetObjPolygons(ObjPtrList[0]);
 		if (PTmp == NULL)
-		    PTmp = AttrGetObjectObjAttrib(ObjPtrList[0], "_IsolinesHiRes");
+		    PTmp = IGGetObjIsoLines(ObjPtrList[0]);
 		if (PTmp != NULL)
 		    n = IPPolyListLen(PTmp -> U.Pl);
 	    }
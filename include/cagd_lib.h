@@ -226,6 +226,14 @@ typedef enum {
 
 #define CAGD_MAX_BEZIER_CACHE_FINENESS	1024
 
+/* Refinement (alpha) matrices are cached by content, so geometry sharing    */
+/* knot sequences is refined without recomputing the matrix.  The cache is  */
+/* bounded both in matrices and in bytes.  See				     */
+/* BspKnotSetAlphaCoefCacheSize routine below.				     */
+#define CAGD_MAX_ALPHA_COEF_CACHE_SIZE	64
+#define CAGD_DEF_ALPHA_COEF_CACHE_SIZE	16
+#define CAGD_MAX_ALPHA_COEF_CACHE_BYTES	(16 * 1024 * 1024)
+
 #define CAGD_MAX_BEZIER_CACHE_ORDER2	15    /* See cbzr2tbl.c in cagd_lib. */
 
 /* If a curve or a surface is periodic, their control polygon/mesh should    */
@@ -483,6 +491,9 @@ typedef CagdRType (*CagdMatchNormFuncType)(const CagdVType T1,
 					   const CagdVType P1,
 					   const CagdVType P2);
 typedef CagdRType (*CagdSrfErrorFuncType)(const CagdSrfStruct *Srf);
+typedef CagdBType (*CagdRayTraceHitTestFuncType)(int SrfIndex,
+						 CagdUVType UV,
+						 VoidPtr HitTestData);
 typedef int (*CagdSrfAdapAuxDataFuncType)(const CagdSrfStruct *Srf,
 					  VoidPtr AuxSrfData,
 					  CagdRType t,
@@ -1208,6 +1219,7 @@ void CagdPointsBBox(CagdRType * const *Points,
 		    CagdRType *BBoxMin,
 		    CagdRType *BBoxMax);
 CagdRType CagdIChooseK(int i, int k);
+const CagdRType *CagdIChooseKRow(int k);
 void CagdTransform(CagdRType **Points,
 		   int Len,
 		   int MaxCoord,
@@ -2140,6 +2152,7 @@ BspKnotAlphaCoeffStruct *BspKnotEvalAlphaCoefMerge(int k,
 BspKnotAlphaCoeffStruct *BspKnotCopyAlphaCoef(const BspKnotAlphaCoeffStruct
 					                                  *A);
 void BspKnotFreeAlphaCoef(BspKnotAlphaCoeffStruct *A);
+int BspKnotSetAlphaCoefCacheSize(int CacheSize);
 void BspKnotAlphaLoopBlendNotPeriodic(const BspKnotAlphaCoeffStruct *A,
 				      int IMin,
 				      int IMax,
@@ -2652,6 +2665,17 @@ CagdBType CagdRayTraceBzrSrf(CagdPType StPt,
                              const CagdSrfStruct *BzrSrf,
                              CagdUVStruct **IntrPrm,
                              CagdPtStruct **IntrPt);
+VoidPtr CagdRayTracePrepSrfs(const CagdSrfStruct *Srfs);
+void CagdRayTraceFreePrepSrfs(VoidPtr RayTrcPrep);
+int CagdRayTraceSrfsPacket(VoidPtr RayTrcPrep,
+			   int NumRays,
+			   const CagdPType *StPts,
+			   const CagdVType *Dirs,
+			   int *SrfIndices,
+			   CagdUVType *InterUVs,
+			   CagdRType *InterTs,
+			   CagdRayTraceHitTestFuncType HitTest,
+			   VoidPtr HitTestData);
 
 /******************************************************************************
 * B-Spline SDM fitting algorithm interface functions                          *
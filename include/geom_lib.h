@@ -143,6 +143,27 @@ typedef struct GMLsIntersectStruct {
     long Id;				      /* Unique ID of intersection. */
 } GMLsIntersectStruct;
 
+/* Vertex adjacency of a vertex/polygon index mesh in compressed arrays. The */
+/* polygons of vertex i are VPlys[VPlysStart[i]] to VPlys[VPlysStart[i+1]-1] */
+/* and similarly its (edge) neighbors in VNbrs, by VNbrsStart.		     */
+typedef struct GMPolyVrtxAdjStruct {
+    int NumVrtcs;
+    int NumPlys;
+    int *VPlysStart;				  /* NumVrtcs + 1 entries. */
+    int *VPlys;
+    int *VNbrsStart;				  /* NumVrtcs + 1 entries. */
+    int *VNbrs;
+    IrtBType *Boundary;		 /* TRUE for vertices on the mesh boundary. */
+    int *_Marks;		    /* Auxiliary memory for ring traversals. */
+    int _MarkNum;
+} GMPolyVrtxAdjStruct;
+
+typedef struct GMPlCrvtrVrtxStruct {
+    IrtRType K, H;			   /* Gaussian and mean curvatures. */
+    IrtRType K1, K2;				   /* Principal curvatures. */
+    IrtVecType D1, D2;				   /* Principal directions. */
+} GMPlCrvtrVrtxStruct;
+
 typedef IrtRType (*GMPolyOffsetAmountFuncType)(IrtRType *Coord);
 
 typedef enum {            /* Predefined indices for the TransformIrtVecType */
@@ -164,6 +185,12 @@ typedef enum {
     GM_ZBUF_Z_NEVER
 } GMZTestsType;
 
+typedef enum {
+    GM_SUB_SRFS_CATMULL_CLARK,
+    GM_SUB_SRFS_LOOP,
+    GM_SUB_SRFS_BUTTERFLY
+} GMSubSrfsSchemeType;
+
 typedef	IrtRType GMQuatType[4];                            /* A Quaternion. */
 typedef IrtRType GMQuatTransVecType[7];       /* Transformation parameters. */
 
@@ -985,6 +1012,9 @@ void GMPlCrvtrSetCurvatureAttr(IPPolygonStruct *PolyList,
 			       int NumOfRings,
 			       int EstimateNrmls);
 int GMPlCrvtrSetFitDegree(int UseCubic);
+GMPlCrvtrVrtxStruct *GMPlCrvtrEvalVrtcs(const IPPolyVrtxIdxStruct *PVIdx,
+					GMPolyVrtxAdjStruct *Adj,
+					int NumOfRings);
 
 /* Importance analysis over polygonal meshes. */
 
@@ -1049,6 +1079,17 @@ int GMIdentifyTJunctions(IPObjectStruct *PolyObj,
 /* Functions to smooth poly data. */
 
 IPObjectStruct *GMPolyMeshSmoothing(IPObjectStruct *PolyObj, int NumTimes);
+IPObjectStruct *GMPolyMeshTaubinSmoothing(IPObjectStruct *PolyObj,
+					  int NumTimes,
+					  IrtRType Lambda,
+					  IrtRType Mu);
+GMPolyVrtxAdjStruct *GMPolyVrtxAdjNew(const IPPolyVrtxIdxStruct *PVIdx);
+void GMPolyVrtxAdjFree(GMPolyVrtxAdjStruct *Adj);
+int GMPolyVrtxAdjRings(GMPolyVrtxAdjStruct *Adj,
+		       int VIdx,
+		       int NumOfRings,
+		       int *Nbrs,
+		       int MaxNbrs);
 void GMFindUnConvexPolygonNormal(const IPVertexStruct *VL, IrtVecType Nrml);
 int GMFindPtInsidePolyKernel(const IPVertexStruct *VE, IrtPtType KrnlPt);
 int GMIsVertexBoundary(int Index, const IPPolyVrtxIdxStruct *PVIdx);
@@ -1074,6 +1115,11 @@ IPObjectStruct *GMSubCatmullClark(IPObjectStruct *OriginalObj);
 IPObjectStruct *GMSubLoop(IPObjectStruct *OriginalObj);
 IPObjectStruct *GMSubButterfly(IPObjectStruct *OriginalObj, 
 			       IrtRType ButterflyWCoef);
+IPObjectStruct *GMSubSrfsRefine(IPObjectStruct *OriginalObj,
+				GMSubSrfsSchemeType Scheme,
+				int Levels,
+				IrtRType ButterflyWCoef,
+				IPPolyVrtxIdxStruct **PVIdx);
 
 /* Error handling. */
 
@@ -90,6 +90,8 @@
 
 typedef int (*IGDrawUpdateFuncType)(void);
 typedef void (*IGDrawObjectFuncType)(IPObjectStruct *PObj);
+typedef IPObjectStruct *(*IGGenApproxFuncType)(IPObjectStruct *PObj,
+					       IrtRType FineNess);
 
 typedef enum {   /* Note that some device drivers depends on this order. */
     IG_STATE_NONE,
@@ -283,6 +285,7 @@ IRIT_GLOBAL_DATA_HEADER int
     IGGlblAdapIsoDir,
     IGGlblBackFaceCull,
     IGGlblCacheGeom,
+    IGGlblCacheGeomMemLimit,
     IGGlblCountNumPolys,
     IGGlblDepthCue,
     IGGlblDrawInternal,
@@ -394,6 +397,11 @@ int IGDrawPolyIsophotesSetup(IrtRType x, IrtRType y, IrtRType z, int n);
 void IGDrawPolyIsophotes(IPObjectStruct *PObj);
 IPObjectStruct *IGGetObjIsoLines(IPObjectStruct *PObj);
 IPObjectStruct *IGGetObjPolygons(IPObjectStruct *PObj);
+IPObjectStruct *IGGetCachedObjApprox(IPObjectStruct *PObj,
+				     const char *HiResName,
+				     const char *LoResName,
+				     IGGenApproxFuncType GenApproxFunc,
+				     int *Free);
 int IGInitSrfTexture(IPObjectStruct *PObj);
 int IGDefaultProcessEvent(IGGraphicEventType Event, IrtRType *ChangeFactor);
 int IGDefaultStateHandler(int State, int StateStatus, int Refresh);
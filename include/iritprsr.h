@@ -424,6 +424,9 @@ typedef void (*IPNCGCodeRectangleToolSweepFuncType)(IrtPtType Pt1,
 						    IrtPtType Pt4);
 typedef IrtRType (*IPNCGCodeEvalMRRFuncType)(VoidPtr Data);
 typedef void (*IPNCGCodeParserErrorFuncType)(char *Line);
+typedef void (*IPNCGCodeParserLineFuncType)(IPNCGCodeLineStruct *GC,
+					    IPNCGCodeLineStruct *PrevGC,
+					    VoidPtr Data);
 typedef IPObjectStruct *(*IPForEachObjCallBack)(IPObjectStruct *PObj, 
                                                 void *Param);
 typedef IPPolygonStruct *(*IPForEachPolyCallBack)(IPPolygonStruct *Pl, 
@@ -526,6 +529,9 @@ VoidPtr IPNCGCodeParserInit(int ArcCentersRelative,
 			    int DefToolNumber,
 			    int ReverseZDir,
 			    IPNCGCodeParserErrorFuncType ErrorFunc);
+void IPNCGCodeParserSetStreaming(VoidPtr IPNCGCodes,
+				 IPNCGCodeParserLineFuncType LineFunc,
+				 VoidPtr LineFuncData);
 VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
 				 const char *NextLine,
 				 int LineNum);
@@ -538,6 +544,9 @@ IPNCGCodeLineStruct *IPNCGCodeParserGetPrev(VoidPtr IPNCGCodes);
 void IPNCGCodeParserFree(VoidPtr IPNCGCodes);
 IPObjectStruct *IPNCGCode2Geometry(VoidPtr IPNCGCodes);
 IrtRType IPNCGCodeLength(VoidPtr IPNCGCodes, IrtRType *FastLength);
+IrtRType IPNCGCodeLoadFileLength(const char *NCGCODEFileName,
+				 int ArcCentersRelative,
+				 IrtRType *FastLength);
 struct GMBBBboxStruct *IPNCGCodeBBox(VoidPtr IPNCGCodes, int IgnoreG0Fast);
 IrtRType IPNCGCodeTraverseInit(VoidPtr IPNCGCodes,
 			       IrtRType InitTime,
@@ -639,6 +648,15 @@ int IPGetMatrixFile(const char *File,
 /* Binary stream functions. */
 IPObjectStruct *IPGetBinObject(int Handler);
 void IPPutBinObject(int Handler, const IPObjectStruct *PObj);
+int IPPutIndexedDataFile(const char *FileName, const IPObjectStruct *PObjList);
+VoidPtr IPOpenIndexedDataFile(const char *FileName, int Messages);
+int IPIndexedDataFileNumObjs(VoidPtr IdxFile);
+const char *IPIndexedDataFileObjInfo(VoidPtr IdxFile,
+				     int Index,
+				     IPObjStructType *ObjType,
+				     IrtBboxType BBox);
+IPObjectStruct *IPGetIndexedObjectByName(VoidPtr IdxFile, const char *Name);
+void IPCloseIndexedDataFile(VoidPtr IdxFile);
 
 /* Will be set to VIEW_MAT and PERS_MAT respectively if found in parsed data.*/
 IRIT_GLOBAL_DATA_HEADER IrtHmgnMatType IPViewMat, IPPrspMat;
@@ -1138,6 +1156,12 @@ int IpcCompressObjToFile(const char *FileName,
 int IpcCompressObj(int Handler, IPObjectStruct *PObj);
 IPObjectStruct *IpcDecompressObjFromFile(const char *FileName);
 IPObjectStruct *IpcDecompressObj(int Handler);
+int IpcCompressObjChunksToFile(const char *FileName,
+			       IPObjectStruct *PObjs,
+			       float QntError);
+IPObjectStruct *IpcDecompressObjChunksFromFile(const char *FileName);
+IPObjectStruct *IpcDecompressObjChunkByName(const char *FileName,
+					    const char *Name);
 
 #endif /* IPC_BIN_COMPRESSION */
 
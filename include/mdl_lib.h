@@ -277,6 +277,8 @@ void MdlEnsureTSrfTrimCrvsPrecision(MdlTrimSrfStruct *MdlTrimSrf);
 ******************************************************************************/
 
 TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfs(const MdlModelStruct *Model);
+TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfs2(const MdlModelStruct *Model,
+					CagdRType UVTol);
 MdlModelStruct *MdlCnvrtSrf2Mdl(const CagdSrfStruct *Srf);
 MdlModelStruct *MdlCnvrtTrimmedSrf2Mdl(const TrimSrfStruct *TSrf);
 CagdCrvStruct *MdlExtractUVCrv(const MdlTrimSrfStruct *Srf,
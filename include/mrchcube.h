@@ -111,6 +111,14 @@ IPObjectStruct *MCExtractIsoSurface3(IPObjectStruct *ImageList,
 				     IrtPtType CubeDim,
 				     int SkipFactor,
 				     CagdRType IsoVal);
+IPPolyVrtxIdxStruct *MCExtractIsoSurfaceIdx(const char *FileName,
+					    int DataType,
+					    IrtPtType CubeDim,
+					    int Width,
+					    int Height,
+					    int Depth,
+					    int SkipFactor,
+					    CagdRType IsoVal);
 TrivTVStruct *TrivLoadVolumeIntoTV(const char *FileName,
 				   int DataType,
 				   IrtVecType VolSize,
@@ -290,6 +290,14 @@ IrtRType INCRndrPutMask(INCZBufferPtrType Rend,
 			IrtRType *Mask,
 			int MaskXSize,
 			int MaskYSize);
+IrtRType INCRndrPutMaskAlongLine(INCZBufferPtrType Rend,
+				 int *PosXY1,
+				 IrtRType PosZ1,
+				 int *PosXY2,
+				 IrtRType PosZ2,
+				 IrtRType *Mask,
+				 int MaskXSize,
+				 int MaskYSize);
 void INCRndrEndObject(INCZBufferPtrType Rend);
 void INCRndrPutPixel(INCZBufferPtrType Rend, int x, int y, IrtRType z);
 void INCRndrGetPixelDepth(INCZBufferPtrType Rend,
@@ -278,6 +278,16 @@ CagdBType TrimIsPointInsideTrimCrvs(const TrimCrvStruct *TrimCrvs,
 int TrimIsPointInsideTrimUVCrv(const CagdCrvStruct *UVCrv,
 			       CagdUVType UV);
 
+VoidPtr TrimRayTracePrepSrfs(const TrimSrfStruct *TrimSrfs);
+void TrimRayTraceFreePrepSrfs(VoidPtr RayTrcPrep);
+int TrimRayTraceSrfsPacket(VoidPtr RayTrcPrep,
+			   int NumRays,
+			   const CagdPType *StPts,
+			   const CagdVType *Dirs,
+			   int *SrfIndices,
+			   CagdUVType *InterUVs,
+			   CagdRType *InterTs);
+
 TrimSetErrorFuncType TrimSetFatalErrorFunc(TrimSetErrorFuncType ErrorFunc);
 const char *TrimDescribeError(TrimFatalErrorType ErrorNum);
 void TrimFatalError(TrimFatalErrorType ErrID);
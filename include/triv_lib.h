@@ -350,6 +350,11 @@ void TrivTVBlockEvalInit(CagdRType *UKnotVector,
 void TrivTVBlockEvalSetMesh(CagdPType *Mesh);
 TrivTVBlockEvalStruct *TrivTVBlockEvalOnce(int i, int j, int k);
 void TrivTVBlockEvalDone(void);
+TrivTVBlockEvalStruct *TrivTVEvalPts(const TrivTVStruct *TV,
+				     const CagdPType *Params,
+				     int NumOfParams,
+				     CagdBType EvalJacobian);
+void TrivFFDPolygons(const TrivTVStruct *TV, struct IPPolygonStruct *Pls);
 TrivTVStruct *TrivTVRegionFromTV(const TrivTVStruct *TV,
 				 CagdRType t1,
 				 CagdRType t2,
@@ -106,6 +106,11 @@ typedef void (*TrngSetErrorFuncType)(TrngFatalErrorType);
 
 #define TRNG_MESH_IJK(TriSrf, i, j, k)	TRNG_MESH_JK(TriSrf, j, k)	
 
+/* Index of lattice point (i, j), i + j <= FineNess, in the vectors of      */
+/* TrngTriSrfEvalGrid, ordered by i and then by j.			     */
+#define TRNG_GRID_IJ(FineNess, i, j)	((i) * ((FineNess) + 1) - \
+					 (i) * ((i) - 1) / 2 + (j))
+
 #if defined(__cplusplus) || defined(c_plusplus)
 extern "C" {
 #endif
@@ -163,6 +168,10 @@ CagdRType *TrngTriSrfEval2(const TrngTriangSrfStruct *TriSrf,
 CagdVecStruct *TrngTriSrfNrml(const TrngTriangSrfStruct *TriSrf,
 			      CagdRType u,
 			      CagdRType v);
+CagdBType TrngTriSrfEvalGrid(const TrngTriangSrfStruct *TriSrf,
+			     int FineNess,
+			     CagdPType *Pts,
+			     CagdVType *Nrmls);
 void TrngTriSrfBBox(const TrngTriangSrfStruct *TriSrf, CagdBBoxStruct *BBox);
 void TrngTriSrfListBBox(const TrngTriangSrfStruct *TriSrfs,
 			CagdBBoxStruct *BBox);
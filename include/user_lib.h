@@ -180,6 +180,25 @@ CagdBType IntrSrfHierarchyTestPt(VoidPtr Handle,
 				 CagdPType Pt,
 				 CagdBType Nearest,
 				 CagdUVType InterUV);
+VoidPtr IntrSrfsHierarchyPreprocess(const CagdSrfStruct *Srfs,
+				    IrtRType FineNess);
+void IntrSrfsHierarchyFreePreprocess(VoidPtr Handle);
+CagdBType IntrSrfsHierarchyTestRay(VoidPtr Handle,
+				   const CagdPType RayOrigin,
+				   const CagdVType RayDir,
+				   CagdBType AnyHit,
+				   int *SrfIndex,
+				   CagdUVType InterUV,
+				   CagdRType *InterT);
+int IntrSrfsHierarchyTestRays(VoidPtr Handle,
+			      int NumRays,
+			      const CagdPType *RayOrigins,
+			      const CagdVType *RayDirs,
+			      CagdBType AnyHit,
+			      int *SrfIndices,
+			      CagdUVType *InterUVs,
+			      CagdRType *InterTs);
+CagdBType IntrSrfsHierarchyTestPtInside(VoidPtr Handle, const CagdPType Pt);
 
 /* Surface-plane contouring. */
 
@@ -77,6 +77,12 @@ int main(int argc, char *argv[])
     if (Options.VisMap)
         IPSurface2PolygonsGenDegenPolys(TRUE);
 
+    /* Tessellate freeforms one at a time as they are scan converted,      */
+    /* unless a pass below needs the polygons of the entire scene.         */
+    ParseDeferFreeForms(!Options.VisMap &&
+			!Options.NormalReverse &&
+			Options.PllMaxW == Options.PllMinW);
+
     Objects = ParseFiles(Options.NFiles, Options.Files,
 			 Options.HasTime, Options.Time);
 
@@ -368,6 +374,20 @@ static void ScanObjects(IRndrPtrType Rend,
     for ( ; Object; Object = Next) {
         Next = Object -> Pnext;
 
+	/* Tessellate a deferred freeform now, just before it is scanned. */
+	if (IP_IS_FFGEOM_OBJ(Object)) {
+	    IPObjectStruct *PLast;
+
+	    Object -> Pnext = NULL;
+	    if ((Object = ParseTessellateFreeForm(Object)) == NULL)
+	        continue;
+
+	    PLast = IPGetLastObj(Object);
+	    PLast -> Pnext = Next;
+	    Next = Object -> Pnext;
+	    Object -> Pnext = NULL;
+	}
+
 	/* Convert to point list to individual point objects' list and push  */
 	/* all points but one point that will replace Object.		     */
         if (IP_IS_POLY_OBJ(Object) && IP_IS_POINTLIST_OBJ(Object)) {
@@ -12,6 +12,9 @@
 #include "config.h"
 #include "parser.h"
 
+IRIT_STATIC_DATA int
+    GlblDeferFreeForms = FALSE;
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Parses input files using IRIT parser module.                             M
@@ -57,6 +60,63 @@ IPObjectStruct *ParseFiles(int argc,
     return PObjects;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Sets the freeform deferral mode.  If TRUE, freeforms are kept as they    M
+* are read and ParseFiles returns them untessellated.  Each one is then      M
+* tessellated by ParseTessellateFreeForm right before it is scan converted,  M
+* so rendering starts as soon as the scene is read and the polygons of only  M
+* one object are kept in memory at a time.                                   M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Defer:    IN, TRUE to defer freeforms' tessellation, FALSE otherwise.    M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:     Old value of deferral mode.                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   ParseTessellateFreeForm                                                  M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   ParseDeferFreeForms                                                      M
+*****************************************************************************/
+int ParseDeferFreeForms(int Defer)
+{
+    int OldVal = GlblDeferFreeForms;
+
+    GlblDeferFreeForms = Defer;
+
+    return OldVal;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Tessellates one freeform object that was deferred by ParseFiles, in      M
+*   place.                                                                   M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   PObj:     IN, the freeform object to tessellate.  Must not be in a list. M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IPObjectStruct *:  Polygonal approximation of PObj, possibly a list.     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   ParseDeferFreeForms                                                      M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   ParseTessellateFreeForm                                                  M
+*****************************************************************************/
+IPObjectStruct *ParseTessellateFreeForm(IPObjectStruct *PObj)
+{
+    int OldDefer = ParseDeferFreeForms(FALSE);
+
+    PObj = IPFlattenTree(PObj);
+
+    ParseDeferFreeForms(OldDefer);
+
+    return PObj;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Reads free form description from the Irit data file and converts it      M
@@ -76,6 +136,9 @@ IPObjectStruct *IPProcessFreeForm(IPFreeFormStruct *FreeForms)
     IPObjectStruct *Object;
     IPPolygonStruct *Poly;
 
+    if (GlblDeferFreeForms)
+        return IPConcatFreeForm(FreeForms);
+
     for (Object = FreeForms -> CrvObjs;
          Object != NULL;
          Object = Object -> Pnext) {
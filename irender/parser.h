@@ -7,5 +7,7 @@ IPObjectStruct *ParseFiles(int argc,
                            char *argv[],
                            int UseAnimation,
                            IrtRType AnimTime);
+int ParseDeferFreeForms(int Defer);
+IPObjectStruct *ParseTessellateFreeForm(IPObjectStruct *PObj);
 
 #endif
@@ -970,6 +970,11 @@ void IPSocHandleClientEvent(int Handler, IPObjectStruct *PObj)
 	    IRIT_WNDW_FPRINTF2("<<IPC>> Client %d failed to pick <<CPI>>\n",
 			       Handler);
 	}
+	else if (strcmp(IP_GET_OBJ_NAME(PObj), "_PATCHFAIL_") == 0) {
+	    /* Client failed to patch the object - send it in full now. */
+	    if (IP_IS_STR_OBJ(PObj))
+	        IritClientDeltaResend(Handler, PObj -> U.Str);
+	}
 	else if (strcmp(IP_GET_OBJ_NAME(PObj), "_PICKNAME_") == 0) {
 	    IRIT_WNDW_FPRINTF3("<<IPC>> Client %d picked object name \"%s\" <<CPI>>\n",
 			       Handler, PObj -> U.Str);
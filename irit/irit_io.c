@@ -88,10 +88,33 @@ IRIT_STATIC_DATA char LECtrl[LE_NUM_OF_CONTROLS] =
     ASCII_LF      /* NewLine */
 };
 
+#define IRIT_DELTA_COORD_LEN	25   /* Bound on length of " %.15g" or " %d". */
+#define IRIT_DELTA_HASH_SIZE	64
+#define IRIT_DELTA_MAX_OBJS	256
+
 IRIT_STATIC_DATA int
-    GlblAutoExecDisplay = -1;
+    GlblAutoExecDisplay = -1,
+    GlblNumClientSentObjs = 0,
+    GlblClientSentVictim = 0;
+IRIT_STATIC_DATA IPObjectStruct
+    *GlblClientSentObjs[IRIT_DELTA_HASH_SIZE];   /* Copies sent, by name. */
 
 static IPObjectStruct *IritPickCrsrClientEvent(IrtRType *RWaitTime);
+static int IritClientDeltaHash(const char *Name);
+static int IritClientDeltaSameHandler(const IPObjectStruct *Sent,
+				      int Handler);
+static void IritClientDeltaRemove(int Handler, const char *Name);
+static IPObjectStruct **IritClientDeltaFind(int Handler, const char *Name);
+static void IritClientDeltaKeep(int Handler, IPObjectStruct *PObj);
+static int IritClientDeltaSameAttrs(const IPAttributeStruct *Attr1,
+				    const IPAttributeStruct *Attr2);
+static int IritClientDeltaCtlPts(char *Patch,
+				 int PatchSize,
+				 CagdPointType PType,
+				 CagdRType * const *Points,
+				 CagdRType * const *OldPoints,
+				 int Len);
+static int IritClientDeltaWrite(int Handler, IPObjectStruct *PObj);
 
 #ifdef __WINNT__
 
@@ -702,6 +725,8 @@ double IritClientExecute(const char *PrgmName)
 
     if (Handle < 0)
 	IRIT_NON_FATAL_ERROR("Failed to execute program, exec failed");
+    else
+        IritClientDeltaRemove(Handle, NULL); /* New client holds no objects. */
 
     return (double) Handle;
 }
@@ -726,6 +751,7 @@ void IritClientClose(IrtRType *RHandler, IrtRType *RKillClient)
 	KillClient = IRIT_REAL_PTR_TO_INT(RKillClient);
 
     IPSocDisConnectAndKill(KillClient, Handle);
+    IritClientDeltaRemove(Handle, NULL);
     
     if (GlblGUIMode)
 	IRIT_WNDW_FPRINTF2("<<IPC>> Closed client - handler %d <<CPI>>\n",
@@ -806,6 +832,9 @@ IPObjectStruct *IritClientCursor(IrtRType *RWaitTime)
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Writes one object to subprocess's output channel specified by Handler.   M
+*   If GlblDispDeltaUpdates, a curve or a surface that was already sent to   M
+* this Handler and only had some of its control points changed since, is     M
+* sent as a "PATCH" command of the changed control points only.		     M
 *                                                                            *
 * PARAMETERS:                                                                M
 *   RHandler:  Valid subprocess handler.                                     M
@@ -819,7 +848,393 @@ IPObjectStruct *IritClientCursor(IrtRType *RWaitTime)
 *****************************************************************************/
 void IritClientWrite(IrtRType *RHandler, IPObjectStruct *PObj)
 {
-    IPSocWriteOneObject(IRIT_REAL_PTR_TO_INT(RHandler), PObj);
+    int Handler = IRIT_REAL_PTR_TO_INT(RHandler);
+
+    if (GlblDispDeltaUpdates && IritClientDeltaWrite(Handler, PObj))
+        return;
+
+    IPSocWriteOneObject(Handler, PObj);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Handles a request of a client to receive object Name in full, as the     M
+* client failed to apply a "PATCH" command to it.  The copy of Name kept as  M
+* sent to this client is sent again, in full, right away.  If no such copy   M
+* is kept, the object Name in the current data base is sent instead.	     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Handler:   Client handler the request was received from.                 M
+*   Name:      Name of object the client failed to patch.                    M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritClientDeltaResend, ipc                                               M
+*****************************************************************************/
+void IritClientDeltaResend(int Handler, const char *Name)
+{
+    IPObjectStruct *PObj;
+
+    if ((PObj = *IritClientDeltaFind(Handler, Name)) == NULL)
+        PObj = *IritClientDeltaFind(IP_CLNT_BROADCAST_ALL_HANDLES, Name);
+
+    if (PObj != NULL)
+        IPSocWriteOneObject(Handler, PObj);
+    else if ((PObj = IritDBGetObjByName(Name)) != NULL &&
+	     (IP_IS_CRV_OBJ(PObj) || IP_IS_SRF_OBJ(PObj))) {
+        IPSocWriteOneObject(Handler, PObj);
+	IritClientDeltaKeep(Handler, PObj);
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the (case insensitive) hash key of object name Name.            *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Name:      Name of object to hash.                                       *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:       Index into GlblClientSentObjs.                                *
+*****************************************************************************/
+static int IritClientDeltaHash(const char *Name)
+{
+    unsigned int
+	Key = 0;
+
+    while (*Name)
+        Key = Key * 31 + toupper(*Name++);
+
+    return (int) (Key % IRIT_DELTA_HASH_SIZE);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Returns TRUE if the kept copy Sent is affected by a change in the        *
+* objects Handler holds.  Objects broadcast to all clients are affected by   *
+* any client and any object is affected by all clients.                      *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Sent:      Kept copy of an object sent to a client.                      *
+*   Handler:   Client handler whose objects were changed.                    *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:       TRUE if Sent is affected, FALSE otherwise.                    *
+*****************************************************************************/
+static int IritClientDeltaSameHandler(const IPObjectStruct *Sent,
+				      int Handler)
+{
+    int SentHandler = AttrGetObjectIntAttrib(Sent, "_ClntHandler");
+
+    return SentHandler == Handler ||
+	   SentHandler == IP_CLNT_BROADCAST_ALL_HANDLES ||
+	   Handler == IP_CLNT_BROADCAST_ALL_HANDLES;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Frees the kept copies of objects sent to Handler, so these objects will  *
+* be sent in full the next time.                                             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:   Client handler whose objects were removed.                    *
+*   Name:      Name of object that was removed, or NULL for all objects.     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IritClientDeltaRemove(int Handler, const char *Name)
+{
+    int i;
+
+    for (i = 0; i < IRIT_DELTA_HASH_SIZE; i++) {
+        IPObjectStruct *Sent,
+	    **SentPtr = &GlblClientSentObjs[i];
+
+	if (Name != NULL && i != IritClientDeltaHash(Name))
+	    continue;
+
+	while ((Sent = *SentPtr) != NULL) {
+	    if (IritClientDeltaSameHandler(Sent, Handler) &&
+		(Name == NULL || stricmp(IP_GET_OBJ_NAME(Sent), Name) == 0)) {
+	        *SentPtr = Sent -> Pnext;
+		IPFreeObject(Sent);
+		GlblNumClientSentObjs--;
+	    }
+	    else
+	        SentPtr = &Sent -> Pnext;
+	}
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Searches the kept copy of the object named Name sent to Handler.         *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:   Client handler the object was sent to.                        *
+*   Name:      Name of object to search.                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   IPObjectStruct **:  Address of the pointer to the kept copy (in its hash *
+*		        bucket of GlblClientSentObjs), or of bucket's last   *
+*			NULL.						     *
+*****************************************************************************/
+static IPObjectStruct **IritClientDeltaFind(int Handler, const char *Name)
+{
+    IPObjectStruct **PObj;
+
+    for (PObj = &GlblClientSentObjs[IritClientDeltaHash(Name)];
+	 *PObj != NULL;
+	 PObj = &(*PObj) -> Pnext) {
+        if (AttrGetObjectIntAttrib(*PObj, "_ClntHandler") == Handler &&
+	    stricmp(IP_GET_OBJ_NAME(*PObj), Name) == 0)
+	    break;
+    }
+
+    return PObj;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Keeps a copy of PObj as sent to Handler, for future deltas.  At most     *
+* IRIT_DELTA_MAX_OBJS copies are kept, freeing copies in a round robin order *
+* of the hash buckets, as needed.                                            *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:   Client handler PObj was sent to.                              *
+*   PObj:      Object that was sent.                                         *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IritClientDeltaKeep(int Handler, IPObjectStruct *PObj)
+{
+    int i = IritClientDeltaHash(IP_GET_OBJ_NAME(PObj));
+    IPObjectStruct *Sent;
+
+    while (GlblNumClientSentObjs >= IRIT_DELTA_MAX_OBJS) {
+        IPObjectStruct
+	    **SentPtr = &GlblClientSentObjs[GlblClientSentVictim];
+
+	GlblClientSentVictim = (GlblClientSentVictim + 1) %
+							IRIT_DELTA_HASH_SIZE;
+	if ((Sent = *SentPtr) != NULL) {
+	    *SentPtr = Sent -> Pnext;
+	    IPFreeObject(Sent);
+	    GlblNumClientSentObjs--;
+	}
+    }
+
+    Sent = IPCopyObject(NULL, PObj, TRUE);
+    AttrSetObjectIntAttrib(Sent, "_ClntHandler", Handler);
+    IRIT_LIST_PUSH(Sent, GlblClientSentObjs[i]);
+    GlblNumClientSentObjs++;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the (non internal) attributes of two objects.                   *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Attr1, Attr2:   The two attribute lists to compare.                      *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:     TRUE if the same, FALSE otherwise.                              *
+*****************************************************************************/
+static int IritClientDeltaSameAttrs(const IPAttributeStruct *Attr1,
+				    const IPAttributeStruct *Attr2)
+{
+    char Str1[IRIT_LINE_LEN_XLONG];
+
+    for (Attr1 = AttrTraceAttributes(NULL, Attr1),
+	 Attr2 = AttrTraceAttributes(NULL, Attr2);
+	 Attr1 != NULL && Attr2 != NULL;
+	 Attr1 = AttrTraceAttributes(Attr1, NULL),
+	 Attr2 = AttrTraceAttributes(Attr2, NULL)) {
+        strcpy(Str1, Attr2String(Attr1, TRUE));
+	if (strcmp(Str1, Attr2String(Attr2, TRUE)) != 0)
+	    return FALSE;
+    }
+
+    return Attr1 == NULL && Attr2 == NULL;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Appends to Patch the control points that differ between Points and       *
+* OldPoints, as "Index Coords..." pairs.                                     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Patch:      String to append the changed control points to.              *
+*   PatchSize:  Allocated size of Patch.                                     *
+*   PType:      Point type of both Points and OldPoints.                     *
+*   Points:     New control points.                                          *
+*   OldPoints:  Control points sent before.                                  *
+*   Len:        Number of control points.                                    *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   Number of changed control points, or -1 if too many to patch or   *
+*	   if they do not fit in Patch.					     *
+*****************************************************************************/
+static int IritClientDeltaCtlPts(char *Patch,
+				 int PatchSize,
+				 CagdPointType PType,
+				 CagdRType * const *Points,
+				 CagdRType * const *OldPoints,
+				 int Len)
+{
+    int i, j,
+	n = 0,
+	IsNotRational = !CAGD_IS_RATIONAL_PT(PType),
+	MaxCoord = CAGD_NUM_OF_PT_COORD(PType),
+	PatchLen = (int) strlen(Patch);
+
+    for (i = 0; i < Len; i++) {
+        for (j = IsNotRational; j <= MaxCoord; j++) {
+	    if (Points[j][i] != OldPoints[j][i])
+	        break;
+	}
+	if (j > MaxCoord)
+	    continue;
+
+	/* Sending more than half the points is no longer a delta. */
+	if (++n > Len / 2 ||
+	    PatchLen + (MaxCoord + 2) * IRIT_DELTA_COORD_LEN >= PatchSize)
+	    return -1;
+
+	PatchLen += sprintf(&Patch[PatchLen], " %d", i);
+	for (j = IsNotRational; j <= MaxCoord; j++)
+	    PatchLen += sprintf(&Patch[PatchLen], " %.15g", Points[j][i]);
+    }
+
+    return n;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Attempts to send PObj to Handler as a delta "PATCH" command of its       *
+* changed control points, with respect to the copy of it sent before.        *
+*   Keeps a copy of PObj, if a single curve or surface, for future deltas.   *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:   Client handler to write PObj to.                              *
+*   PObj:      Object to write.                                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:     TRUE if PObj was sent as a delta, FALSE if PObj should be sent  *
+*	     in full.							     *
+*****************************************************************************/
+static int IritClientDeltaWrite(int Handler, IPObjectStruct *PObj)
+{
+    char Patch[IRIT_LINE_LEN_XLONG];
+    const char
+        *Name = IP_GET_OBJ_NAME(PObj);
+    int n = -1;
+    IPObjectStruct *Sent, **SentPtr, *PCmd;
+
+    if (IP_IS_STR_OBJ(PObj) && stricmp(Name, "COMMAND_") == 0) {
+        const char
+	    *Str = PObj -> U.Str;
+
+        /* Commands that clear or remove objects in the clients. */
+        if (stricmp(Str, "CLEAR") == 0 ||
+	    stricmp(Str, "DCLEAR") == 0 ||
+	    stricmp(Str, "DISCONNECT") == 0 ||
+	    stricmp(Str, "EXIT") == 0)
+	    IritClientDeltaRemove(Handler, NULL);
+	else if (strnicmp(Str, "REMOVE", 6) == 0 && strlen(Str) > 7)
+	    IritClientDeltaRemove(Handler, &Str[7]);
+	return FALSE;
+    }
+
+    /* Only named objects replace objects of the same name in clients. */
+    if (Name[0] == 0 || Name[0] == '_' || stricmp(Name, "none") == 0)
+        return FALSE;
+
+    SentPtr = IritClientDeltaFind(Handler, Name);
+    if ((Sent = *SentPtr) != NULL) {
+        *SentPtr = Sent -> Pnext;
+	Sent -> Pnext = NULL;
+	GlblNumClientSentObjs--;
+    }
+
+    if (!IP_IS_CRV_OBJ(PObj) && !IP_IS_SRF_OBJ(PObj)) {
+        if (Sent != NULL)
+	    IPFreeObject(Sent);
+        return FALSE;
+    }
+
+    sprintf(Patch, "PATCH %s", Name);
+
+    if (Sent != NULL &&
+	Sent -> ObjType == PObj -> ObjType &&
+	IritClientDeltaSameAttrs(Sent -> Attr, PObj -> Attr)) {
+        if (IP_IS_CRV_OBJ(PObj)) {
+	    CagdCrvStruct
+	        *Crv = PObj -> U.Crvs,
+	        *OldCrv = Sent -> U.Crvs;
+
+	    if (Crv -> Pnext == NULL &&
+		OldCrv -> Pnext == NULL &&
+		Crv -> GType == OldCrv -> GType &&
+		Crv -> PType == OldCrv -> PType &&
+		Crv -> Order == OldCrv -> Order &&
+		Crv -> Length == OldCrv -> Length &&
+		Crv -> Periodic == OldCrv -> Periodic &&
+		(Crv -> KnotVector == NULL ||
+		 BspKnotVectorsSame(Crv -> KnotVector, OldCrv -> KnotVector,
+				    Crv -> Length + Crv -> Order, IRIT_UEPS)))
+	        n = IritClientDeltaCtlPts(Patch, sizeof(Patch), Crv -> PType,
+					  Crv -> Points, OldCrv -> Points,
+					  Crv -> Length);
+	}
+	else {
+	    CagdSrfStruct
+	        *Srf = PObj -> U.Srfs,
+	        *OldSrf = Sent -> U.Srfs;
+
+	    if (Srf -> Pnext == NULL &&
+		OldSrf -> Pnext == NULL &&
+		Srf -> GType == OldSrf -> GType &&
+		Srf -> PType == OldSrf -> PType &&
+		Srf -> UOrder == OldSrf -> UOrder &&
+		Srf -> VOrder == OldSrf -> VOrder &&
+		Srf -> ULength == OldSrf -> ULength &&
+		Srf -> VLength == OldSrf -> VLength &&
+		Srf -> UPeriodic == OldSrf -> UPeriodic &&
+		Srf -> VPeriodic == OldSrf -> VPeriodic &&
+		(Srf -> UKnotVector == NULL ||
+		 BspKnotVectorsSame(Srf -> UKnotVector, OldSrf -> UKnotVector,
+				    Srf -> ULength + Srf -> UOrder,
+				    IRIT_UEPS)) &&
+		(Srf -> VKnotVector == NULL ||
+		 BspKnotVectorsSame(Srf -> VKnotVector, OldSrf -> VKnotVector,
+				    Srf -> VLength + Srf -> VOrder,
+				    IRIT_UEPS)))
+	        n = IritClientDeltaCtlPts(Patch, sizeof(Patch), Srf -> PType,
+					  Srf -> Points, OldSrf -> Points,
+					  Srf -> ULength * Srf -> VLength);
+	}
+    }
+
+    if (Sent != NULL)
+        IPFreeObject(Sent);
+
+    /* Keep a copy of what the client now holds. */
+    IritClientDeltaKeep(Handler, PObj);
+
+    /* Send unchanged objects in full, as the client could have lost them. */
+    if (n <= 0)
+        return FALSE;
+
+    PCmd = IPGenStrObject("COMMAND_", Patch, NULL);
+    IPSocWriteOneObject(Handler, PCmd);
+    IPFreeObject(PCmd);
+
+    return TRUE;
 }
 
 /*****************************************************************************
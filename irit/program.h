@@ -115,6 +115,7 @@ IRIT_GLOBAL_DATA_HEADER int
     GlblLoadColor,	      /* Default colors for object loaded using LOAD */
     GlblPrimColor,	       /* primitives colors, respectively.	     */
     GlblDoGraphics,		/* Control if running in graphics/text mode. */
+    GlblDispDeltaUpdates,    /* Send only changed ctl pts to display devs. */
     GlblGUIMode,				     /* Running under a GUI. */
     GlblFatalError,		  /* True if disaster in system - must quit! */
     GlblPrintLogFile,		     /* If TRUE everything goes to log file. */
@@ -194,6 +195,7 @@ void IritClientClose(IrtRType *RHandler, IrtRType *RKillClient);
 IPObjectStruct *IritClientRead(IrtRType *RHandler, IrtRType *RBlock);
 IPObjectStruct *IritClientCursor(IrtRType *RWaitTime);
 void IritClientWrite(IrtRType *RHandler, IPObjectStruct *PObj);
+void IritClientDeltaResend(int Handler, const char *Name);
 
 #if defined(__cplusplus) || defined(c_plusplus)
 }
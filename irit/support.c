@@ -48,6 +48,7 @@ IRIT_GLOBAL_DATA int
     GlblRunScriptAndQuit = FALSE,
     GlblBspProdMethod	 = 0,
     GlblDoGraphics       = TRUE,/* Control if running in graphics/text mode. */
+    GlblDispDeltaUpdates = FALSE,  /* Send only changed ctl pts to displays. */
     GlblGUIMode          = FALSE,		     /* Running under a GUI. */
     GlblFatalError       = FALSE, /* True if disaster in system - must quit! */
     GlblPrintLogFile     = FALSE,    /* If TRUE everything goes to log file. */
@@ -179,6 +180,14 @@ IPObjectStruct *IritSetIritState(const char *Name, IPObjectStruct *Data)
 	else
 	    IRIT_WNDW_PUT_STR("Numeric state value expected");
     }
+    else if (stricmp(Name, "DispDelta") == 0) {
+	if (IP_IS_NUM_OBJ(Data)) {
+	    OldVal = IPGenNUMValObject(GlblDispDeltaUpdates);
+	    GlblDispDeltaUpdates = Data -> U.R != 0.0;
+	}
+	else
+	    IRIT_WNDW_PUT_STR("Numeric state value expected");
+    }
     else if (stricmp(Name, "DoGraphics") == 0) {
 	if (IP_IS_NUM_OBJ(Data)) {
 	    OldVal = IPGenNUMValObject(GlblDoGraphics);
@@ -14,6 +14,18 @@
 
 #define MDL_BOOL_CLIP_EPS_EXTENSION 0.01
 #define MDL_BOOL_MODEL_PERTURBATION 1e-12
+#define MDL_BOOL_BBOX_EPS_EXTENSION 1e-6
+
+typedef struct MdlBoolBVHLeafStruct {
+    CagdBBoxStruct BBox;
+    int Index;
+} MdlBoolBVHLeafStruct;
+
+typedef struct MdlBoolBVHStruct {
+    struct MdlBoolBVHStruct *Left, *Right;
+    CagdBBoxStruct BBox;
+    int Index;				   /* Index of leaf, -1 if interior. */
+} MdlBoolBVHStruct;
 
 IRIT_STATIC_DATA CagdRType
     GlblMdlBoolSubdivTol = 0.01,
@@ -26,6 +38,8 @@ IRIT_GLOBAL_DATA jmp_buf
     _MdlBoolLongJumpBuf;			 /* Used in fatal Bool err. */
 IRIT_GLOBAL_DATA MdlFatalErrorType 
     _MdlBoolFatalErrorNum = MDL_ERR_NO_ERROR;
+IRIT_STATIC_DATA int
+    GlblMdlBoolBVHAxis = 0;
 
 static void MdlBoolCleanInterCrvs(CagdCrvStruct *Crv,
 				  const CagdSrfStruct *Srf);
@@ -48,6 +62,20 @@ static MdlTrimSegStruct *MdlBoolGenTrimSegs(const MvarPolyStruct *Inters12,
 					    MdlTrimSrfStruct *Srf1,
 					    MdlTrimSrfStruct *Srf2);
 static void MdlBoolFPE(int Type);
+#if defined(ultrix) && defined(mips)
+static int MdlBoolBVHLeafCmpr(VoidPtr VLeaf1, VoidPtr VLeaf2);
+#else
+static int MdlBoolBVHLeafCmpr(const VoidPtr VLeaf1, const VoidPtr VLeaf2);
+#endif /* ultrix && mips (no const support) */
+static MdlBoolBVHStruct *MdlBoolBuildBVH(MdlBoolBVHLeafStruct *Leaves, int n);
+static MdlBoolBVHStruct *MdlBoolBuildTSrfsBVH(const MdlTrimSrfStruct *TSrfs,
+					      int *NumTSrfs);
+static void MdlBoolFreeBVH(MdlBoolBVHStruct *BVH);
+static int MdlBoolBBoxesOverlap(const CagdBBoxStruct *BBox1,
+				const CagdBBoxStruct *BBox2);
+static void MdlBoolBVHOverlaps(const MdlBoolBVHStruct *BVH,
+			       const CagdBBoxStruct *BBox,
+			       CagdBType *Overlaps);
 static MdlModelStruct *MdlInterTwoModels(const MdlModelStruct *Model1,
 					 const MdlModelStruct *Model2,
 					 MdlBooleanType BType);
@@ -611,6 +639,196 @@ static void MdlBoolFPE(int Type)
     longjmp(_MdlBoolLongJumpBuf, 1);
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Comparison function to sort BVH leaves by the center of their bbox along *
+* axis GlblMdlBoolBVHAxis.						     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   VLeaf1, VLeaf2:  Two leaves to compare.                                  *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   -1, 0, +1 based on the relation between the two bboxes' centers.  *
+*****************************************************************************/
+#if defined(ultrix) && defined(mips)
+static int MdlBoolBVHLeafCmpr(VoidPtr VLeaf1, VoidPtr VLeaf2)
+#else
+static int MdlBoolBVHLeafCmpr(const VoidPtr VLeaf1, const VoidPtr VLeaf2)
+#endif /* ultrix && mips (no const support) */
+{
+    const CagdBBoxStruct
+	*BBox1 = &((const MdlBoolBVHLeafStruct *) VLeaf1) -> BBox,
+	*BBox2 = &((const MdlBoolBVHLeafStruct *) VLeaf2) -> BBox;
+    CagdRType
+	Diff = (BBox1 -> Min[GlblMdlBoolBVHAxis] +
+		BBox1 -> Max[GlblMdlBoolBVHAxis]) -
+	       (BBox2 -> Min[GlblMdlBoolBVHAxis] +
+		BBox2 -> Max[GlblMdlBoolBVHAxis]);
+
+    if (Diff != 0.0)
+        return IRIT_SIGN(Diff);
+
+    /* Keep the order stable so the tree does not depend on qsort. */
+    return ((const MdlBoolBVHLeafStruct *) VLeaf1) -> Index -
+	   ((const MdlBoolBVHLeafStruct *) VLeaf2) -> Index;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Builds a bounding volume hierarchy over the given leaves by recursively  *
+* splitting them at the median of their centers, along the longest axis.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Leaves:    The leaves to build a hierarchy for.  Reordered in place.     *
+*   n:         Number of leaves, at least one.                               *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   MdlBoolBVHStruct *:   The root of the hierarchy.                         *
+*****************************************************************************/
+static MdlBoolBVHStruct *MdlBoolBuildBVH(MdlBoolBVHLeafStruct *Leaves, int n)
+{
+    int i, Axis;
+    CagdRType Len;
+    MdlBoolBVHStruct
+        *BVH = (MdlBoolBVHStruct *) IritMalloc(sizeof(MdlBoolBVHStruct));
+
+    BVH -> BBox = Leaves[0].BBox;
+    for (i = 1; i < n; i++)
+        CagdMergeBBox(&BVH -> BBox, &Leaves[i].BBox);
+
+    if (n == 1) {
+        BVH -> Left = BVH -> Right = NULL;
+	BVH -> Index = Leaves[0].Index;
+	return BVH;
+    }
+    BVH -> Index = -1;
+
+    for (Axis = 0, Len = -1.0, i = 0; i < 3; i++) {
+        if (Len < BVH -> BBox.Max[i] - BVH -> BBox.Min[i]) {
+	    Len = BVH -> BBox.Max[i] - BVH -> BBox.Min[i];
+	    Axis = i;
+	}
+    }
+
+    GlblMdlBoolBVHAxis = Axis;
+    qsort(Leaves, n, sizeof(MdlBoolBVHLeafStruct), MdlBoolBVHLeafCmpr);
+
+    BVH -> Left = MdlBoolBuildBVH(Leaves, n >> 1);
+    BVH -> Right = MdlBoolBuildBVH(&Leaves[n >> 1], n - (n >> 1));
+
+    return BVH;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Builds a bounding volume hierarchy over the bboxes of the given list of  *
+* trimmed surfaces.  Leaves hold the indices of the trimmed surfaces in the  *
+* list.  The bboxes are slightly enlarged so touching surfaces overlap.      *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   TSrfs:      List of trimmed surfaces to build the hierarchy for.         *
+*   NumTSrfs:   Returns the number of trimmed surfaces in TSrfs.             *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   MdlBoolBVHStruct *:   The root of the hierarchy or NULL if TSrfs empty.  *
+*****************************************************************************/
+static MdlBoolBVHStruct *MdlBoolBuildTSrfsBVH(const MdlTrimSrfStruct *TSrfs,
+					      int *NumTSrfs)
+{
+    int i, j,
+        n = CagdListLength(TSrfs);
+    MdlBoolBVHLeafStruct *Leaves;
+    MdlBoolBVHStruct *BVH;
+
+    if ((*NumTSrfs = n) == 0)
+        return NULL;
+
+    Leaves = (MdlBoolBVHLeafStruct *)
+                                IritMalloc(sizeof(MdlBoolBVHLeafStruct) * n);
+    for (i = 0; TSrfs != NULL; TSrfs = TSrfs -> Pnext, i++) {
+        CagdSrfBBox(TSrfs -> Srf, &Leaves[i].BBox);
+	for (j = 0; j < 3; j++) {
+	    Leaves[i].BBox.Min[j] -= MDL_BOOL_BBOX_EPS_EXTENSION;
+	    Leaves[i].BBox.Max[j] += MDL_BOOL_BBOX_EPS_EXTENSION;
+	}
+	Leaves[i].Index = i;
+    }
+
+    BVH = MdlBoolBuildBVH(Leaves, n);
+
+    IritFree(Leaves);
+
+    return BVH;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Frees a bounding volume hierarchy.                                       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   BVH:     The hierarchy to free.                                          *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void MdlBoolFreeBVH(MdlBoolBVHStruct *BVH)
+{
+    if (BVH == NULL)
+        return;
+
+    MdlBoolFreeBVH(BVH -> Left);
+    MdlBoolFreeBVH(BVH -> Right);
+    IritFree(BVH);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Tests if two bounding boxes overlap.                                     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   BBox1, BBox2:   The two bounding boxes to test.                          *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:     TRUE if the two bboxes overlap, FALSE otherwise.                *
+*****************************************************************************/
+static int MdlBoolBBoxesOverlap(const CagdBBoxStruct *BBox1,
+				const CagdBBoxStruct *BBox2)
+{
+    return BBox1 -> Min[0] <= BBox2 -> Max[0] &&
+	   BBox2 -> Min[0] <= BBox1 -> Max[0] &&
+	   BBox1 -> Min[1] <= BBox2 -> Max[1] &&
+	   BBox2 -> Min[1] <= BBox1 -> Max[1] &&
+	   BBox1 -> Min[2] <= BBox2 -> Max[2] &&
+	   BBox2 -> Min[2] <= BBox1 -> Max[2];
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Marks all leaves of the BVH whose bbox overlaps BBox.                    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   BVH:        The hierarchy to traverse.                                   *
+*   BBox:       The bbox to test against.                                    *
+*   Overlaps:   Vector indexed by leaves' indices, to set TRUE if overlap.   *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void MdlBoolBVHOverlaps(const MdlBoolBVHStruct *BVH,
+			       const CagdBBoxStruct *BBox,
+			       CagdBType *Overlaps)
+{
+    while (BVH != NULL && MdlBoolBBoxesOverlap(&BVH -> BBox, BBox)) {
+        if (BVH -> Index >= 0) {
+	    Overlaps[BVH -> Index] = TRUE;
+	    return;
+	}
+
+	MdlBoolBVHOverlaps(BVH -> Left, BBox, Overlaps);
+	BVH = BVH -> Right;
+    }
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 *   Compute the intersection curves between the given two models, if any,    *
@@ -627,8 +845,11 @@ static MdlModelStruct *MdlInterTwoModels(const MdlModelStruct *Model1,
 					 const MdlModelStruct *Model2,
 					 MdlBooleanType BType)
 {
-    int MdlsInter = FALSE;
+    int NumTSrfs2,
+        MdlsInter = FALSE;
+    CagdBType *Overlaps;
     IrtVecType Translate;
+    MdlBoolBVHStruct *BVH2;
     MdlModelStruct *CpModel2,
         *CpModel1 = MdlModelCopy(Model1),
 	*Model = MdlModelNew2(NULL, NULL);
@@ -687,18 +908,39 @@ static MdlModelStruct *MdlInterTwoModels(const MdlModelStruct *Model1,
 	}
     }
 
-    /* Do an O(n^2) pass over all pairs of surfaces and intersect them, */
+    /* Intersect all pairs of surfaces whose bboxes overlap.  A BVH of    */
+    /* the surfaces of the second model culls the far apart pairs and the */
+    /* surviving pairs are visited in the original lists' order.          */
+    BVH2 = MdlBoolBuildTSrfsBVH(CpModel2 -> TrimSrfList, &NumTSrfs2);
+    Overlaps = (CagdBType *) IritMalloc(sizeof(CagdBType) *
+					IRIT_MAX(NumTSrfs2, 1));
+
     for (TSrf1 = CpModel1 -> TrimSrfList;
 	 TSrf1 != NULL;
 	 TSrf1 = TSrf1 -> Pnext) {
-        for (TSrf2 = CpModel2 -> TrimSrfList;
+        int i;
+	CagdBBoxStruct BBox1;
+
+	CagdSrfBBox(TSrf1 -> Srf, &BBox1);
+	for (i = 0; i < 3; i++) {
+	    BBox1.Min[i] -= MDL_BOOL_BBOX_EPS_EXTENSION;
+	    BBox1.Max[i] += MDL_BOOL_BBOX_EPS_EXTENSION;
+	}
+	IRIT_ZAP_MEM(Overlaps, sizeof(CagdBType) * NumTSrfs2);
+	MdlBoolBVHOverlaps(BVH2, &BBox1, Overlaps);
+
+        for (TSrf2 = CpModel2 -> TrimSrfList, i = 0;
 	     TSrf2 != NULL;
-	     TSrf2 = TSrf2 -> Pnext) {
-	    MvarPolyStruct
-	        *Inters12 = MvarSrfSrfInter2(TSrf1 -> Srf, TSrf2 -> Srf,
-					     GlblMdlBoolTraceTol,
-					     GlblMdlBoolSubdivTol,
-					     GlblMdlBoolNumerTol);
+	     TSrf2 = TSrf2 -> Pnext, i++) {
+	    MvarPolyStruct *Inters12;
+
+	    if (!Overlaps[i])
+	        continue;
+
+	    Inters12 = MvarSrfSrfInter2(TSrf1 -> Srf, TSrf2 -> Srf,
+					GlblMdlBoolTraceTol,
+					GlblMdlBoolSubdivTol,
+					GlblMdlBoolNumerTol);
 
 	    if (Inters12 != NULL) {
 	        MdlTrimSegStruct *TSegs;
@@ -725,6 +967,9 @@ static MdlModelStruct *MdlInterTwoModels(const MdlModelStruct *Model1,
 	}
     }
 
+    IritFree(Overlaps);
+    MdlBoolFreeBVH(BVH2);
+
 #ifdef DEBUG
     assert(MdlDebugVerify(Model, FALSE));
 #endif /* DEBUG */
@@ -8,6 +8,53 @@
 
 #include "mdl_loc.h"
 
+#define MDL_SHARED_SEG_MAX_DEPTH	10
+#define MDL_SHARED_SEG_MIN_DEPTH	2
+#define MDL_SHARED_SEG_PRM_EPS		1e-10
+
+typedef struct MdlSharedSegStruct {
+    const MdlTrimSegStruct *Seg;
+    CagdCrvStruct *UVCrvFirst;      /* Linear samples of both UV curves, at */
+    CagdCrvStruct *UVCrvSecond;     /* the same locations along the segment. */
+} MdlSharedSegStruct;
+
+#if defined(ultrix) && defined(mips)
+static int MdlSharedSegCmpr(VoidPtr VSeg1, VoidPtr VSeg2);
+#else
+static int MdlSharedSegCmpr(const VoidPtr VSeg1, const VoidPtr VSeg2);
+#endif /* ultrix && mips (no const support) */
+static void MdlSharedSegEvalUV(const CagdCrvStruct *UVCrv,
+			       CagdBType Reversed,
+			       CagdRType s,
+			       CagdRType *UV);
+static int MdlSharedSegKnots(const CagdCrvStruct *UVCrv,
+			     CagdBType Reversed,
+			     CagdRType *Knots);
+static void MdlSharedSegAddPrm(CagdRType **Prms,
+			       int *NumPrms,
+			       int *MaxPrms,
+			       CagdRType s);
+static void MdlSharedSegSubdiv(const CagdCrvStruct *UVCrv1,
+			       const CagdCrvStruct *UVCrv2,
+			       CagdBType Reversed,
+			       CagdRType s0,
+			       CagdRType s1,
+			       int Depth,
+			       int MinDepth,
+			       CagdRType UVTol,
+			       CagdRType **Prms,
+			       int *NumPrms,
+			       int *MaxPrms);
+static CagdCrvStruct *MdlSharedSegLinCrv(const CagdCrvStruct *UVCrv,
+					 CagdBType Reversed,
+					 const CagdRType *Prms,
+					 int NumPrms);
+static void MdlSharedSegSample(MdlSharedSegStruct *SSeg, CagdRType UVTol);
+static TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfsAux(const MdlModelStruct *Model,
+						 MdlSharedSegStruct *SSegs,
+						 int NumSSegs,
+						 CagdRType UVTol);
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Converting the model into the list of trimming surfaces.                 M
@@ -20,12 +67,103 @@
 *                                                                            *
 * SEE ALSO:                                                                  M
 *   TrimCrvSegNew, TrimCrvNew, TrimsrfNew, MdlExtractUVCrv,		     M
-*   MdlCnvrtSrf2Mdl, MdlCnvrtTrimmedSrf2Mdl				     M
+*   MdlCnvrtSrf2Mdl, MdlCnvrtTrimmedSrf2Mdl, MdlCnvrtMdl2TrimmedSrfs2	     M
 *                                                                            *
 * KEYWORDS:                                                                  M
 *   MdlCnvrtMdl2TrimmedSrfs                                                  M
 *****************************************************************************/
 TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfs(const MdlModelStruct *Model)
+{
+    return MdlCnvrtMdl2TrimmedSrfsAux(Model, NULL, 0, 0.0);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Converting the model into the list of trimming surfaces, with all        M
+* trimming curves approximated as piecewise linear curves to within UVTol.   M
+*   Every trimming segment of the model is sampled once, and both its UV     M
+* curves (in the two surfaces that share it) are sampled at the same         M
+* locations along the segment.  Hence the two faces that share an edge get   M
+* the same number of trimming vertices along it, at matching positions, and  M
+* the tessellations of the two faces match along their common boundary.     M
+*   As the trimming curves are already linear, the tessellators of trimmed   M
+* surfaces (see TrimSrf2Polygons2) use these samples as is.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Model:  Model to convert to a list of trimmed surfaces.                  M
+*   UVTol:  Maximal distance, in the parametric domains of the surfaces,    M
+*	    between a trimming curve and its piecewise linear approximation. M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   TrimSrfStruct *:  List of trimming surfaces.                             M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   MdlCnvrtMdl2TrimmedSrfs, TrimSrf2Polygons2, TrimSetTrimCrvLinearApprox  M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   MdlCnvrtMdl2TrimmedSrfs2                                                 M
+*****************************************************************************/
+TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfs2(const MdlModelStruct *Model,
+					CagdRType UVTol)
+{
+    int i,
+	NumSSegs = 0;
+    MdlTrimSegStruct *MdlSeg;
+    MdlSharedSegStruct *SSegs;
+    TrimSrfStruct *TrimSrfs;
+
+    for (MdlSeg = Model -> TrimSegList;
+	 MdlSeg != NULL;
+	 MdlSeg = MdlSeg -> Pnext)
+        NumSSegs++;
+
+    if (NumSSegs == 0)
+        return MdlCnvrtMdl2TrimmedSrfs(Model);
+
+    /* The samples are keyed by the (address of the) trimming segment. */
+    SSegs = (MdlSharedSegStruct *)
+			     IritMalloc(NumSSegs * sizeof(MdlSharedSegStruct));
+    for (MdlSeg = Model -> TrimSegList, i = 0;
+	 MdlSeg != NULL;
+	 MdlSeg = MdlSeg -> Pnext, i++) {
+        SSegs[i].Seg = MdlSeg;
+	SSegs[i].UVCrvFirst = SSegs[i].UVCrvSecond = NULL;
+    }
+    qsort(SSegs, NumSSegs, sizeof(MdlSharedSegStruct), MdlSharedSegCmpr);
+
+    TrimSrfs = MdlCnvrtMdl2TrimmedSrfsAux(Model, SSegs, NumSSegs, UVTol);
+
+    for (i = 0; i < NumSSegs; i++) {
+        if (SSegs[i].UVCrvFirst != NULL)
+	    CagdCrvFree(SSegs[i].UVCrvFirst);
+        if (SSegs[i].UVCrvSecond != NULL)
+	    CagdCrvFree(SSegs[i].UVCrvSecond);
+    }
+    IritFree(SSegs);
+
+    return TrimSrfs;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Auxiliary function of MdlCnvrtMdl2TrimmedSrfs and                        *
+* MdlCnvrtMdl2TrimmedSrfs2.  If SSegs is not NULL, trimming segments found   *
+* in SSegs are sampled once, to within UVTol, and their samples are used.    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Model:     Model to convert to a list of trimmed surfaces.               *
+*   SSegs:     Shared samples of the trimming segments, sorted by segment,   *
+*	       or NULL to use the trimming curves as they are.		     *
+*   NumSSegs:  Size of vector SSegs.					     *
+*   UVTol:     Tolerance of the samples of SSegs.			     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   TrimSrfStruct *:  List of trimming surfaces.                             *
+*****************************************************************************/
+static TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfsAux(const MdlModelStruct *Model,
+						 MdlSharedSegStruct *SSegs,
+						 int NumSSegs,
+						 CagdRType UVTol)
 {
     int IsFirstSeg, IsFirstCrv, Length,
         IsFirstSrf = TRUE;
@@ -43,6 +181,7 @@ TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfs(const MdlModelStruct *Model)
     MdlLoopStruct *MdlLoop;
     MdlTrimSegRefStruct *MdlRef;
     MdlTrimSegStruct *MdlSeg;
+    MdlSharedSegStruct Key, *SSeg;
     MdlTrimSrfStruct    
 	*MdlSrf = Model -> TrimSrfList;
 
@@ -58,7 +197,25 @@ TrimSrfStruct *MdlCnvrtMdl2TrimmedSrfs(const MdlModelStruct *Model)
 
 		while (MdlRef) {
 		    MdlSeg = MdlRef -> TrimSeg;
-		    SegCrv = CagdCrvCopy(MdlExtractUVCrv(MdlSrf, MdlSeg));
+		    SSeg = NULL;
+		    if (SSegs != NULL) {
+		        Key.Seg = MdlSeg;
+			SSeg = (MdlSharedSegStruct *)
+			    bsearch(&Key, SSegs, NumSSegs,
+				    sizeof(MdlSharedSegStruct),
+				    MdlSharedSegCmpr);
+		    }
+
+		    if (SSeg != NULL) {
+		        if (SSeg -> UVCrvFirst == NULL)
+			    MdlSharedSegSample(SSeg, UVTol);
+			SegCrv = CagdCrvCopy(MdlSeg -> SrfFirst -> Srf ==
+					                        MdlSrf -> Srf ?
+					         SSeg -> UVCrvFirst :
+					         SSeg -> UVCrvSecond);
+		    }
+		    else
+		        SegCrv = CagdCrvCopy(MdlExtractUVCrv(MdlSrf, MdlSeg));
 		    Length = SegCrv -> Length;
 
 		    if (IRIT_APX_EQ(SegCrv -> Points[1][0],
@@ -189,3 +346,329 @@ CagdCrvStruct *MdlExtractUVCrv(const MdlTrimSrfStruct *MdlSrf,
 	    return NULL;
     }
 } 
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares two shared segments by the address of their trimming segment,  *
+* for qsort/bsearch.                                                         *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   VSeg1, VSeg2:  Two shared segments to compare.                           *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   -1, 0, or +1 based on the order of the trimming segments.         *
+*****************************************************************************/
+#if defined(ultrix) && defined(mips)
+static int MdlSharedSegCmpr(VoidPtr VSeg1, VoidPtr VSeg2)
+#else
+static int MdlSharedSegCmpr(const VoidPtr VSeg1, const VoidPtr VSeg2)
+#endif /* ultrix && mips (no const support) */
+{
+    IritIntPtrSizeType
+	Seg1 = (IritIntPtrSizeType) ((const MdlSharedSegStruct *) VSeg1) -> Seg,
+	Seg2 = (IritIntPtrSizeType) ((const MdlSharedSegStruct *) VSeg2) -> Seg;
+
+    return Seg1 < Seg2 ? -1 : Seg1 > Seg2;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Evaluates UVCrv at a parameter s, normalized to be between zero and one  *
+* along the trimming segment.                                                *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   UVCrv:     UV trimming curve to evaluate.                                *
+*   Reversed:  TRUE if UVCrv runs from the end of the segment to its start.  *
+*   s:         Normalized parameter along the segment, between 0 and 1.     *
+*   UV:        Where to place the evaluated UV location.                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void MdlSharedSegEvalUV(const CagdCrvStruct *UVCrv,
+			       CagdBType Reversed,
+			       CagdRType s,
+			       CagdRType *UV)
+{
+    CagdRType TMin, TMax, *R;
+
+    CagdCrvDomain(UVCrv, &TMin, &TMax);
+    if (Reversed)
+        s = 1.0 - s;
+
+    R = CagdCrvEval(UVCrv, TMin + (TMax - TMin) * IRIT_BOUND(s, 0.0, 1.0));
+    CagdCoerceToE2(UV, &R, -1, UVCrv -> PType);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Fetches the interior knots of UVCrv, normalized to be between zero and   *
+* one along the trimming segment and in increasing order.  For linear        *
+* curves these are the vertices of the polyline.                             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   UVCrv:     UV trimming curve to fetch the interior knots of.             *
+*   Reversed:  TRUE if UVCrv runs from the end of the segment to its start.  *
+*   Knots:     Where to place the knots, of size UVCrv -> Length at least.   *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   Number of knots placed in Knots.                                  *
+*****************************************************************************/
+static int MdlSharedSegKnots(const CagdCrvStruct *UVCrv,
+			     CagdBType Reversed,
+			     CagdRType *Knots)
+{
+    int i,
+	n = 0;
+    CagdRType TMin, TMax;
+
+    if (!CAGD_IS_BSPLINE_CRV(UVCrv))
+        return 0;
+
+    CagdCrvDomain(UVCrv, &TMin, &TMax);
+    for (i = UVCrv -> Order; i < UVCrv -> Length; i++) {
+        CagdRType
+	    s = (UVCrv -> KnotVector[i] - TMin) / (TMax - TMin);
+
+	if (s > MDL_SHARED_SEG_PRM_EPS && s < 1.0 - MDL_SHARED_SEG_PRM_EPS)
+	    Knots[n++] = s;
+    }
+
+    if (Reversed) {
+        for (i = 0; i < n >> 1; i++)
+	    IRIT_SWAP(CagdRType, Knots[i], Knots[n - 1 - i]);
+	for (i = 0; i < n; i++)
+	    Knots[i] = 1.0 - Knots[i];
+    }
+
+    return n;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Appends parameter s to the growing vector of parameters Prms.           *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Prms:     Growing vector of parameters, reallocated as needed.           *
+*   NumPrms:  Number of parameters in Prms.                                  *
+*   MaxPrms:  Allocated size of Prms.                                        *
+*   s:        New parameter to append.                                       *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void MdlSharedSegAddPrm(CagdRType **Prms,
+			       int *NumPrms,
+			       int *MaxPrms,
+			       CagdRType s)
+{
+    if (*NumPrms >= *MaxPrms) {
+        *Prms = (CagdRType *) IritRealloc(*Prms,
+					  *MaxPrms * sizeof(CagdRType),
+					  *MaxPrms * 2 * sizeof(CagdRType));
+	*MaxPrms *= 2;
+    }
+
+    (*Prms)[(*NumPrms)++] = s;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Subdivides the segment's parametric interval [s0, s1] until the chords  *
+* of both UV curves are within UVTol of the curves.  The parameters of the   *
+* subdivision are appended to Prms, excluding s0 and including s1.           *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   UVCrv1:    UV curve of the segment in its first surface.                 *
+*   UVCrv2:    UV curve of the segment in its second surface, or NULL.       *
+*   Reversed:  TRUE if UVCrv2 runs opposite to UVCrv1.                       *
+*   s0, s1:    Normalized parametric interval to subdivide.                  *
+*   Depth:     Of recursion.                                                 *
+*   MinDepth:  Minimal depth to subdivide to, regardless of UVTol.           *
+*   UVTol:     Maximal distance between a chord and its curve.               *
+*   Prms:      Growing vector of parameters, reallocated as needed.          *
+*   NumPrms:   Number of parameters in Prms.                                 *
+*   MaxPrms:   Allocated size of Prms.                                       *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void MdlSharedSegSubdiv(const CagdCrvStruct *UVCrv1,
+			       const CagdCrvStruct *UVCrv2,
+			       CagdBType Reversed,
+			       CagdRType s0,
+			       CagdRType s1,
+			       int Depth,
+			       int MinDepth,
+			       CagdRType UVTol,
+			       CagdRType **Prms,
+			       int *NumPrms,
+			       int *MaxPrms)
+{
+    CagdRType
+	s = (s0 + s1) * 0.5;
+    CagdBType
+	Subdiv = Depth < MinDepth;
+
+    if (!Subdiv && Depth < MDL_SHARED_SEG_MAX_DEPTH) {
+        int i;
+	CagdUVType UV0, UV, UV1;
+
+	for (i = 0; i < 2 && !Subdiv; i++) {
+	    const CagdCrvStruct
+	        *UVCrv = i == 0 ? UVCrv1 : UVCrv2;
+	    CagdBType
+	        Rvrsd = i == 0 ? FALSE : Reversed;
+
+	    if (UVCrv == NULL)
+	        continue;
+
+	    MdlSharedSegEvalUV(UVCrv, Rvrsd, s0, UV0);
+	    MdlSharedSegEvalUV(UVCrv, Rvrsd, s, UV);
+	    MdlSharedSegEvalUV(UVCrv, Rvrsd, s1, UV1);
+
+	    Subdiv = IRIT_SQR(UV[0] - (UV0[0] + UV1[0]) * 0.5) +
+		     IRIT_SQR(UV[1] - (UV0[1] + UV1[1]) * 0.5) >
+							      IRIT_SQR(UVTol);
+	}
+    }
+
+    if (Subdiv) {
+        MdlSharedSegSubdiv(UVCrv1, UVCrv2, Reversed, s0, s, Depth + 1,
+			   MinDepth, UVTol, Prms, NumPrms, MaxPrms);
+	MdlSharedSegSubdiv(UVCrv1, UVCrv2, Reversed, s, s1, Depth + 1,
+			   MinDepth, UVTol, Prms, NumPrms, MaxPrms);
+    }
+    else
+        MdlSharedSegAddPrm(Prms, NumPrms, MaxPrms, s1);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Constructs the linear curve through the samples of UVCrv at the given   *
+* normalized parameters.                                                     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   UVCrv:     UV trimming curve to sample.                                  *
+*   Reversed:  TRUE if UVCrv runs from the end of the segment to its start.  *
+*   Prms:      Normalized parameters to sample UVCrv at, in increasing order.*
+*   NumPrms:   Size of vector Prms.                                          *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdCrvStruct *:  A linear Bspline curve, in the direction of UVCrv.     *
+*****************************************************************************/
+static CagdCrvStruct *MdlSharedSegLinCrv(const CagdCrvStruct *UVCrv,
+					 CagdBType Reversed,
+					 const CagdRType *Prms,
+					 int NumPrms)
+{
+    int i;
+    CagdCrvStruct
+	*LinCrv = BspCrvNew(NumPrms, 2, CAGD_PT_E2_TYPE);
+    CagdRType
+	**Points = LinCrv -> Points;
+
+    BspKnotUniformOpen(NumPrms, 2, LinCrv -> KnotVector);
+
+    for (i = 0; i < NumPrms; i++) {
+        CagdUVType UV;
+	int j = Reversed ? NumPrms - 1 - i : i;
+
+	MdlSharedSegEvalUV(UVCrv, Reversed, Prms[j], UV);
+	Points[1][i] = UV[0];
+	Points[2][i] = UV[1];
+    }
+
+    return LinCrv;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Samples the two UV curves of a trimming segment at the same locations    *
+* along the segment, into linear curves, to within UVTol.  The UV curves     *
+* are assumed to follow the segment at a similar speed, as do the curves     *
+* computed by the Boolean operations of models.                              *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   SSeg:    Shared segment to sample, updated in place.                     *
+*   UVTol:   Maximal distance between a UV curve and its approximation.     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void MdlSharedSegSample(MdlSharedSegStruct *SSeg, CagdRType UVTol)
+{
+    int i, j, n1, n2, MinDepth,
+	NumPrms = 0,
+	MaxPrms = 32;
+    CagdRType *Knots1, *Knots2, *Prms,
+	s = 0.0;
+    CagdBType
+	Reversed = FALSE;
+    const MdlTrimSegStruct
+	*Seg = SSeg -> Seg;
+    const CagdCrvStruct
+	*UVCrv1 = Seg -> UVCrvFirst,
+	*UVCrv2 = Seg -> UVCrvSecond;
+
+    if (UVCrv2 != NULL && Seg -> SrfSecond == NULL)
+	UVCrv2 = NULL;
+
+    if (UVCrv2 != NULL) {
+        CagdRType *R;
+	CagdPType Pt, Pt0, Pt1;
+	CagdUVType UV;
+
+	/* Find if the second UV curve follows the first one or opposes it, */
+	/* by comparing the Euclidean locations of their end points.        */
+	MdlSharedSegEvalUV(UVCrv1, FALSE, 0.0, UV);
+	R = CagdSrfEval(Seg -> SrfFirst -> Srf, UV[0], UV[1]);
+	CagdCoerceToE3(Pt, &R, -1, Seg -> SrfFirst -> Srf -> PType);
+
+	MdlSharedSegEvalUV(UVCrv2, FALSE, 0.0, UV);
+	R = CagdSrfEval(Seg -> SrfSecond -> Srf, UV[0], UV[1]);
+	CagdCoerceToE3(Pt0, &R, -1, Seg -> SrfSecond -> Srf -> PType);
+
+	MdlSharedSegEvalUV(UVCrv2, FALSE, 1.0, UV);
+	R = CagdSrfEval(Seg -> SrfSecond -> Srf, UV[0], UV[1]);
+	CagdCoerceToE3(Pt1, &R, -1, Seg -> SrfSecond -> Srf -> PType);
+
+	Reversed = IRIT_PT_PT_DIST_SQR(Pt, Pt1) < IRIT_PT_PT_DIST_SQR(Pt, Pt0);
+    }
+
+    /* The interior knots of both curves must be sampled, merged in order. */
+    Knots1 = (CagdRType *) IritMalloc(sizeof(CagdRType) *
+				      (UVCrv1 -> Length + 
+				       (UVCrv2 != NULL ? UVCrv2 -> Length : 0)));
+    n1 = MdlSharedSegKnots(UVCrv1, FALSE, Knots1);
+    Knots2 = &Knots1[n1];
+    n2 = UVCrv2 != NULL ? MdlSharedSegKnots(UVCrv2, Reversed, Knots2) : 0;
+
+    MinDepth = UVCrv1 -> Order > 2 ||
+	       (UVCrv2 != NULL && UVCrv2 -> Order > 2) ?
+				                  MDL_SHARED_SEG_MIN_DEPTH : 0;
+
+    Prms = (CagdRType *) IritMalloc(sizeof(CagdRType) * MaxPrms);
+    MdlSharedSegAddPrm(&Prms, &NumPrms, &MaxPrms, 0.0);
+
+    for (i = j = 0; i < n1 || j < n2; ) {
+        CagdRType
+	    s1 = j >= n2 || (i < n1 && Knots1[i] < Knots2[j]) ? Knots1[i++]
+							       : Knots2[j++];
+
+	if (s1 - s > MDL_SHARED_SEG_PRM_EPS) {
+	    MdlSharedSegSubdiv(UVCrv1, UVCrv2, Reversed, s, s1, 0, MinDepth,
+			       UVTol, &Prms, &NumPrms, &MaxPrms);
+	    s = s1;
+	}
+    }
+    MdlSharedSegSubdiv(UVCrv1, UVCrv2, Reversed, s, 1.0, 0, MinDepth,
+		       UVTol, &Prms, &NumPrms, &MaxPrms);
+
+    SSeg -> UVCrvFirst = MdlSharedSegLinCrv(UVCrv1, FALSE, Prms, NumPrms);
+    SSeg -> UVCrvSecond = UVCrv2 != NULL ?
+		      MdlSharedSegLinCrv(UVCrv2, Reversed, Prms, NumPrms) : NULL;
+
+    IritFree(Knots1);
+    IritFree(Prms);
+}
@@ -363,6 +363,9 @@ static MiscISCImageSizeType MiscISCGetZipSize(MiscISCCalculatorPtrType Calc,
                                               MiscISCImageSizeType Size);
 static MiscISCUnitType MiscISCGetHighBitMask();
 static int MiscISCIsZeroArray(void *Arr, MiscISCImageSizeType SizeInBytes);
+static MiscISCImageSizeType MiscISCBnWUnitWeight(MiscISCCalculatorPtrType Calc,
+                                                 MiscISCUnitType Unit,
+                                                 MiscISCImageSizeType Pixel);
 static void *MiscISCArrayCopy(MiscISCCalculatorPtrType Calc, 
                               void *OutputArr,
                               void *InputArr, 
@@ -462,6 +465,10 @@ static void MiscISCCalculateGreedyAux(MiscISCCalculatorPtrType Calc,
                                       int **SolutionByIndex,
                                       int *SolutionSize,
                                       IrtRType *CoverPart);
+static void MiscISCGreedyHeapSiftDown(int *Heap,
+                                      int HeapSize,
+                                      MiscISCImageSizeType *Gains,
+                                      int i);
 
 /******************************************************************************
 * DESCRIPTION:                                                                *
@@ -547,25 +554,20 @@ static void *MiscISCMalloc(MiscISCCalculatorPtrType Calc, unsigned int Size)
 {
     void
         *Res = NULL;
-    MiscISCFreeMemoryStruct **AllocateNext;
+    MiscISCFreeMemoryStruct *AllocateNext;
 
     Res = IritMalloc(Size);
     if (Calc == NULL) 
         return Res;
     MiscISCLongJmpCond(Calc, Res != NULL, MISC_ISC_ERROR_ALLOCATING_MEMORY);   
 
-    if (Calc -> MemoryToFree == NULL) {
-        AllocateNext = &Calc -> MemoryToFree;
-    }
-    else {
-        for (AllocateNext = &Calc -> MemoryToFree; (*AllocateNext)!= NULL; 
-            AllocateNext = &(*AllocateNext) -> PNext);
-    }
-    (*AllocateNext) = IritMalloc(sizeof(MiscISCFreeMemoryStruct));
-    MiscISCLongJmpCond(Calc, (*AllocateNext) != NULL, 
+    /* Push in front - recent allocations are also the first to be freed. */
+    AllocateNext = IritMalloc(sizeof(MiscISCFreeMemoryStruct));
+    MiscISCLongJmpCond(Calc, AllocateNext != NULL, 
         MISC_ISC_ERROR_ALLOCATING_MEMORY);
-    (*AllocateNext) -> PNext = NULL;
-    (*AllocateNext) -> MemoryToFree = Res;
+    AllocateNext -> PNext = Calc -> MemoryToFree;
+    AllocateNext -> MemoryToFree = Res;
+    Calc -> MemoryToFree = AllocateNext;
     return Res;
 }
 
@@ -645,25 +647,20 @@ static unsigned long MiscISCArrayHashCallback(void *Arr,
                                               MiscISCImageSizeType SizeInBytes, 
                                               unsigned int KeySizeBits)
 {
-    char 
-        *CharArray = (char *) Arr;
-    unsigned long i, j, Step, 
+    unsigned char 
+        *CharArray = (unsigned char *) Arr;
+    unsigned long i, 
         Ret = 0;
 
-    if (SizeInBytes <= KeySizeBits) {
-        for (i = 0; i < SizeInBytes; ++i) {
-            Ret <<= 1;
-            Ret |= (CharArray[i] & 0x01);
-        }
+    /* Mix all the bytes - sampling only few of them makes pixels seen by   */
+    /* similar sets of pictures collide and the hash degenerates to a list. */
+    for (i = 0; i < SizeInBytes; ++i)
+        Ret = Ret * 31 + CharArray[i];
 
+    if (KeySizeBits >= (sizeof(unsigned long) << 3))
         return Ret;
-    }
-
-    Step = SizeInBytes / KeySizeBits;
-    for (i = 0, j = 0; i < KeySizeBits; ++i, j += Step) {
-        Ret <<= 1;
-        Ret |= (CharArray[j] & 0x01);
-    }
+    while (Ret >> KeySizeBits)
+        Ret = (Ret >> KeySizeBits) ^ (Ret & ((1UL << KeySizeBits) - 1));
 
     return Ret;
 }
@@ -862,6 +859,43 @@ static int MiscISCIsZeroArray(void *Arr, MiscISCImageSizeType SizeInBytes)
     return TRUE;
 }
 
+/******************************************************************************
+* DESCRIPTION:                                                                *
+*    Used in B&W calculators. Sums the number of unprocessed pixels the set   *
+* bits of one zipped unit stand for (see Calc -> PixelsAmount). Bit i of the  *
+* unit is pixel Pixel + i, as laid out by MiscISCZipPicture. Zero bytes are   *
+* skipped at once and padding bits beyond the image are ignored.              *
+*                                                                             *
+* PARAMETERS:                                                                 *
+*    Calc:  The calculator.                                                   *
+*    Unit:  The zipped unit.                                                  *
+*    Pixel: The index of the pixel of the lowest bit of Unit.                 *
+*                                                                             *
+* RETURN VALUE:                                                               *
+*    MiscISCImageSizeType: The sum of the pixels amount of the set bits.      *
+******************************************************************************/
+static MiscISCImageSizeType MiscISCBnWUnitWeight(MiscISCCalculatorPtrType Calc,
+                                                 MiscISCUnitType Unit,
+                                                 MiscISCImageSizeType Pixel)
+{
+    MiscISCImageSizeType
+        Weight = 0;
+
+    while (Unit != 0 && Pixel < Calc -> ImageSize) {
+        if ((Unit & 0xFF) == 0) {
+            Unit >>= 8;
+            Pixel += 8;
+            continue;
+        }
+        if (Unit & 0x01)
+            Weight += Calc -> PixelsAmount[Pixel];
+        Unit >>= 1;
+        Pixel++;
+    }
+
+    return Weight;
+}
+
 /******************************************************************************
 * DESCRIPTION:                                                                *
 *   Copy InputArr to OutputArr. If OutputArr is NULL allocate new memory and  *
@@ -911,14 +945,21 @@ static MiscISCImageSizeType MiscISCBnWGreedyPicValue(
                                            void *Picture,
                                            void *ToCover)
 {
-    MiscISCImageSizeType i, Cover;
+    MiscISCImageSizeType i, Size, Cover;
+    MiscISCUnitType 
+        *PicInner = (MiscISCUnitType *) Picture,
+        *CoverInner = (MiscISCUnitType *) ToCover;
 
+    /* Work a unit at a time, only looking into units with common pixels. */
+    Size = Calc -> ImageSizeInBytes / sizeof(MiscISCUnitType);
     Cover = 0;   
-    for (i = 0; i <= Calc -> ImageSize - 1; i++) {
-        if ((Calc -> NeedToCover(Picture, i) == 1) &&
-            (Calc -> NeedToCover(ToCover, i) == 1)) {
-            Cover += Calc -> PixelsAmount[i];
-        }
+    for (i = 0; i < Size; i++) {
+        MiscISCUnitType
+            Common = PicInner[i] & CoverInner[i];
+
+        if (Common != 0)
+            Cover += MiscISCBnWUnitWeight(Calc, Common, 
+                                          i * (sizeof(MiscISCUnitType) << 3));
     }
     return Cover;
 }
@@ -1845,6 +1886,9 @@ static IrtRType MiscISCGetSelectionRank(MiscISCCalculatorPtrType Calc,
         if (Calc -> NeedToCover(Calc -> Pictures[PictureIndex], i))
             Ret += 1.0 / ((IrtRType) Calc -> VisibilitySetsSizes[i]);
     }
+
+    /* The rank does not depend on the search state - keep it. */
+    Calc -> SelectionRanks[PictureIndex] = Ret;
     return Ret;
 }
 
@@ -1878,6 +1922,8 @@ static IrtRType MiscISCGetTotalSelectionRank(MiscISCCalculatorPtrType Calc,
         if (Calc -> NeedToCover(Calc -> Pictures[i], PixelIndex))
             Ret += MiscISCGetSelectionRank(Calc, i);
     }
+
+    Calc -> TotalSelectionRanks[PixelIndex] = Ret;
     return Ret;
 }
 
@@ -2682,9 +2728,15 @@ static MiscISCImageSizeType MiscISCGetCoverAmount(
         Cover = 0;
 
     if (Calc -> ColorType == MISC_ISC_BNW) {
-        for (i = 0; i <= Calc -> ImageSize - 1; i++) {
-            if (!Calc -> NeedToCover(ToCover, i))
-                Cover += Calc -> PixelsAmount[i];
+        MiscISCImageSizeType
+            Size = Calc -> ImageSizeInBytes / sizeof(MiscISCUnitType);
+        MiscISCUnitType 
+            *CoverInner = (MiscISCUnitType *) ToCover;
+
+        for (i = 0; i < Size; i++) {
+            if (~CoverInner[i] != 0)
+                Cover += MiscISCBnWUnitWeight(Calc, ~CoverInner[i], 
+                                          i * (sizeof(MiscISCUnitType) << 3));
         }
     }
     else { /* MISC_ISC_GRAY */
@@ -2783,9 +2835,9 @@ static void MiscISCCalculateGreedyAux(MiscISCCalculatorPtrType Calc,
                                       int *SolutionSize,
                                       IrtRType *CoverPart)
 {
-    int i,
+    int i, HeapSize, *Heap,
         BestPicture = 0; 
-    MiscISCImageSizeType 
+    MiscISCImageSizeType *Gains,
         TotalCover = 0,
         BestCover = 0;
     MiscISCUsePictureTypeType *Solution;
@@ -2807,19 +2859,42 @@ static void MiscISCCalculateGreedyAux(MiscISCCalculatorPtrType Calc,
         Calc, sizeof(MiscISCUsePictureTypeType) * Calc -> NumPictures, 
         0); /* setmem to 0 will make MISC_ISC_NOT_USED at all cells. */
  
+    /* The value of a picture can only drop as the cover grows, so a stale   */
+    /* value is an upper bound. Keep the pictures in a max heap by their     */
+    /* last known value and only re-evaluate the top one (lazy greedy). A    */
+    /* picture whose value did not change is the best, as in a full scan.    */
+    Gains = (MiscISCImageSizeType *) MiscISCMalloc(Calc, 
+                       sizeof(MiscISCImageSizeType) * Calc -> NumPictures);
+    Heap = (int *) MiscISCMalloc(Calc, sizeof(int) * Calc -> NumPictures);
+    for (i = 0; i < Calc -> NumPictures; ++i) {
+        Gains[i] = Calc -> GreedyGetPictureValue(Calc, 
+                                       Calc -> Pictures[i], RequiredCover);
+        Heap[i] = i;
+    }
+    HeapSize = Calc -> NumPictures;
+    for (i = HeapSize / 2 - 1; i >= 0; --i)
+        MiscISCGreedyHeapSiftDown(Heap, HeapSize, Gains, i);
+ 
     *SolutionSize = 0;
     while(TRUE){
         BestCover = 0;
         /* Find best next picture to add. */
-        for (i = 0; i <= Calc -> NumPictures - 1; ++i) {
+        while (HeapSize > 0) {
             MiscISCImageSizeType TempCover;
 
+            BestPicture = Heap[0];
+            if (Gains[BestPicture] == 0)
+                break;
             TempCover = Calc -> GreedyGetPictureValue(Calc, 
-                Calc -> Pictures[i], RequiredCover);
-            if (TempCover > BestCover) {
-                BestPicture = i;
+                Calc -> Pictures[BestPicture], RequiredCover);
+            if (TempCover == Gains[BestPicture]) {
                 BestCover = TempCover;
+                Heap[0] = Heap[--HeapSize];
+                MiscISCGreedyHeapSiftDown(Heap, HeapSize, Gains, 0);
+                break;
             }
+            Gains[BestPicture] = TempCover;
+            MiscISCGreedyHeapSiftDown(Heap, HeapSize, Gains, 0);
         }
         TotalCover += BestCover;
         if ((BestCover == 0) || (TotalCover > Calc -> CoverLimitInPixels))
@@ -2837,6 +2912,47 @@ static void MiscISCCalculateGreedyAux(MiscISCCalculatorPtrType Calc,
         RequiredCover);
     *CoverPart = MiscISCGetCoverPart(Calc, Calc -> SolutionCover);
 
+    MiscISCFree(Calc, Heap);
+    MiscISCFree(Calc, Gains);
     MiscISCFree(Calc, Solution);
     MiscISCFree(Calc, RequiredCover);
 }
+
+/******************************************************************************
+* DESCRIPTION:                                                                *
+*   Used in the greedy algorithm. Sifts down entry i of a max heap of picture *
+* indices, ordered by Gains and then by the smaller picture index first (so  *
+* ties are broken exactly as a linear scan over the pictures would).          *
+*                                                                             *
+* PARAMETERS:                                                                 *
+*   Heap:     The heap of picture indices.                                    *
+*   HeapSize: The number of entries in Heap.                                  *
+*   Gains:    The (possibly stale) value of each picture.                     *
+*   i:        The entry to sift down.                                         *
+*                                                                             *
+* RETURN VALUE:                                                               *
+*   void                                                                      *
+******************************************************************************/
+static void MiscISCGreedyHeapSiftDown(int *Heap,
+                                      int HeapSize,
+                                      MiscISCImageSizeType *Gains,
+                                      int i)
+{
+    while (TRUE) {
+        int Child,
+            Best = i,
+            Left = 2 * i + 1;
+
+        for (Child = Left; Child <= Left + 1 && Child < HeapSize; Child++) {
+            if (Gains[Heap[Child]] > Gains[Heap[Best]] ||
+                (Gains[Heap[Child]] == Gains[Heap[Best]] &&
+                 Heap[Child] < Heap[Best]))
+                Best = Child;
+        }
+        if (Best == i)
+            return;
+
+        IRIT_SWAP(int, Heap[i], Heap[Best]);
+        i = Best;
+    }
+}
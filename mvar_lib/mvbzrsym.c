@@ -164,6 +164,29 @@ MvarMVStruct *MvarBzrMVMult(const MvarMVStruct *MV1, const MvarMVStruct *MV2)
 	while (MVAR_INCREMENT_MESH_INDICES(MV1, Indices1, Index1));
     }
     else {
+        /* Orders beyond the precomputed tables - use rows computed on      */
+	/* demand, fetched once for the first direction.		    */
+        const CagdRType
+	    *IChooseK1 = CagdIChooseKRow(Orders1[0] - 1),
+	    *IChooseK2 = CagdIChooseKRow(Orders2[0] - 1),
+	    *IChooseKProd = CagdIChooseKRow(ProdOrders[0] - 1);
+
+	/* The product orders are the largest, so if their rows exist, so   */
+	/* do all the rows of the operands' orders.			    */
+	for (i = 1; i < ProdMV -> Dim; i++) {
+	    if (CagdIChooseKRow(ProdOrders[i] - 1) == NULL)
+	        break;
+	}
+	if (IChooseKProd == NULL || i < ProdMV -> Dim) {
+	    IritFree(Indices1);
+	    MvarMVFree(ProdMV);
+	    if (CpMV1 != NULL)
+	        MvarMVFree(CpMV1);
+	    if (CpMV2 != NULL)
+	        MvarMVFree(CpMV2);
+	    return NULL;
+	}
+
         do {
 	    CagdRType
 		Coef0 = 1.0;
@@ -182,9 +205,9 @@ MvarMVStruct *MvarBzrMVMult(const MvarMVStruct *MV1, const MvarMVStruct *MV2)
 		    Coef0 = 1.0;
 
 		    for (i = 1; i < ProdMV -> Dim; i++, I1++, I2++) {
-		        Coef0 *= CagdIChooseK(*I1, *++O1 - 1) *
-		                 CagdIChooseK(*I2, *++O2 - 1) /
-		                 CagdIChooseK(*I1 + *I2, *++OP - 1);
+		        Coef0 *= CagdIChooseKRow(*++O1 - 1)[*I1] *
+		                 CagdIChooseKRow(*++O2 - 1)[*I2] /
+		                 CagdIChooseKRow(*++OP - 1)[*I1 + *I2];
 		    }
 
 		    for (i = ProdIndex = 0; i < ProdMV -> Dim; i++)
@@ -196,9 +219,9 @@ MvarMVStruct *MvarBzrMVMult(const MvarMVStruct *MV1, const MvarMVStruct *MV2)
 		}
 
 		Coef = Coef0 *
-		    CagdIChooseK(Indices1[0], Orders1[0] - 1) *
-		    CagdIChooseK(Indices2[0], Orders2[0] - 1) /
-		    CagdIChooseK(Indices1[0] + Indices2[0], ProdOrders[0] - 1);
+		    IChooseK1[Indices1[0]] *
+		    IChooseK2[Indices2[0]] /
+		    IChooseKProd[Indices1[0] + Indices2[0]];
 
 		for (i = IsNotRational; i <= MaxCoord; i++)
 		    Points[i][ProdIndex] +=
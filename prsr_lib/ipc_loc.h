@@ -59,6 +59,10 @@ void _IpcPtAdd(CagdRType *PtsRes[], int vRes,
 #define IPC_VERSION_1 1
 #define IPC_VERSION IPC_VERSION_1
 
+/* Stamp of the chunks' index that trails a chunked compressed file. */
+#define IPC_CHUNK_INDEX_STAMP	0x49434458
+#define IPC_CHUNK_ALIGN(Size)	(((Size) + 7) & ~7)
+
 /* Maximum safe quantization value, almost in all cases 	*/
 /* (1e8) can also be used, but visual testing has to be done. 	*/
 #define IPC_MAX_QUANTIZER (1e7)
@@ -324,7 +328,7 @@ typedef struct IpcStrings {
 /* Used with compression labrary. */ 
 #define IPC_INPUT_BUFFER_LEN    (4000000) /* 2^30 bytes = 0.5 Mb */  
 #define IPC_INPUT_BUFFER_FULL   (IPC_INPUT_BUFFER_LEN - 2 * sizeof(double)) 
-#define IPC_OUTPUT_BUFFER_LEN   (int)(IPC_INPUT_BUFFER_LEN * 1.1 + 12) 
+#define IPC_OUTPUT_BUFFER_LEN   (IPC_INPUT_BUFFER_LEN + IPC_INPUT_BUFFER_LEN / 10 + 12)
 #define IPC_COMPRESS_LEVEL 9    /* between 0 .. 9 */ 
 
 /* Set this flag, in order to write predicted data without compression. */
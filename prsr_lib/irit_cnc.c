@@ -15,6 +15,7 @@
 #include "prsr_loc.h"
 
 #define IP_NC_GC_INIT_ARRAY_SIZE	100
+#define IP_NC_GC_BLOCK_SIZE		256
 #define IP_NC_HELIX_APPROX		25
 #define IP_NC_MAX_CRV_LENGTH		100
 
@@ -52,11 +53,28 @@ typedef struct IPNCGCodeAccumArcLenStruct {
     int StartGCodeIndex;	/* Starting GCode from which we accumulate. */
 } IPNCGCodeAccumArcLenStruct;
 
+typedef struct IPNCGCodeBlockStruct {
+    struct IPNCGCodeBlockStruct *Pnext;
+    IPNCGCodeLineStruct GCodes[IP_NC_GC_BLOCK_SIZE];
+} IPNCGCodeBlockStruct;
+
 typedef struct IPNCGCodeStreamStruct {
     IPNCGCodeLineStruct CrntState;  /* Currrent state of stream processing. */
     IPNCGCodeLineStruct **GCodes;              /* All the processed stream. */
     int NumOfAllocGCodes;             /* Size of allocated array of GCodes. */
     int NumOfGCodes;                            /* Number of actual GCodes. */
+    IPNCGCodeBlockStruct *GCBlocks;    /* GCodes are allocated in blocks. */
+    int NumOfBlockGCodes;              /* Number of GCodes in first block. */
+    int NumOfLines;           /* Number of lines parsed, kept or streamed. */
+    /* The following are used in streaming mode, where lines are not kept. */
+    int Streaming;
+    int StreamHasData;        /* TRUE if a non comment line was streamed. */
+    int StreamCrntGC;              /* Index of record to fill in StreamGCs. */
+    IPNCGCodeLineStruct StreamGCs[2];  /* Current and last motion records. */
+    IPNCGCodeLineStruct *StreamPrevGC;       /* Last motion record or NULL. */
+    IPNCGCodeParserLineFuncType LineFunc;   /* Visits every streamed line. */
+    VoidPtr LineFuncData;
+    IrtRType StreamLen, StreamFastLen, StreamNoGLen; /* Accumulated lengths. */
     int CrntStep;			/* Current step of processed GCode. */
     int ArcCentersRelative;/* TRUE if arc centers relative to arc start pt. */
     int ReverseZDir;   /* TRUE to flip Z (when +Z is down - away from tool. */
@@ -115,6 +133,21 @@ static void IPNCGSubstituteSubString(char **Line,
 				     char GType,
 				     const char *NewStr);
 static void IPNCGUpdateLines(IPNCGCodeStreamStruct *GCS);
+static IrtRType IPNCGCodeMotionLength(IPNCGCodeStreamStruct *GCS,
+				      IPNCGCodeLineStruct *PrevGC,
+				      IPNCGCodeLineStruct *GC);
+static CagdCrvStruct *IPNCGCodeMakeArc(IPNCGCodeStreamStruct *GCS,
+				       IPNCGCodeLineStruct *PrevGC,
+				       IPNCGCodeLineStruct *GC);
+static IPNCGCodeLineStruct *IPNCGCodePrevMotion(IPNCGCodeStreamStruct *GCS,
+						int Index);
+static void IPNCGCodeEvalMotion(IPNCGCodeStreamStruct *GCS,
+				int Index,
+				IrtRType t,
+				IrtPtType Pos);
+static void IPNCGCodeStreamLine(IPNCGCodeStreamStruct *GCS,
+				IPNCGCodeLineStruct *GC);
+static int IPNCGCodeStreamDone(IPNCGCodeStreamStruct *GCS);
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -148,7 +181,7 @@ IPObjectStruct *IPNCGCodeLoadFile(const char *NCGCODEFileName,
     if (GStream != NULL &&
 	(f = fopen(NCGCODEFileName, "r")) != NULL) {
         int LineNum = 1;
-        char Line[IRIT_LINE_LEN_LONG];
+        char Line[IRIT_LINE_LEN_VLONG];
 	IPObjectStruct *PObj;
 
         /* Read the G-Code and process it one line at a time. */
@@ -178,6 +211,73 @@ IPObjectStruct *IPNCGCodeLoadFile(const char *NCGCODEFileName,
     return NULL;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Reads in a G-code CN file and computes its toolpath length, streaming    M
+* the file so the G codes are never kept and memory usage is constant.       M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   NCGCODEFileName:  G-Code file to read in.				     M
+*   ArcCentersRelative:  TRUE for arc center in relative coordinates with    M
+*		      respect to arc starting location, FALSE if in          M
+*		      absolute coordinates.				     M
+*   FastLength:       Accumulate fast motion length here, if non NULL.       M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IrtRType:  Length of cutting speed motion, or negative if error.         M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPNCGCodeLoadFile, IPNCGCodeLength, IPNCGCodeParserSetStreaming          M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPNCGCodeLoadFileLength                                                  M
+*****************************************************************************/
+IrtRType IPNCGCodeLoadFileLength(const char *NCGCODEFileName,
+				 int ArcCentersRelative,
+				 IrtRType *FastLength)
+{
+    FILE *f;
+    VoidPtr
+	GStream = IPNCGCodeParserInit(ArcCentersRelative, 1.0, 1000.0, 1,
+				      FALSE, NULL);
+
+    if (FastLength != NULL)
+        *FastLength = 0.0;
+
+    if (GStream == NULL)
+        return -1.0;
+
+    if ((f = fopen(NCGCODEFileName, "r")) != NULL) {
+        int LineNum = 1;
+        char Line[IRIT_LINE_LEN_VLONG];
+	IrtRType Len;
+
+	IPNCGCodeParserSetStreaming(GStream, NULL, NULL);
+
+	while (fgets(Line, IRIT_LINE_LEN_VLONG, f) != NULL)
+	    IPNCGCodeParserParseLine(GStream, Line, LineNum++);
+
+	if (!feof(f) || !IPNCGCodeParserDone(GStream)) {
+	    IPNCGCodeParserFree(GStream);
+	    fclose(f);
+	    return -1.0;
+	}
+	fclose(f);
+
+	Len = IPNCGCodeLength(GStream, FastLength);
+
+	IPNCGCodeParserFree(GStream);
+
+	return Len;
+    }
+
+    IPNCGCodeParserFree(GStream);
+    IP_FATAL_ERROR_EX(IP_ERR_FILE_NOT_FOUND, IP_ERR_NO_LINE_NUM,
+		      NCGCODEFileName);
+
+    return -1.0;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Initialize a new stream of G code to process.                            M
@@ -241,6 +341,18 @@ VoidPtr IPNCGCodeParserInit(int ArcCentersRelative,
     GCS -> GCodes = (IPNCGCodeLineStruct **)
 	IritMalloc(sizeof(IPNCGCodeLineStruct *) * GCS -> NumOfAllocGCodes);
     GCS -> ErrorFunc = ErrorFunc;
+    GCS -> GCBlocks = NULL;
+    GCS -> NumOfBlockGCodes = 0;
+    GCS -> NumOfLines = 0;
+
+    /* By default all lines are kept, see IPNCGCodeParserSetStreaming. */
+    GCS -> Streaming = FALSE;
+    GCS -> StreamHasData = FALSE;
+    GCS -> StreamCrntGC = 0;
+    GCS -> StreamPrevGC = NULL;
+    GCS -> LineFunc = NULL;
+    GCS -> LineFuncData = NULL;
+    GCS -> StreamLen = GCS -> StreamFastLen = GCS -> StreamNoGLen = 0.0;
 
     /* Update state. */
     GCS -> ArcCentersRelative = ArcCentersRelative;
@@ -249,6 +361,50 @@ VoidPtr IPNCGCodeParserInit(int ArcCentersRelative,
     return GCS;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Sets a new stream of G code, before any line is parsed, to streaming     M
+* mode.  In streaming mode the parsed lines are not kept.  Instead, every    M
+* parsed line is handed to LineFunc, in a record that is valid during that   M
+* call only, together with the record of the last line with motion before   M
+* it (or NULL).  Lengths are accumulated on the fly so IPNCGCodeLength can   M
+* be used once IPNCGCodeParserDone is called, all in constant memory.        M
+*   Streamed records hold the default feed rate, spindle speed and tool      M
+* number until real values are found, and Z is IRIT_INFNTY until the first  M
+* Z value is found.  Arcs' curves (Crv slot) are not constructed.	     M
+*   Functions that access individual steps or lines of the stream, such as   M
+* IPNCGCodeParserGetNext, IPNCGCode2Geometry or IPNCGCodeTraverseInit, find  M
+* no G codes in a streamed stream.					     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   IPNCGCodes:    Current GCodes' stream, with no parsed line yet.          M
+*   LineFunc:      Call back function to visit every line, or NULL.	     M
+*   LineFuncData:  Data to pass to LineFunc.                                 M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPNCGCodeParserInit, IPNCGCodeParserParseLine, IPNCGCodeParserDone,      M
+*   IPNCGCodeLength, IPNCGCodeLoadFileLength				     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPNCGCodeParserSetStreaming                                              M
+*****************************************************************************/
+void IPNCGCodeParserSetStreaming(VoidPtr IPNCGCodes,
+				 IPNCGCodeParserLineFuncType LineFunc,
+				 VoidPtr LineFuncData)
+{
+    IPNCGCodeStreamStruct
+	*GCS = (IPNCGCodeStreamStruct *) IPNCGCodes;
+
+    assert(GCS -> NumOfLines == 0);
+
+    GCS -> Streaming = TRUE;
+    GCS -> LineFunc = LineFunc;
+    GCS -> LineFuncData = LineFuncData;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 *   Parses the given line and locate all NC GCodes key-chars.                *
@@ -379,7 +535,7 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
 				 const char *NextLine,
 				 int LineNum)
 {
-    char *Line;
+    char *Line, StreamLine[IRIT_LINE_LEN_VLONG];
     int n, i;
     IPNCGCodeLineInfoStruct LineInfo;
     IPNCGCodeStreamStruct
@@ -387,23 +543,48 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
     IPNCGCodeLineStruct *GC,
         *GCSCrntState = &GCS -> CrntState;
 
-    if (GCS -> NumOfGCodes >= GCS -> NumOfAllocGCodes) {
-        /* Reallocated the array of GCodes. */
-        n = sizeof(IPNCGCodeLineStruct *) * GCS -> NumOfAllocGCodes;
-        GCS -> GCodes = (IPNCGCodeLineStruct **)
-					 IritRealloc(GCS -> GCodes, n, n * 2);
-	GCS -> NumOfAllocGCodes *= 2;
+    GCS -> NumOfLines++;
+
+    if (GCS -> Streaming) {
+        /* Reuse a record that is not the last motion record. */
+        GC = &GCS -> StreamGCs[GCS -> StreamCrntGC];
     }
+    else {
+        if (GCS -> NumOfGCodes >= GCS -> NumOfAllocGCodes) {
+	    /* Reallocated the array of GCodes. */
+	    n = sizeof(IPNCGCodeLineStruct *) * GCS -> NumOfAllocGCodes;
+	    GCS -> GCodes = (IPNCGCodeLineStruct **)
+					 IritRealloc(GCS -> GCodes, n, n * 2);
+	    GCS -> NumOfAllocGCodes *= 2;
+	}
 
-    GC = GCS -> GCodes[GCS -> NumOfGCodes++] = (IPNCGCodeLineStruct *)
-				    IritMalloc(sizeof(IPNCGCodeLineStruct));
+	/* Records are allocated in blocks, not one at a time. */
+	if (GCS -> GCBlocks == NULL ||
+	    GCS -> NumOfBlockGCodes >= IP_NC_GC_BLOCK_SIZE) {
+	    IPNCGCodeBlockStruct
+	        *Block = (IPNCGCodeBlockStruct *)
+				     IritMalloc(sizeof(IPNCGCodeBlockStruct));
+
+	    IRIT_LIST_PUSH(Block, GCS -> GCBlocks);
+	    GCS -> NumOfBlockGCodes = 0;
+	}
+
+	GC = GCS -> GCodes[GCS -> NumOfGCodes++] =
+		       &GCS -> GCBlocks -> GCodes[GCS -> NumOfBlockGCodes++];
+    }
 
     /* Use the current state as a default for this state. */
     IRIT_GEN_COPY(GC, GCSCrntState, sizeof(IPNCGCodeLineStruct));
     GC -> StreamLineNumber = LineNum;
 
     /* Time to parse this next line. */
-    Line = GC -> Line = IritStrdup(NextLine);
+    if (GCS -> Streaming) {
+        strncpy(StreamLine, NextLine, IRIT_LINE_LEN_VLONG - 1);
+	StreamLine[IRIT_LINE_LEN_VLONG - 1] = 0;
+	Line = GC -> Line = StreamLine;
+    }
+    else
+        Line = GC -> Line = IritStrdup(NextLine);
     for (i = ((int) strlen(Line)) - 1; i >= 0; i--) {
         if (Line[i] == '\n' || Line[i] == '\r')
 	    Line[i] = 0;
@@ -439,7 +620,7 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
         }
     }
     /* If we found no motion G code in this line - use the previous state.  */
-    if (GC -> GCodeType == IP_NC_GCODE_LINE_NONE && GCS -> NumOfGCodes > 1)
+    if (GC -> GCodeType == IP_NC_GCODE_LINE_NONE && GCS -> NumOfLines > 1)
         GC -> GCodeType = GCSCrntState -> GCodeType;
 
     if (GCS -> ArcCentersRelative)
@@ -486,7 +667,7 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
 
 	/* Do we have some initial G Codes with no real spindle speed?  If */
 	/* so, use this spindle speed to initialize those as well.         */
-	if (GCS -> GCodes[0] -> SpindleSpeed < 0.0) {
+	if (!GCS -> Streaming && GCS -> GCodes[0] -> SpindleSpeed < 0.0) {
 	    for (i = 0; i < GCS -> NumOfGCodes; i++) {
 	        if (GCS -> GCodes[i] -> SpindleSpeed < 0.0) 
 		    GCS -> GCodes[0] -> SpindleSpeed = LineInfo.S;
@@ -501,7 +682,7 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
 	IrtPtType Inter1Pt, Inter2Pt;
 
         /* Convert the arc radius to center. */
-        if (GCS -> NumOfGCodes >= 2 &&
+        if (GCS -> NumOfLines >= 2 &&
 	    (GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G2CW ||
 	     GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G3CCW) &&
 	    GM2PointsFromCircCirc(GCSCrntState -> XYZ, LineInfo.R,
@@ -545,7 +726,7 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
 
 	/* Do we have some initial G Codes with no real feedrate?  If so,  */
 	/* use this feed rate to initialize those as well.                 */
-	if (GCS -> GCodes[0] -> FeedRate < 0.0) {
+	if (!GCS -> Streaming && GCS -> GCodes[0] -> FeedRate < 0.0) {
 	    if (GCS -> ErrorFunc != NULL)
 	        GCS -> ErrorFunc(IRIT_EXP_STR("No feed rate detected in NC file"));
 
@@ -564,7 +745,7 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
 
 	/* Do we have some initial G Codes with no real tool number?  If   */
 	/* so, use this tool number to initialize those as well.           */
-	if (GCS -> GCodes[0] -> ToolNumber < 0) {
+	if (!GCS -> Streaming && GCS -> GCodes[0] -> ToolNumber < 0) {
 	    for (i = 0; i < GCS -> NumOfGCodes; i++) {
 	        if (GCS -> GCodes[i] -> ToolNumber < 0) 
 		    GCS -> GCodes[0] -> ToolNumber = n;
@@ -588,9 +769,71 @@ VoidPtr IPNCGCodeParserParseLine(VoidPtr IPNCGCodes,
     GC -> Len = GC -> LenStart = 0.0;
     GC -> Crv = NULL;
 
+    if (GCS -> Streaming)
+        IPNCGCodeStreamLine(GCS, GC);
+
     return GCS;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Completes the processing of one streamed line GC: resolves default       *
+* values, accumulates its length, hands it to the line call back function    *
+* and keeps it, if a motion line, as the last motion record.                 *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   GCS:     G Code sequence in streaming mode.                              *
+*   GC:      Just parsed line, in one of GCS's streaming records.            *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void					                             *
+*****************************************************************************/
+static void IPNCGCodeStreamLine(IPNCGCodeStreamStruct *GCS,
+				IPNCGCodeLineStruct *GC)
+{
+    IPNCGCodeLineStruct
+        *PrevGC = GCS -> StreamPrevGC;
+
+    /* Negative values signal defaults - use them as IPNCGCodeParserDone.  */
+    GC -> FeedRate = IRIT_FABS(GC -> FeedRate);
+    GC -> UpdatedFeedRate = GC -> FeedRate;
+    GC -> SpindleSpeed = IRIT_FABS(GC -> SpindleSpeed);
+    GC -> ToolNumber = IRIT_ABS(GC -> ToolNumber);
+
+    if (!GC -> Comment) {
+        GCS -> StreamHasData = TRUE;
+	GC -> LenStart = GCS -> StreamLen;
+
+	if (GC -> HasMotion && PrevGC != NULL) {
+	    GC -> Len = IPNCGCodeMotionLength(GCS, PrevGC, GC);
+
+	    switch (GC -> GCodeType) {
+	        case IP_NC_GCODE_LINE_MOTION_G0FAST:
+		    GCS -> StreamFastLen += GC -> Len;
+		    break;
+		case IP_NC_GCODE_LINE_MOTION_G1LINEAR:
+		case IP_NC_GCODE_LINE_MOTION_G2CW:
+		case IP_NC_GCODE_LINE_MOTION_G3CCW:
+		    GCS -> StreamLen += GC -> Len;
+		    break;
+		default:
+		    /* Counted as G1 only if no G command is found at all. */
+		    GCS -> StreamNoGLen += GC -> Len;
+		    break;
+	    }
+	}
+    }
+
+    if (GCS -> LineFunc != NULL)
+        GCS -> LineFunc(GC, PrevGC, GCS -> LineFuncData);
+    GC -> Line = NULL;
+
+    if (!GC -> Comment && GC -> HasMotion) {
+        GCS -> StreamPrevGC = GC;
+	GCS -> StreamCrntGC = 1 - GCS -> StreamCrntGC;
+    }
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Complete the reading of a new stream of G code.                          M
@@ -619,6 +862,9 @@ int IPNCGCodeParserDone(VoidPtr IPNCGCodes)
     IPNCGCodeLineStruct
 	**GC = GCS -> GCodes;
 
+    if (GCS -> Streaming)
+        return IPNCGCodeStreamDone(GCS);
+
     if (GCS -> NumOfGCodes < 2)
         return FALSE;
 
@@ -705,6 +951,60 @@ int IPNCGCodeParserDone(VoidPtr IPNCGCodes)
     return TRUE;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Complete the reading of a new stream of G code, in streaming mode.       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   GCS:     G Code sequence in streaming mode.                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:  TRUE if successful, FALSE otherwise.				     *
+*****************************************************************************/
+static int IPNCGCodeStreamDone(IPNCGCodeStreamStruct *GCS)
+{
+    char Line[IRIT_LINE_LEN_LONG];
+    IPNCGCodeLineStruct
+	*GC = &GCS -> CrntState;
+
+    if (GCS -> NumOfLines < 2 || !GCS -> StreamHasData)
+        return FALSE;
+
+    if (GCS -> ErrorFunc != NULL) {
+        if (GC -> FeedRate < 0.0) {
+	    sprintf(Line,
+		    IRIT_EXP_STR("No feedrate detected in NC file - using default %f"),
+		    IRIT_FABS(GC -> FeedRate));
+	    GCS -> ErrorFunc(Line);
+	}
+	if (GC -> SpindleSpeed < 0.0) {
+	    sprintf(Line,
+		    IRIT_EXP_STR("No spindle speed detected in NC file - using default %f"),
+		    IRIT_FABS(GC -> SpindleSpeed));
+	    GCS -> ErrorFunc(Line);
+	}
+	if (GC -> ToolNumber < 0) {
+	    sprintf(Line,
+		    IRIT_EXP_STR("No tool index detected in NC file - using default %d"),
+		    IRIT_ABS(GC -> ToolNumber));
+	    GCS -> ErrorFunc(Line);
+	}
+	if (GC -> XYZ[2] == IRIT_INFNTY)
+	    GCS -> ErrorFunc(IRIT_EXP_STR("No Z values detected in NC file - using 0.0 instead"));
+    }
+
+    if (GC -> GCodeType == IP_NC_GCODE_LINE_NONE ||
+	GC -> GCodeType == IP_NC_GCODE_LINE_NON_MOTION) {
+	if (GCS -> ErrorFunc != NULL)
+	    GCS -> ErrorFunc(IRIT_EXP_STR("No G command detected in file, assume G1 throughout"));
+
+	GCS -> StreamLen += GCS -> StreamNoGLen;
+	GCS -> StreamNoGLen = 0.0;
+    }
+
+    return TRUE;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Returns the number of GCode steps in the parsed stream IPNCGCodes.       M
@@ -852,7 +1152,13 @@ void IPNCGCodeParserFree(VoidPtr IPNCGCodes)
     for (i = 0; i < GCS -> NumOfGCodes; i++) {
         IritFree(GCS -> GCodes[i] -> Line);
         CagdCrvFree(GCS -> GCodes[i] -> Crv);
-	IritFree(GCS -> GCodes[i]);
+    }
+    while (GCS -> GCBlocks != NULL) {
+        IPNCGCodeBlockStruct
+	    *Block = GCS -> GCBlocks;
+
+	GCS -> GCBlocks = Block -> Pnext;
+	IritFree(Block);
     }
     IritFree(GCS -> GCodes);
     IritFree(GCS);
@@ -1024,6 +1330,160 @@ static CagdCrvStruct *IPNCCreateArcCW(CagdPtStruct *PtStart,
     }
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the length of the motion of GC, from PrevGC's position.         *
+*   Unknown Z values (IRIT_INFNTY) of streamed G codes are resolved the way  *
+* IPNCGCodeParserDone resolves them, to the first known Z value.             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   GCS:      G Code sequence GC belongs to.                                 *
+*   PrevGC:   Last G code with motion before GC.                             *
+*   GC:       G code to compute the length of its motion.                    *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   IrtRType:   Length of motion - arc length for arcs.                      *
+*****************************************************************************/
+static IrtRType IPNCGCodeMotionLength(IPNCGCodeStreamStruct *GCS,
+				      IPNCGCodeLineStruct *PrevGC,
+				      IPNCGCodeLineStruct *GC)
+{
+    IrtPtType Start, Center, End;
+
+    IRIT_PT_COPY(Start, PrevGC -> XYZ);
+    IRIT_PT_COPY(End, GC -> XYZ);
+    if (End[2] == IRIT_INFNTY)
+        End[2] = Start[2] = 0.0;
+    else if (Start[2] == IRIT_INFNTY)
+        Start[2] = End[2];
+
+    if (IP_NC_IS_GCODE_ARC_MOTION(GC)) {
+        IRIT_PT_COPY(Center, GC -> IJK);
+	if (GCS -> ArcCentersRelative) {
+	    IRIT_PT_ADD(Center, Center, Start);
+	}
+	Center[2] = Start[2];
+
+	return IPNCArcComputeArcLength(Start, Center, End,
+			   GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G2CW);
+    }
+    else if (IRIT_PT_APX_EQ_EPS(Start, End, IRIT_UEPS))
+        return 0.0;
+    else
+        return IRIT_PT_PT_DIST(Start, End);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Constructs the arc (or helix) of arc G code GC, from PrevGC's position.  *
+* The arc is parametrized over [0, 1].                                       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   GCS:      G Code sequence GC belongs to.                                 *
+*   PrevGC:   Last G code with motion before GC.                             *
+*   GC:       G2/G3 G code to construct its arc.                             *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdCrvStruct *:   Constructed arc, NULL if failed.                      *
+*****************************************************************************/
+static CagdCrvStruct *IPNCGCodeMakeArc(IPNCGCodeStreamStruct *GCS,
+				       IPNCGCodeLineStruct *PrevGC,
+				       IPNCGCodeLineStruct *GC)
+{
+    CagdCrvStruct *Arc;
+    CagdPtStruct PtStart, PtCenter, PtEnd;
+
+    /* Create the arc, assuming it is less than 360 degrees. */
+    IRIT_PT_COPY(PtStart.Pt, PrevGC -> XYZ);
+    IRIT_PT_COPY(PtEnd.Pt, GC -> XYZ);
+    IRIT_PT_COPY(PtCenter.Pt, GC -> IJK);
+    if (GCS -> ArcCentersRelative) {
+	IRIT_PT_ADD(PtCenter.Pt, PtCenter.Pt, PtStart.Pt);
+    }
+    PtCenter.Pt[2] = PtStart.Pt[2];
+    if (GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G2CW)
+        Arc = IPNCCreateArcCW(&PtStart, &PtCenter, &PtEnd);
+    else
+        Arc = IPNCCreateArcCCW(&PtStart, &PtCenter, &PtEnd);
+
+    if (Arc != NULL && CAGD_IS_BSPLINE_CRV(Arc)) {
+        BspKnotAffineTransOrder2(Arc -> KnotVector, Arc -> Order,
+				 Arc -> Order + Arc -> Length, 0.0, 1.0);
+    }
+
+    return Arc;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Finds the last G code with motion before the Index'th G code.            *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   GCS:      G Code sequence to search.                                     *
+*   Index:    Index of G code to search before.                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   IPNCGCodeLineStruct *:   Previous motion G code, NULL if none.           *
+*****************************************************************************/
+static IPNCGCodeLineStruct *IPNCGCodePrevMotion(IPNCGCodeStreamStruct *GCS,
+						int Index)
+{
+    while (--Index >= 0) {
+        IPNCGCodeLineStruct
+	    *GC = GCS -> GCodes[Index];
+
+	if (!GC -> Comment && GC -> HasMotion)
+	    return GC;
+    }
+
+    return NULL;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Evaluates the tool position along the motion of the Index'th G code, at  *
+* parameter t in [0, 1].  Linear motions are evaluated directly while arcs   *
+* are constructed on first demand and kept in the G code's Crv slot.         *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   GCS:      G Code sequence to evaluate.                                   *
+*   Index:    Index of G code to evaluate its motion.                        *
+*   t:        Parameter of motion, between zero and one.                     *
+*   Pos:      Evaluated tool position is placed here.                        *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IPNCGCodeEvalMotion(IPNCGCodeStreamStruct *GCS,
+				int Index,
+				IrtRType t,
+				IrtPtType Pos)
+{
+    IPNCGCodeLineStruct
+        *GC = GCS -> GCodes[Index],
+        *PrevGC = IPNCGCodePrevMotion(GCS, Index);
+
+    if (PrevGC == NULL) {
+        IRIT_PT_COPY(Pos, GC -> XYZ);
+	return;
+    }
+
+    if (IP_NC_IS_GCODE_ARC_MOTION(GC)) {
+        if (GC -> Crv == NULL)
+	    GC -> Crv = IPNCGCodeMakeArc(GCS, PrevGC, GC);
+
+	if (GC -> Crv != NULL) {
+	    CagdRType
+	        *R = CagdCrvEval(GC -> Crv, t);
+
+	    CagdCoerceToE3(Pos, &R, -1, GC -> Crv -> PType);
+	    return;
+	}
+    }
+
+    IRIT_PT_BLEND(Pos, GC -> XYZ, PrevGC -> XYZ, t);
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Convert the given stream of G Code toolpath to IRIT geometry.	     M
@@ -1031,14 +1491,14 @@ static CagdCrvStruct *IPNCCreateArcCW(CagdPtStruct *PtStart,
 * G0 or G1.  Free-air motion (G0) is marked with attribute "freemotion".     M
 * "ToolNum", "SpindleSpeed" and "SpindleSpeed" attributes are saved on every M
 * vertex.								     M
-*   As a side effect, computes the length (Len slot) of each G Code motion,  M
-* and a curve representation (Crv slot).				     M
+*   As a side effect, computes the length (Len slot) of each G Code motion.  M
+* A curve representation (Crv slot) of arcs is only built when traversed.   M
 *                                                                            *
 * PARAMETERS:                                                                M
 *   IPNCGCodes:  Current GCodes' stream.                                     M
 *                                                                            *
 * RETURN VALUE:                                                              M
-*   IPObjectStruct *:  The toolpath in IRIT form.  			     M
+*   IPObjectStruct *:  The toolpath in IRIT form, NULL if no G codes.	     M
 *                                                                            *
 * SEE ALSO:                                                                  M
 *   IPNCGCodeParserInit, IPNCGCodeParserParseLine,			     M
@@ -1056,16 +1516,20 @@ IPObjectStruct *IPNCGCode2Geometry(VoidPtr IPNCGCodes)
 	*GCS = (IPNCGCodeStreamStruct *) IPNCGCodes;
     IPNCGCodeLineStruct
 	*LastGC = NULL;
-    IPNCGCodeLineType
-	GCodeType = GCS -> GCodes[0] -> GCodeType;
-    IPObjectStruct *PObj,
-	*PGeometry = IPGenLISTObject(NULL);
-    IPPolygonStruct *Pl2,
-	*Pl = IPAllocPolygon(0, NULL, NULL);
+    IPNCGCodeLineType GCodeType;
+    IPObjectStruct *PObj, *PGeometry;
+    IPPolygonStruct *Pl2, *Pl;
     IPVertexStruct *V;
     CagdCrvStruct
 	*LastCrv = NULL;
 
+    if (GCS -> NumOfGCodes == 0)        /* Streamed or empty - nothing kept. */
+        return NULL;
+
+    GCodeType = GCS -> GCodes[0] -> GCodeType;
+    PGeometry = IPGenLISTObject(NULL);
+    Pl = IPAllocPolygon(0, NULL, NULL);
+
     for (i = 0; i < GCS -> NumOfGCodes; i++) {
 	IPNCGCodeLineStruct
 	    *GC = GCS -> GCodes[i];
@@ -1122,47 +1586,17 @@ IPObjectStruct *IPNCGCode2Geometry(VoidPtr IPNCGCodes)
 		    IP_NC_INIT_VRTX_FROM_GC(V, Pl, LastGC);
 		}
 		IP_NC_INIT_VRTX_FROM_GC(V, Pl, GC);
-	        if (LastGC != NULL &&
-		    !IRIT_PT_APX_EQ_EPS(LastGC -> XYZ, GC -> XYZ, IRIT_UEPS)) {
-		    CagdPtStruct PtStart, PtEnd;
-
-		    IRIT_PT_COPY(PtStart.Pt, LastGC -> XYZ);
-		    IRIT_PT_COPY(PtEnd.Pt, GC -> XYZ);
-		    GC -> Crv = CagdMergePtPt(&PtStart, &PtEnd);
-		    GC -> Len = IRIT_PT_PT_DIST(GC -> XYZ, LastGC -> XYZ);
-		}
+	        if (LastGC != NULL)
+		    GC -> Len = IPNCGCodeMotionLength(GCS, LastGC, GC);
 		break;
 	    case IP_NC_GCODE_LINE_MOTION_G2CW:
 	    case IP_NC_GCODE_LINE_MOTION_G3CCW:
 	        if (LastGC != NULL) {
 		    CagdCrvStruct *Arc, *TCrv;
-		    CagdPtStruct PtStart, PtCenter, PtEnd;
-
-		    /* Create the arc, assuming it is less than 360 degrees. */
-		    IRIT_PT_COPY(PtStart.Pt, LastGC -> XYZ);
-		    IRIT_PT_COPY(PtEnd.Pt, GC -> XYZ);
-		    IRIT_PT_COPY(PtCenter.Pt, GC -> IJK);
-		    if (GCS -> ArcCentersRelative) {
-			IRIT_PT_ADD(PtCenter.Pt, PtCenter.Pt, PtStart.Pt);
-		    }
-		    PtCenter.Pt[2] = PtStart.Pt[2];
-		    if (GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G2CW)
-		        Arc = IPNCCreateArcCW(&PtStart, &PtCenter, &PtEnd);
-		    else
-		        Arc = IPNCCreateArcCCW(&PtStart, &PtCenter, &PtEnd);
-		    if (Arc != NULL) {
-			if (CAGD_IS_BSPLINE_CRV(Arc)) {
-			    BspKnotAffineTransOrder2(Arc -> KnotVector,
-						     Arc -> Order,
-						     Arc -> Order + Arc -> Length,
-						     0.0, 1.0);
-			}
-			GC -> Crv = CagdCrvCopy(Arc);
-			GC -> Len =
-			    IPNCArcComputeArcLength(PtStart.Pt, PtCenter.Pt,
-					PtEnd.Pt,
-					GC -> GCodeType == 
-					   IP_NC_GCODE_LINE_MOTION_G2CW);
+
+		    /* The arc's curve (Crv slot) is only built on demand. */
+		    if ((Arc = IPNCGCodeMakeArc(GCS, LastGC, GC)) != NULL) {
+			GC -> Len = IPNCGCodeMotionLength(GCS, LastGC, GC);
 
 			/* Hook the new arc to the accumulated curve so far. */
 			if (LastCrv == NULL)
@@ -1218,7 +1652,8 @@ IPObjectStruct *IPNCGCode2Geometry(VoidPtr IPNCGCodes)
 *   Computes the accumulated arc length of the given stream of G Code        M
 * toolpath, in cutting speed motion.					     M
 *   Assumes IPNCGCode2Geometry was invoked on this stream to compute each    M
-* G code individual arc length.						     M
+* G code individual arc length, or that the stream was parsed in streaming   M
+* mode, in which case the lengths were accumulated while parsing.	     M
 *                                                                            *
 * PARAMETERS:                                                                M
 *   IPNCGCodes:    Current GCodes' stream.                                   M
@@ -1231,7 +1666,7 @@ IPObjectStruct *IPNCGCode2Geometry(VoidPtr IPNCGCodes)
 *   IPNCGCodeParserInit, IPNCGCodeParserParseLine,			     M
 *   IPNCGCodeParserSetStep, IPNCGCodeParserGetNext,			     M
 *   IPNCGCodeBBox, IPNCGCode2Geometry, IPNCGCodeParserNumSteps,		     M
-*   IPNCGCodeParserFree							     M
+*   IPNCGCodeParserFree, IPNCGCodeParserSetStreaming			     M
 *                                                                            *
 * KEYWORDS:                                                                  M
 *   IPNCGCodeLength                                                          M
@@ -1246,6 +1681,12 @@ IrtRType IPNCGCodeLength(VoidPtr IPNCGCodes, IrtRType *FastLength)
     IPNCGCodeStreamStruct
 	*GCS = (IPNCGCodeStreamStruct *) IPNCGCodes;
 
+    if (GCS -> Streaming) {   /* Lengths were accumulated while streaming. */
+        if (FastLength != NULL)
+	    *FastLength = GCS -> StreamFastLen;
+	return GCS -> StreamLen;
+    }
+
     if (FastLength != NULL)
         *FastLength = 0.0;
 
@@ -1562,7 +2003,7 @@ IrtRType IPNCGCodeTraverseTime(VoidPtr IPNCGCodes,
     if (Dt >= 0.0) {
         do {
 	    /* Compute time left needed to completely traverse this GC. */
-	    IrtRType *R,
+	    IrtRType
 	        FeedRate =
 	            GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G0FAST ?
 			GCS -> FastSpeedUpFactor * GC -> UpdatedFeedRate :
@@ -1578,8 +2019,8 @@ IrtRType IPNCGCodeTraverseTime(VoidPtr IPNCGCodes,
 		GCS -> CrntArcLen += Dt * FeedRate;
 
 		Dt = 0.0;
-		R = CagdCrvEval(GC -> Crv, GCS -> CrntGCodeParam);
-		CagdCoerceToE3(NewToolPosition, &R, -1, GC -> Crv -> PType);
+		IPNCGCodeEvalMotion(GCS, GCS -> CrntGCodeIndex,
+				    GCS -> CrntGCodeParam, NewToolPosition);
 	    }
 	    else {	         /* For Dt time, we must go beyond this GC. */
 	        if (IPNCGCodeUpdateGCodeIndex(GCS, GCS -> CrntGCodeIndex + 1,
@@ -1603,7 +2044,7 @@ IrtRType IPNCGCodeTraverseTime(VoidPtr IPNCGCodes,
     else {			 /* Moving backward in time, negative Dt... */
         do {
 	    /* Compute time left needed to completely traverse this GC. */
-	    IrtRType *R,
+	    IrtRType
 	        FeedRate =
 	            GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G0FAST ?
 			GCS -> FastSpeedUpFactor * GC -> UpdatedFeedRate :
@@ -1620,8 +2061,8 @@ IrtRType IPNCGCodeTraverseTime(VoidPtr IPNCGCodes,
 		GCS -> CrntArcLen += Dt * FeedRate;
 
 		Dt = 0.0;
-		R = CagdCrvEval(GC -> Crv, GCS -> CrntGCodeParam);
-		CagdCoerceToE3(NewToolPosition, &R, -1, GC -> Crv -> PType);
+		IPNCGCodeEvalMotion(GCS, GCS -> CrntGCodeIndex,
+				    GCS -> CrntGCodeParam, NewToolPosition);
 	    }
 	    else {	         /* For -Dt time, we must go below this GC. */
 	        if (IPNCGCodeUpdateGCodeIndex(GCS, GCS -> CrntGCodeIndex - 1,
@@ -1715,7 +2156,7 @@ IrtRType IPNCGCodeTraverseStep(VoidPtr IPNCGCodes,
     if (Step >= 0.0) {
         do {
 	    /* Compute time left needed to completely traverse this GC. */
-	    IrtRType *R, Dt,
+	    IrtRType Dt,
 	        FeedRate =
 	            GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G0FAST ?
 		        GCS -> FastSpeedUpFactor * GC -> UpdatedFeedRate :
@@ -1732,8 +2173,8 @@ IrtRType IPNCGCodeTraverseStep(VoidPtr IPNCGCodes,
 		GCS -> CrntArcLen += Step;
 
 		Step = 0.0;
-		R = CagdCrvEval(GC -> Crv, GCS -> CrntGCodeParam);
-		CagdCoerceToE3(NewToolPosition, &R, -1, GC -> Crv -> PType);
+		IPNCGCodeEvalMotion(GCS, GCS -> CrntGCodeIndex,
+				    GCS -> CrntGCodeParam, NewToolPosition);
 	    }
 	    else {	            /* For Step, we must go beyond this GC. */
 	        if (IPNCGCodeUpdateGCodeIndex(GCS, GCS -> CrntGCodeIndex + 1,
@@ -1756,7 +2197,7 @@ IrtRType IPNCGCodeTraverseStep(VoidPtr IPNCGCodes,
     else {			 /* Moving backward in time, negative Dt... */
         do {
 	    /* Compute time left needed to completely traverse this GC. */
-	    IrtRType *R, Dt,
+	    IrtRType Dt,
 	        FeedRate =
 	            GC -> GCodeType == IP_NC_GCODE_LINE_MOTION_G0FAST ?
 			GCS -> FastSpeedUpFactor * GC -> UpdatedFeedRate :
@@ -1772,8 +2213,8 @@ IrtRType IPNCGCodeTraverseStep(VoidPtr IPNCGCodes,
 		GCS -> CrntArcLen += Step;
 
 		Step = 0.0;
-		R = CagdCrvEval(GC -> Crv, GCS -> CrntGCodeParam);
-		CagdCoerceToE3(NewToolPosition, &R, -1, GC -> Crv -> PType);
+		IPNCGCodeEvalMotion(GCS, GCS -> CrntGCodeIndex,
+				    GCS -> CrntGCodeParam, NewToolPosition);
 	    }
 	    else {	         /* For -Dt time, we must go below this GC. */
 	        if (IPNCGCodeUpdateGCodeIndex(GCS, GCS -> CrntGCodeIndex - 1,
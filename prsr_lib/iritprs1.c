@@ -385,6 +385,14 @@ int IPSenseCompressedFile(const char *FileName)
 void IPCloseStream(int Handler, int Free)
 {
     if (Handler >= 0 && Handler < IP_MAX_NUM_OF_STREAMS) {
+	if (_IPStream[Handler].WriteBufferLen > 0) {
+	    /* Send what an aborted batched socket write left behind. */
+	    _IPSocEndWriteBatch(Handler);
+	    if (!_IPStream[Handler].InUse)
+	        return;		   /* Connection was lost and closed already. */
+	}
+	_IPStream[Handler].WriteBatch = FALSE;
+
 	if (Free) {
 	    if (_IPStream[Handler].f != NULL) {
 #ifdef __UNIX__
@@ -413,6 +421,15 @@ void IPCloseStream(int Handler, int Free)
 	    }
 	}
 
+	if (_IPStream[Handler].Buffer != NULL) {
+	    IritFree(_IPStream[Handler].Buffer);
+	    _IPStream[Handler].Buffer = NULL;
+	}
+	if (_IPStream[Handler].WriteBuffer != NULL) {
+	    IritFree(_IPStream[Handler].WriteBuffer);
+	    _IPStream[Handler].WriteBuffer = NULL;
+	}
+
 	_IPStream[Handler].InUse = FALSE;
 
 	while (_IPMaxActiveStream > 0 &&
@@ -578,6 +595,10 @@ int IPOpenStreamFromSocket(int Soc, int IsBinary)
 
     if (Handler >= 0) {
 	_IPStream[Handler].Soc = Soc;
+	_IPStream[Handler].Buffer =
+	    (unsigned char *) IritMalloc(IP_SOC_BUFFER_SIZE);
+	_IPStream[Handler].WriteBuffer =
+	    (unsigned char *) IritMalloc(IP_SOC_BUFFER_SIZE);
 	_IPStream[Handler].ReadCharFunc = IPSocReadCharNonBlock;
 	_IPStream[Handler].WriteBlockFunc = IPSocWriteBlock;
 	_IPStream[Handler].Format = IP_IDAT_FILE;
@@ -611,8 +632,14 @@ static int FindFileHandler(void)
 	    _IPStream[i].TokenStackPtr = 0;
 	    _IPStream[i].LineNum = 0;
 	    _IPStream[i].UnGetChar = -1;
+	    _IPStream[i].UnGetSync = -1;
+	    _IPStream[i].InsideAttr = 0;
+	    _IPStream[i].Buffer = NULL;
 	    _IPStream[i].BufferSize = 0;
 	    _IPStream[i].BufferPtr = 0;
+	    _IPStream[i].WriteBatch = FALSE;
+	    _IPStream[i].WriteBuffer = NULL;
+	    _IPStream[i].WriteBufferLen = 0;
 	    _IPStream[i].Soc = -1;
 	    _IPStream[i].f = NULL;
 	    _IPStream[i].FileName[0] = 0;
@@ -667,19 +694,20 @@ IPObjectStruct *IPGetDataFiles(char const * const *DataFileNames,
 
     for	(i = 0; i < NumOfDataFiles; i++) {
 	if (MoreMessages)
-	    IRIT_INFO_MSG_PRINTF("Reading data file %s\n", *DataFileNames);
+	    IRIT_INFO_MSG_PRINTF("Reading data file %s\n", DataFileNames[i]);
 
-	if ((Handler = IPOpenDataFile(*DataFileNames, TRUE, Messages)) < 0)
+	/* Each file is parsed in its own stream, so a failed file does not  */
+	/* affect the parsing state of the following ones.		     */
+	if ((Handler = IPOpenDataFile(DataFileNames[i], TRUE, Messages)) < 0)
 	    continue;
 
 	PObjHead = IPAppendObjLists(IPGetObjects(Handler), PObjHead);
 
 	if (Messages && IPHasError(&ErrorMsg))
-	    IRIT_WARNING_MSG_PRINTF("File %s, %s\n", *DataFileNames, ErrorMsg);
+	    IRIT_WARNING_MSG_PRINTF("File %s, %s\n", DataFileNames[i],
+				    ErrorMsg);
 
 	IPCloseStream(Handler, TRUE);
-
-	DataFileNames++;			  /* Skip to next file name. */
     }
 
     if (PObjHead == NULL) {
@@ -15,6 +15,7 @@
 #include "prsr_loc.h"
 #include "allocate.h"
 #include "attribut.h"
+#include "geom_lib.h"
 
 #define BIN_FILE_SWAP_ENDIAN	0x40000000
 #define BIN_FILE_SYNC_STAMP	0x03160000
@@ -22,6 +23,7 @@
 #define BIN_FILE_SYNC_SIZE	0x0000ff00
 #define BIN_FILE_ALIGN		8
 #define BIN_FILE_ALIGN1		7
+#define BIN_FILE_INDEX_STAMP	0x49424449    /* Never a valid sync stamp. */
 
 typedef enum {
     IP_OBJ_REG_TYPES = 199,	/* Seperator between regular and aux types. */
@@ -48,11 +50,20 @@ typedef enum {
     IP_OBJ_AUX_MULTIVAR
 } IPObjAuxStructType;
 
-IRIT_STATIC_DATA int
-    GlblInsideAttr = FALSE,
-    GlblLastSync = -1;
+typedef struct IPIndexEntryStruct {
+    char *Name;
+    IPObjStructType ObjType;
+    long Offset;			 /* Of the object's first sync stamp. */
+    IrtBboxType BBox;
+} IPIndexEntryStruct;
 
-static void InputUnGetBinSync(int Sync);
+typedef struct IPIndexedFileStruct {
+    int Handler;
+    int NumEntries;
+    IPIndexEntryStruct *Entries;		   /* Sorted by the names. */
+} IPIndexedFileStruct;
+
+static void InputUnGetBinSync(int Handler, int Sync);
 static int InputGetBinSync(int Handler, int Abort);
 static VoidPtr InputGetBinBlock(int Handler, VoidPtr Block, int Size);
 static void OutputPutBinSync(int Handler, int Type);
@@ -86,6 +97,11 @@ static void OutputPutBinMultiVars(int Handler, MvarMVStruct *Multivar);
 static void OutputPutBinTriSrfs(int Handler, TrngTriangSrfStruct *TriSrf);
 static void OutputPutBinModels(int Handler, MdlModelStruct *Model);
 static void OutputPutBinAttributes(int Handler, const IPAttributeStruct *Attr);
+#if defined(ultrix) && defined(mips)
+static int IPIndexEntryCmp(VoidPtr E1, VoidPtr E2);
+#else
+static int IPIndexEntryCmp(const VoidPtr E1, const VoidPtr E2);
+#endif /* ultrix && mips (no const support) */
 
 /*****************************************************************************
 * DESCRIPTION:                                                               *
@@ -142,14 +158,15 @@ int _IPThisLittleEndianHardware(void)
 * Routine to unget a sync stamp from input stream.			     *
 *                                                                            *
 * PARAMETERS:                                                                *
+*   Handler:  A handler to the open stream.				     *
 *   Sync:     To unget.                                                      *
 *                                                                            *
 * RETURN VALUE:                                                              *
 *   None								     *
 *****************************************************************************/
-static void InputUnGetBinSync(int Sync)
+static void InputUnGetBinSync(int Handler, int Sync)
 {
-    GlblLastSync = Sync;
+    _IPStream[Handler].UnGetSync = Sync;
 }
 
 /*****************************************************************************
@@ -174,9 +191,9 @@ static int InputGetBinSync(int Handler, int Abort)
 	BinFileSyncStamp =
 	    BIN_FILE_SYNC_STAMP | (AlignSize(sizeof(IPPolygonStruct)) * 256);
 
-    if (GlblLastSync >= 0) {
-	l = GlblLastSync;
-	GlblLastSync = -1;
+    if (_IPStream[Handler].UnGetSync >= 0) {
+	l = _IPStream[Handler].UnGetSync;
+	_IPStream[Handler].UnGetSync = -1;
 	return l;
     }
 
@@ -343,7 +360,7 @@ IPObjectStruct *IPGetBinObject(int Handler)
 
     /* If it is not a sync for an object structure, unget it. */
     if (Sync >= IP_OBJ_REG_TYPES)
-	InputUnGetBinSync(Sync);
+	InputUnGetBinSync(Handler, Sync);
 
     PObjList = IPProcessReadObject(PObjList);
 
@@ -481,7 +498,7 @@ static IPObjectStruct *IPGetBinObjectAux(int Handler, int Sync)
 
     if (!IP_IS_OLST_OBJ(PObj) &&
 	_IPGlblProcessLeafFunc != NULL &&
-	!GlblInsideAttr)
+	_IPStream[Handler].InsideAttr == 0)
 	_IPGlblProcessLeafFunc(PObj);
 
     if (Valid)
@@ -1526,7 +1543,7 @@ static IPAttributeStruct *InputGetBinAttributes(int Handler)
 	*ATail = NULL,
 	*AHead = NULL;
 
-    GlblInsideAttr = TRUE;
+    _IPStream[Handler].InsideAttr++;
 
     while ((Sync = InputGetBinSync(Handler, TRUE)) == IP_OBJ_AUX_ATTR) {
 	char AttrName[IRIT_LINE_LEN_LONG];
@@ -1595,7 +1612,7 @@ static IPAttributeStruct *InputGetBinAttributes(int Handler)
     if (ATail != NULL)
 	ATail -> Pnext = NULL;
 
-    GlblInsideAttr = FALSE;
+    _IPStream[Handler].InsideAttr--;
 
     return AHead;
 }
@@ -2246,3 +2263,367 @@ static void OutputPutBinAttributes(int Handler, const IPAttributeStruct *Attr)
     }
     OutputPutBinSync(Handler, IP_OBJ_AUX_END);
 }
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Writes a list of objects into an indexed binary data file.  The objects    M
+* are saved in the regular binary format, followed by a directory that maps  M
+* the name of every top level object to its offset in the file, its type    M
+* and its bounding box.							     M
+*   The result is a valid binary (ibd) file that is read in full by the      M
+* regular readers, while IPOpenIndexedDataFile/IPGetIndexedObjectByName can  M
+* fetch individual objects out of it without reading the rest.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FileName:   Name of indexed binary file to create.                       M
+*   PObjList:   Linked list of objects to save.  Objects should have unique  M
+*		names to be accessible by name.				     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:        TRUE if successful, FALSE otherwise.                         M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPOpenIndexedDataFile, IPGetIndexedObjectByName, IPPutBinObject          M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPPutIndexedDataFile, files, parser, binary, index                       M
+*****************************************************************************/
+int IPPutIndexedDataFile(const char *FileName, const IPObjectStruct *PObjList)
+{
+    int i, Handler, NumEntries, Hdr[2];
+    long DirOffset;
+    IrtRType R[7];
+    const IPObjectStruct *PObj;
+    IPIndexEntryStruct *Entries;
+    FILE *f;
+
+    if ((f = fopen(FileName, IP_WRITE_BIN_MODE)) == NULL)
+        return FALSE;
+    if ((Handler = IPOpenStreamFromFile(f, FALSE, TRUE, FALSE, FALSE)) < 0) {
+        fclose(f);
+        return FALSE;
+    }
+
+    NumEntries = IPObjListLen(PObjList);
+    Entries = (IPIndexEntryStruct *)
+        IritMalloc(sizeof(IPIndexEntryStruct) * IRIT_MAX(NumEntries, 1));
+
+    for (PObj = PObjList, i = 0; PObj != NULL; PObj = PObj -> Pnext, i++) {
+        GMBBBboxStruct *BBox;
+
+	Entries[i].Name = IP_GET_OBJ_NAME(PObj);
+	Entries[i].ObjType = PObj -> ObjType;
+	Entries[i].Offset = ftell(f);
+
+	BBox = GMBBComputeBboxObject(PObj);
+	IRIT_PT_COPY(Entries[i].BBox[0], BBox -> Min);
+	IRIT_PT_COPY(Entries[i].BBox[1], BBox -> Max);
+
+	IPPutBinObject(Handler, PObj);
+    }
+
+    /* Dump the directory, prefixed by a stamp that stops sequential reads. */
+    DirOffset = ftell(f);
+    Hdr[0] = BIN_FILE_INDEX_STAMP;
+    Hdr[1] = NumEntries;
+    OutputPutBinBlock(Handler, (VoidPtr) Hdr, sizeof(int) * 2);
+    for (i = 0; i < NumEntries; i++) {
+        int Len = AlignSize(((int) strlen(Entries[i].Name)) + 1);
+
+	Hdr[0] = Entries[i].ObjType;
+	Hdr[1] = Len;
+	OutputPutBinBlock(Handler, (VoidPtr) Hdr, sizeof(int) * 2);
+	R[0] = (IrtRType) Entries[i].Offset;
+	IRIT_PT_COPY(&R[1], Entries[i].BBox[0]);
+	IRIT_PT_COPY(&R[4], Entries[i].BBox[1]);
+	OutputPutBinBlock(Handler, (VoidPtr) R, sizeof(IrtRType) * 7);
+	OutputPutBinBlock(Handler, (VoidPtr) Entries[i].Name, Len);
+    }
+
+    /* And a fixed size trailer so the directory can be found from the end. */
+    Hdr[0] = BIN_FILE_INDEX_STAMP;
+    Hdr[1] = NumEntries;
+    OutputPutBinBlock(Handler, (VoidPtr) Hdr, sizeof(int) * 2);
+    R[0] = (IrtRType) DirOffset;
+    OutputPutBinBlock(Handler, (VoidPtr) R, sizeof(IrtRType));
+
+    IritFree(Entries);
+
+    i = !ferror(f);
+    IPCloseStream(Handler, TRUE);
+
+    return i;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Opens an indexed binary data file, created by IPPutIndexedDataFile, for    M
+* random access.  Only the directory of the file is read in.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FileName:   Name of indexed binary file to open.                         M
+*   Messages:   Do we want error/warning messages?                           M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   VoidPtr:    A handle on the open indexed file or NULL if error.          M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPPutIndexedDataFile, IPGetIndexedObjectByName, IPCloseIndexedDataFile,  M
+*   IPIndexedDataFileNumObjs, IPIndexedDataFileObjInfo			     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPOpenIndexedDataFile, files, parser, binary, index                      M
+*****************************************************************************/
+VoidPtr IPOpenIndexedDataFile(const char *FileName, int Messages)
+{
+    int i, Hdr[2],
+	Swap = FALSE;
+    IrtRType R[7];
+    IPIndexedFileStruct *IdxFile;
+    FILE *f;
+
+    if ((f = fopen(FileName, IP_READ_BIN_MODE)) == NULL) {
+	if (Messages)
+	    IRIT_WARNING_MSG_PRINTF("Can't open data file %s.\n", FileName);
+	return NULL;
+    }
+
+    /* Read the trailer, and locate the directory from it. */
+    if (fseek(f, -((long) (sizeof(int) * 2 + sizeof(IrtRType))),
+	      SEEK_END) != 0 ||
+	fread(Hdr, sizeof(int), 2, f) != 2 ||
+	fread(R, sizeof(IrtRType), 1, f) != 1) {
+        Hdr[0] = 0;
+    }
+    if (Hdr[0] != BIN_FILE_INDEX_STAMP) {
+	EndianSwapInts(Hdr, 2);
+	EndianSwapReals(R, 1);
+	Swap = TRUE;
+    }
+    if (Hdr[0] != BIN_FILE_INDEX_STAMP ||
+	Hdr[1] < 0 ||
+	fseek(f, (long) R[0] + sizeof(int) * 2, SEEK_SET) != 0) {
+	if (Messages)
+	    IRIT_WARNING_MSG_PRINTF("File %s is not an indexed data file.\n",
+				    FileName);
+	fclose(f);
+	return NULL;
+    }
+
+    IdxFile = (IPIndexedFileStruct *) IritMalloc(sizeof(IPIndexedFileStruct));
+    IdxFile -> Handler = -1;
+    IdxFile -> NumEntries = Hdr[1];
+    IdxFile -> Entries = (IPIndexEntryStruct *)
+        IritMalloc(sizeof(IPIndexEntryStruct) * IRIT_MAX(Hdr[1], 1));
+
+    for (i = 0; i < IdxFile -> NumEntries; i++) {
+        IPIndexEntryStruct
+	    *Entry = &IdxFile -> Entries[i];
+
+	if (fread(Hdr, sizeof(int), 2, f) != 2 ||
+	    fread(R, sizeof(IrtRType), 7, f) != 7)
+	    break;
+	if (Swap) {
+	    EndianSwapInts(Hdr, 2);
+	    EndianSwapReals(R, 7);
+	}
+
+	Entry -> ObjType = (IPObjStructType) Hdr[0];
+	Entry -> Offset = (long) R[0];
+	IRIT_PT_COPY(Entry -> BBox[0], &R[1]);
+	IRIT_PT_COPY(Entry -> BBox[1], &R[4]);
+	Entry -> Name = (char *) IritMalloc(Hdr[1]);
+	if (fread(Entry -> Name, 1, Hdr[1], f) != (size_t) Hdr[1]) {
+	    IritFree(Entry -> Name);
+	    break;
+	}
+    }
+
+    if (i < IdxFile -> NumEntries) {
+	if (Messages)
+	    IRIT_WARNING_MSG_PRINTF("Corrupted directory in data file %s.\n",
+				    FileName);
+	IdxFile -> NumEntries = i;
+	IPCloseIndexedDataFile(IdxFile);
+	fclose(f);
+	return NULL;
+    }
+
+    qsort(IdxFile -> Entries, IdxFile -> NumEntries,
+	  sizeof(IPIndexEntryStruct), IPIndexEntryCmp);
+
+    if ((IdxFile -> Handler = IPOpenStreamFromFile(f, TRUE, TRUE,
+						   FALSE, FALSE)) < 0) {
+	if (Messages)
+	    IRIT_WARNING_MSG_PRINTF("Can't open a stream for data file %s.\n",
+				    FileName);
+	IPCloseIndexedDataFile(IdxFile);
+	fclose(f);
+	return NULL;
+    }
+    strncpy(_IPStream[IdxFile -> Handler].FileName, FileName,
+	    IRIT_LINE_LEN_VLONG);
+
+    return IdxFile;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares two directory entries by name, for qsort/bsearch.               *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   E1, E2:    Two directory entries to compare.                             *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:       Negative, zero, positive as E1's name is smaller, equal or    *
+*	       larger than E2's.					     *
+*****************************************************************************/
+#if defined(ultrix) && defined(mips)
+static int IPIndexEntryCmp(VoidPtr E1, VoidPtr E2)
+#else
+static int IPIndexEntryCmp(const VoidPtr E1, const VoidPtr E2)
+#endif /* ultrix && mips (no const support) */
+{
+    return strcmp(((IPIndexEntryStruct *) E1) -> Name,
+		  ((IPIndexEntryStruct *) E2) -> Name);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Returns the number of top level objects in an open indexed data file.      M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   IdxFile:   Handle of an indexed file, from IPOpenIndexedDataFile.        M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:       Number of objects in the directory of IdxFile.                M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPOpenIndexedDataFile, IPIndexedDataFileObjInfo                          M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPIndexedDataFileNumObjs, files, parser, binary, index                   M
+*****************************************************************************/
+int IPIndexedDataFileNumObjs(VoidPtr IdxFile)
+{
+    return ((IPIndexedFileStruct *) IdxFile) -> NumEntries;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Queries the directory of an open indexed data file, without reading the   M
+* object itself.  Entries are sorted by their names.			     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   IdxFile:   Handle of an indexed file, from IPOpenIndexedDataFile.        M
+*   Index:     Of directory entry to query, between zero and		     M
+*	       IPIndexedDataFileNumObjs(IdxFile) - 1.			     M
+*   ObjType:   Type of the object is placed here, if not NULL.               M
+*   BBox:      Bounding box of the object is placed here, if not NULL.       M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   const char *:  Name of the object, or NULL if Index is out of range.     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPOpenIndexedDataFile, IPIndexedDataFileNumObjs,			     M
+*   IPGetIndexedObjectByName						     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPIndexedDataFileObjInfo, files, parser, binary, index                   M
+*****************************************************************************/
+const char *IPIndexedDataFileObjInfo(VoidPtr IdxFile,
+				     int Index,
+				     IPObjStructType *ObjType,
+				     IrtBboxType BBox)
+{
+    IPIndexedFileStruct
+	*IFile = (IPIndexedFileStruct *) IdxFile;
+    IPIndexEntryStruct *Entry;
+
+    if (Index < 0 || Index >= IFile -> NumEntries)
+        return NULL;
+    Entry = &IFile -> Entries[Index];
+
+    if (ObjType != NULL)
+        *ObjType = Entry -> ObjType;
+    if (BBox != NULL) {
+	IRIT_PT_COPY(BBox[0], Entry -> BBox[0]);
+	IRIT_PT_COPY(BBox[1], Entry -> BBox[1]);
+    }
+
+    return Entry -> Name;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Reads one named top level object out of an open indexed data file.  Only   M
+* the data of the requested object is read from the file.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   IdxFile:   Handle of an indexed file, from IPOpenIndexedDataFile.        M
+*   Name:      Name of the top level object to fetch.                        M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IPObjectStruct *:  A newly read object, or NULL if no such object or     M
+*		       error.  Caller must free the returned object.	     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPOpenIndexedDataFile, IPPutIndexedDataFile, IPGetObjectByName           M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPGetIndexedObjectByName, files, parser, binary, index                   M
+*****************************************************************************/
+IPObjectStruct *IPGetIndexedObjectByName(VoidPtr IdxFile, const char *Name)
+{
+    int OldReadOne;
+    IPIndexedFileStruct
+	*IFile = (IPIndexedFileStruct *) IdxFile;
+    IPIndexEntryStruct Key, *Entry;
+    IPObjectStruct *PObj;
+
+    Key.Name = (char *) Name;
+    if ((Entry = (IPIndexEntryStruct *)
+		bsearch(&Key, IFile -> Entries, IFile -> NumEntries,
+			sizeof(IPIndexEntryStruct), IPIndexEntryCmp)) == NULL ||
+	fseek(_IPStream[IFile -> Handler].f, Entry -> Offset, SEEK_SET) != 0)
+        return NULL;
+
+    _IPStream[IFile -> Handler].UnGetSync = -1;
+    OldReadOne = IPSetReadOneObject(TRUE);
+    PObj = IPGetObjects(IFile -> Handler);
+    IPSetReadOneObject(OldReadOne);
+
+    return PObj;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Closes an indexed data file opened by IPOpenIndexedDataFile.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   IdxFile:   Handle of an indexed file to close and free.                  M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPOpenIndexedDataFile                                                    M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IPCloseIndexedDataFile, files, parser, binary, index                     M
+*****************************************************************************/
+void IPCloseIndexedDataFile(VoidPtr IdxFile)
+{
+    int i;
+    IPIndexedFileStruct
+	*IFile = (IPIndexedFileStruct *) IdxFile;
+
+    for (i = 0; i < IFile -> NumEntries; i++)
+        IritFree(IFile -> Entries[i].Name);
+    IritFree(IFile -> Entries);
+
+    if (IFile -> Handler >= 0)
+        IPCloseStream(IFile -> Handler, TRUE);
+
+    IritFree(IFile);
+}
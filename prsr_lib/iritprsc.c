@@ -26,7 +26,8 @@
 
 /* Minimum buffer, used in Test mode. */
 #define IPC_TEST_BUFF_SIZE              IPC_INPUT_BUFFER_LEN
-#define IPC_TEST_COMP_SIZE              (int)(IPC_INPUT_BUFFER_LEN * 1.1)
+#define IPC_TEST_COMP_SIZE              (IPC_INPUT_BUFFER_LEN + \
+					 IPC_INPUT_BUFFER_LEN / 10)
 #define IPC_TEST_PREDICTOR_FAVOR(x)     (x = (long)((double)x * 0.9))
 #define IPC_BUFF_SIZE                   100*1024
 
@@ -109,6 +110,7 @@ static void IpcCompressObjAux1(IpcFile *f,
 static int IpcCompressObj2(IpcFile *f, 
                               IPObjectStruct *PObj, 
                               float QntError);
+static long IpcFileLength(const char *FileName);
 static IrtBType IpcSetArgumentsObj(IpcFile *f, 
 				   IPObjectStruct *PObj, 
 				   IrtBType ObjMap, 
@@ -363,6 +365,150 @@ int IpcCompressObj(int Handler, IPObjectStruct *PObj)
     return Code;
 }
 
+/******************************************************************************
+* DESCRIPTION:                                                                M
+*  Compress a forest of IPObjects to a file, as independent chunks.           M
+*  Every top level object is saved as a separate, self contained compressed   M
+*  stream, and an index of the chunks' names and offsets trails the file.     M
+*  A single object can then be decompressed with IpcDecompressObjChunkByName  M
+*  without decompressing the rest of the file.				      M
+*                                                                             *
+* PARAMETERS:                                                                 M
+*   FileName:   Name of a compression file to save in.                        M
+*   PObjs:      Irit format objects' linked list, or a list object whose      M
+*               elements are compressed as the chunks.			      M
+*   QntError:   Quantization step between(0..1). 			      M
+*               Specifies maximum error for values.    		              M
+*               IPC_QUANTIZATION_NONE - no quanization is used.		      M
+*                                                                             *
+* RETURN VALUE:                                                               M
+*   int:        Internal Error code.                                          M
+*                                                                             *
+* SEE ALSO:                                                                   M
+*   IpcCompressObjToFile, IpcDecompressObjChunkByName,			      M
+*   IpcDecompressObjChunksFromFile					      M
+*                                                                             *
+* KEYWORDS:                                                                   M
+*   IpcCompressObjChunksToFile, files, parser, compress, chunks, index.       M
+******************************************************************************/
+int IpcCompressObjChunksToFile(const char *FileName,
+			       IPObjectStruct *PObjs,
+			       float QntError)
+{
+    int i, Len, NumChunks, Hdr[2],
+	Code = 0;
+    long *Offsets;
+    IrtRType R;
+    IPObjectStruct *PObj, **Chunks;
+    IpcFile *f;
+    FILE *Idx;
+
+    /* Truncate the file, as all chunks are appended to it. */
+    if ((Idx = fopen(FileName, IP_WRITE_BIN_MODE)) == NULL)
+        return IPC_ERROR_OPEN_FILE;
+    fclose(Idx);
+
+    /* Collect the top level objects, each to become one chunk. */
+    if (IP_IS_OLST_OBJ(PObjs) && PObjs -> Pnext == NULL) {
+        NumChunks = IPListObjectLength(PObjs);
+	Chunks = (IPObjectStruct **)
+	    IritMalloc(sizeof(IPObjectStruct *) * IRIT_MAX(NumChunks, 1));
+	for (i = 0; i < NumChunks; i++)
+	    Chunks[i] = IPListObjectGet(PObjs, i);
+    }
+    else {
+        NumChunks = IPObjListLen(PObjs);
+	Chunks = (IPObjectStruct **)
+	    IritMalloc(sizeof(IPObjectStruct *) * IRIT_MAX(NumChunks, 1));
+	for (PObj = PObjs, i = 0; PObj != NULL; PObj = PObj -> Pnext)
+	    Chunks[i++] = PObj;
+    }
+    Offsets = (long *) IritMalloc(sizeof(long) * IRIT_MAX(NumChunks, 1));
+
+    for (i = 0; i < NumChunks && Code == 0; i++) {
+        IPObjectStruct
+	    *PNext = Chunks[i] -> Pnext;
+
+	/* Each chunk is a complete compressed stream (a gzip member). */
+	Offsets[i] = IpcFileLength(FileName);
+	if ((f = (IpcFile *) _IPC_OPEN_FILE(FileName, "ab")) == NULL) {
+	    Code = IPC_ERROR_OPEN_FILE;
+	    break;
+	}
+
+	Chunks[i] -> Pnext = NULL;
+	Code = IpcCompressObj2(f, Chunks[i], QntError);
+	Chunks[i] -> Pnext = PNext;
+
+	_IPC_CLOSE_FILE(f);
+    }
+
+    /* Append the chunks' index, uncompressed, with a fixed size trailer. */
+    if (Code == 0) {
+        R = (IrtRType) IpcFileLength(FileName);
+
+	if ((Idx = fopen(FileName, "ab")) == NULL)
+	    Code = IPC_ERROR_OPEN_FILE;
+    }
+    if (Code == 0) {
+	Hdr[0] = IPC_CHUNK_INDEX_STAMP;
+	Hdr[1] = NumChunks;
+	fwrite(Hdr, sizeof(int), 2, Idx);
+	for (i = 0; i < NumChunks; i++) {
+	    IrtRType
+		Offset = (IrtRType) Offsets[i];
+	    const char
+	        *Name = IP_GET_OBJ_NAME(Chunks[i]);
+
+	    Len = (int) strlen(Name);
+	    Hdr[0] = Chunks[i] -> ObjType;
+	    Hdr[1] = IPC_CHUNK_ALIGN(Len + 1);
+	    fwrite(Hdr, sizeof(int), 2, Idx);
+	    fwrite(&Offset, sizeof(IrtRType), 1, Idx);
+	    fwrite(Name, 1, Len, Idx);
+	    for ( ; Len < Hdr[1]; Len++)
+	        fputc(0, Idx);
+	}
+	Hdr[0] = IPC_CHUNK_INDEX_STAMP;
+	Hdr[1] = NumChunks;
+	fwrite(Hdr, sizeof(int), 2, Idx);
+	fwrite(&R, sizeof(IrtRType), 1, Idx);
+
+	if (ferror(Idx))
+	    Code = IPC_ERROR_GENERAL;
+	fclose(Idx);
+    }
+
+    IritFree(Chunks);
+    IritFree(Offsets);
+
+    return Code;
+}
+
+/******************************************************************************
+* DESCRIPTION:                                                                *
+*  Returns the current length of a file, in bytes.                            *
+*                                                                             *
+* PARAMETERS:                                                                 *
+*   FileName:   Name of the file to examine.                                  *
+*                                                                             *
+* RETURN VALUE:                                                               *
+*   long:       Length of the file, zero if cannot be opened.                 *
+******************************************************************************/
+static long IpcFileLength(const char *FileName)
+{
+    long Len = 0;
+    FILE *f;
+
+    if ((f = fopen(FileName, IP_READ_BIN_MODE)) != NULL) {
+        if (fseek(f, 0, SEEK_END) == 0)
+	    Len = ftell(f);
+	fclose(f);
+    }
+
+    return Len;
+}
+
 /******************************************************************************
 * DESCRIPTION:                                                                *
 *  Compress a given IPObject to a file.                                       *
@@ -15,12 +15,26 @@
 
 #ifdef IPC_BIN_COMPRESSION
 
+#include <fcntl.h>
 #ifdef __WINNT__
 #include <io.h> 
 #endif /* __WINNT__ */
+#ifdef __UNIX__
+#include <unistd.h>
+#endif /* __UNIX__ */
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif /* O_BINARY */
 
 #define IPC_STRING_LEN 256 
 
+typedef struct IpcChunkStruct {
+    char *Name;
+    IPObjStructType ObjType;
+    long Offset;			/* Of the chunk's compressed stream. */
+} IpcChunkStruct;
+
 extern CagdRType _IpcAnglesCos[IPC_ANGLES_SET_AUX][IPC_ANGLES_MAX];
 extern int _IpcAnglesNum[IPC_ANGLES_SET_AUX];
 
@@ -55,6 +69,12 @@ static void IpcUpdateNormal(IrtVecType Normal);
 static IPObjectStruct* IpcDecompressObj2(IpcFile *f, IpcArgs *Args);
 static IPObjectStruct* IpcDecompressObjFromFileAux(const char *FileName,
                                                    IpcArgs *PArgs);
+static IpcChunkStruct *IpcReadChunksIndex(const char *FileName,
+					  int *NumChunks);
+static void IpcFreeChunksIndex(IpcChunkStruct *Chunks, int NumChunks);
+static IPObjectStruct *IpcDecompressChunk(const char *FileName,
+					  long Offset,
+					  IpcArgs *Args);
 static int  IpcDecompressContinue(IpcFile *f, IpcArgs *Args); 
 static void EndianSwapBuffer(void *Data,
                              long TypeSize,
@@ -245,15 +265,258 @@ IPObjectStruct *IpcDecompressObjFromFile(const char *FileName)
 ******************************************************************************/
 IPObjectStruct *IpcDecompressObj(int Handler)
 {
+    int NumChunks;
     IpcArgs Args;
     IPObjectStruct* PObjs;
-    
-    PObjs = IpcDecompressObjFromFileAux(_IPStream[Handler].FileName, &Args);
-    _IPStream[Handler].QntError = Args.QntError;
+    IpcChunkStruct
+        *Chunks = IpcReadChunksIndex(_IPStream[Handler].FileName, &NumChunks);
+
+    if (Chunks != NULL) {
+        /* A chunked file - read all of its chunks. */
+        IpcFreeChunksIndex(Chunks, NumChunks);
+	PObjs = IpcDecompressObjChunksFromFile(_IPStream[Handler].FileName);
+    }
+    else {
+        PObjs = IpcDecompressObjFromFileAux(_IPStream[Handler].FileName,
+					    &Args);
+	_IPStream[Handler].QntError = Args.QntError;
+    }
+
+    return PObjs;
+}
+
+/******************************************************************************
+* DESCRIPTION:                                                                M
+*  Decompress all the chunks of a chunked compressed file, as created by      M
+*  IpcCompressObjChunksToFile, in their original order.		      M
+*                                                                             *
+* PARAMETERS:                                                                 M
+*   FileName:   A chunked compression file to load from.                      M
+*                                                                             *
+* RETURN VALUE:                                                               M
+*   IPObjectStruct *: A linked list of the Irit objects, or NULL if error.    M
+*                                                                             *
+* SEE ALSO:                                                                   M
+*   IpcCompressObjChunksToFile, IpcDecompressObjChunkByName.                  M
+*                                                                             *
+* KEYWORDS:                                                                   M
+*   IpcDecompressObjChunksFromFile, files, parser, uncompress, chunks         M
+******************************************************************************/
+IPObjectStruct *IpcDecompressObjChunksFromFile(const char *FileName)
+{
+    int i, NumChunks;
+    IpcArgs Args;
+    IPObjectStruct *PObj,
+	*PObjs = NULL,
+	*PTail = NULL;
+    IpcChunkStruct
+        *Chunks = IpcReadChunksIndex(FileName, &NumChunks);
+
+    if (Chunks == NULL)
+        return NULL;
+
+    for (i = 0; i < NumChunks; i++) {
+        if ((PObj = IpcDecompressChunk(FileName, Chunks[i].Offset,
+				       &Args)) == NULL)
+	    break;
+
+	if (PTail == NULL)
+	    PObjs = PTail = PObj;
+	else
+	    PTail -> Pnext = PObj;
+	PTail = IPGetLastObj(PObj);
+    }
+
+    IpcFreeChunksIndex(Chunks, NumChunks);
 
     return PObjs;
 }
 
+/******************************************************************************
+* DESCRIPTION:                                                                M
+*  Decompress one named top level object out of a chunked compressed file,    M
+*  as created by IpcCompressObjChunksToFile.  Only the chunk of the object    M
+*  is decompressed.							      M
+*                                                                             *
+* PARAMETERS:                                                                 M
+*   FileName:   A chunked compression file to load from.                      M
+*   Name:       Name of the top level object to decompress.                   M
+*                                                                             *
+* RETURN VALUE:                                                               M
+*   IPObjectStruct *: The decompressed object, or NULL if not found/error.    M
+*                                                                             *
+* SEE ALSO:                                                                   M
+*   IpcCompressObjChunksToFile, IpcDecompressObjChunksFromFile.               M
+*                                                                             *
+* KEYWORDS:                                                                   M
+*   IpcDecompressObjChunkByName, files, parser, uncompress, chunks            M
+******************************************************************************/
+IPObjectStruct *IpcDecompressObjChunkByName(const char *FileName,
+					    const char *Name)
+{
+    int i, NumChunks;
+    IpcArgs Args;
+    IPObjectStruct
+	*PObj = NULL;
+    IpcChunkStruct
+        *Chunks = IpcReadChunksIndex(FileName, &NumChunks);
+
+    if (Chunks == NULL)
+        return NULL;
+
+    for (i = 0; i < NumChunks; i++) {
+        if (strcmp(Chunks[i].Name, Name) == 0) {
+	    PObj = IpcDecompressChunk(FileName, Chunks[i].Offset, &Args);
+	    break;
+	}
+    }
+
+    IpcFreeChunksIndex(Chunks, NumChunks);
+
+    return PObj;
+}
+
+/******************************************************************************
+* DESCRIPTION:                                                                *
+*  Reads the trailing chunks' index of a chunked compressed file.             *
+*                                                                             *
+* PARAMETERS:                                                                 *
+*   FileName:   A compression file to read the index of.                      *
+*   NumChunks:  Number of chunks in the returned index.                       *
+*                                                                             *
+* RETURN VALUE:                                                               *
+*   IpcChunkStruct *: The index, or NULL if FileName is not chunked.          *
+******************************************************************************/
+static IpcChunkStruct *IpcReadChunksIndex(const char *FileName,
+					  int *NumChunks)
+{
+    int i, Hdr[2],
+	Swap = FALSE;
+    IrtRType R;
+    IpcChunkStruct *Chunks;
+    FILE *f;
+
+    if ((f = fopen(FileName, IP_READ_BIN_MODE)) == NULL)
+        return NULL;
+
+    if (fseek(f, -((long) (sizeof(int) * 2 + sizeof(IrtRType))),
+	      SEEK_END) != 0 ||
+	fread(Hdr, sizeof(int), 2, f) != 2 ||
+	fread(&R, sizeof(IrtRType), 1, f) != 1)
+        Hdr[0] = 0;
+    if (Hdr[0] != IPC_CHUNK_INDEX_STAMP) {
+        EndianSwapBuffer(Hdr, sizeof(int), 2, NULL);
+        EndianSwapBuffer(&R, sizeof(IrtRType), 1, NULL);
+	Swap = TRUE;
+    }
+    if (Hdr[0] != IPC_CHUNK_INDEX_STAMP ||
+	Hdr[1] < 0 ||
+	fseek(f, (long) R + sizeof(int) * 2, SEEK_SET) != 0) {
+        fclose(f);
+	return NULL;
+    }
+
+    *NumChunks = Hdr[1];
+    Chunks = (IpcChunkStruct *)
+        IritMalloc(sizeof(IpcChunkStruct) * IRIT_MAX(*NumChunks, 1));
+
+    for (i = 0; i < *NumChunks; i++) {
+        if (fread(Hdr, sizeof(int), 2, f) != 2 ||
+	    fread(&R, sizeof(IrtRType), 1, f) != 1)
+	    break;
+	if (Swap) {
+	    EndianSwapBuffer(Hdr, sizeof(int), 2, NULL);
+	    EndianSwapBuffer(&R, sizeof(IrtRType), 1, NULL);
+	}
+
+	Chunks[i].ObjType = (IPObjStructType) Hdr[0];
+	Chunks[i].Offset = (long) R;
+	Chunks[i].Name = (char *) IritMalloc(Hdr[1]);
+	if (fread(Chunks[i].Name, 1, Hdr[1], f) != (size_t) Hdr[1]) {
+	    IritFree(Chunks[i].Name);
+	    break;
+	}
+    }
+
+    fclose(f);
+
+    if (i < *NumChunks) {
+        IRIT_WARNING_MSG_PRINTF("Chunks index of file %s is corrupted.\n",
+				FileName);
+	IpcFreeChunksIndex(Chunks, i);
+	return NULL;
+    }
+
+    return Chunks;
+}
+
+/******************************************************************************
+* DESCRIPTION:                                                                *
+*  Frees an index of chunks read by IpcReadChunksIndex.                       *
+*                                                                             *
+* PARAMETERS:                                                                 *
+*   Chunks:     The index to free.                                            *
+*   NumChunks:  Number of chunks in the index.                                *
+*                                                                             *
+* RETURN VALUE:                                                               *
+*   void                                                                      *
+******************************************************************************/
+static void IpcFreeChunksIndex(IpcChunkStruct *Chunks, int NumChunks)
+{
+    int i;
+
+    for (i = 0; i < NumChunks; i++)
+        IritFree(Chunks[i].Name);
+    IritFree(Chunks);
+}
+
+/******************************************************************************
+* DESCRIPTION:                                                                *
+*  Decompress one chunk of a chunked compressed file.  The chunk is a         *
+*  complete compressed stream starting at Offset bytes into the file.         *
+*                                                                             *
+* PARAMETERS:                                                                 *
+*   FileName:   A chunked compression file to load from.                      *
+*   Offset:     Of the chunk in the file, in bytes.                           *
+*   Args:       Compression arguments of the chunk are placed here.           *
+*                                                                             *
+* RETURN VALUE:                                                               *
+*   IPObjectStruct *: The decompressed object, or NULL if error.              *
+******************************************************************************/
+static IPObjectStruct *IpcDecompressChunk(const char *FileName,
+					  long Offset,
+					  IpcArgs *Args)
+{
+    IPObjectStruct *PObj;
+    IpcFile *f;
+
+#if defined(IRIT_HAVE_GZIP_LIB) && !defined(IPC_WRITE_WITHOUT_COMPRESSION)
+    int fd;
+
+    /* Open the gzip member of the chunk directly, at its offset. */
+    if ((fd = open(FileName, O_RDONLY | O_BINARY)) < 0)
+        return NULL;
+    if (lseek(fd, Offset, SEEK_SET) != Offset ||
+	(f = (IpcFile *) gzdopen(fd, IP_READ_BIN_MODE)) == NULL) {
+        close(fd);
+	return NULL;
+    }
+#else
+    if ((f = _IPC_OPEN_FILE(FileName, IP_READ_BIN_MODE)) == NULL)
+        return NULL;
+    if (fseek(f, Offset, SEEK_SET) != 0) {
+        _IPC_CLOSE_FILE(f);
+	return NULL;
+    }
+#endif /* IRIT_HAVE_GZIP_LIB && !IPC_WRITE_WITHOUT_COMPRESSION */
+
+    /* On failure, the file is closed by IpcDecompressObj2. */
+    if ((PObj = IpcDecompressObj2(f, Args)) != NULL)
+        _IPC_CLOSE_FILE(f);
+
+    return PObj;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 * Auxiliary function to function IpcDecompressObjFromFile		     *
@@ -303,6 +566,9 @@ static IPObjectStruct *IpcDecompressObj2(IpcFile *f, IpcArgs *Args)
     } 
      _IPLongJumpActive = TRUE;
 
+    /* Start a new stream with an empty decompression buffer. */
+    IpcDecompress(f, NULL, 0, 0, Args);
+
     /* Read header of a compressed file and compression arguments. */ 
     IpcReadHeader(f, Args);
 
@@ -496,6 +762,12 @@ static void IpcDecompress(IpcFile *f,
     long 
         DataLen = TypeSize * Count;
 
+    /* Reset the buffer, at the beginning of a new stream. */
+    if (Data == NULL) {
+        Size = DestSize = 0;
+        return;
+    }
+
     for (j = 0; j < DataLen; j++) { 
         if (Size == DestSize) {  
             IpcDecompressAux(f, Buffer, &DestSize, Args); 
@@ -519,7 +791,7 @@ static void IpcDecompressAux(IpcFile *f,
                              IpcArgs *Args)
 { 
     /* Read block length. */ 
-    if (_IPC_READ(f, DestSize, sizeof(int)) <= 0) { 
+    if (_IPC_READ(f, DestSize, sizeof(long)) <= 0) { 
         DestBuffer = NULL; 
         *DestSize = 0; 
     }
@@ -53,6 +53,9 @@ IPSetErrorFuncType IPSetFatalErrorFunc(IPSetErrorFuncType ErrorFunc)
 *****************************************************************************/
 void IPFatalError(IPFatalErrorType ErrID)
 {
+    /* The error function may longjmp out of a batched socket write. */
+    _IPSocEndWriteBatch(IP_CLNT_BROADCAST_ALL_HANDLES);
+
     if (IPGlblPrsrSetErrorFunc != NULL) {
         IPGlblPrsrSetErrorFunc(ErrID);
 	return;
@@ -258,6 +258,7 @@ typedef enum {
 #define IP_SOC_TIME_OUT		1000		  /* In 10th of miliseconds. */
 #define IP_SOC_IRIT_DEF_PORT	5050		/* Default listening socket. */
 #define IP_MAX_NUM_OF_STREAMS	50
+#define IP_SOC_BUFFER_SIZE	16384  /* Socket read/write buffering size. */
 
 typedef enum {
     IP_MDL_NO_CRV = 0,
@@ -279,6 +280,8 @@ typedef struct IPStreamInfoStruct {
     IPFileType FileType;
     float QntError;
     int SwapEndian;
+    int UnGetSync;		    /* Binary sync stamp pushed back, or -1. */
+    int InsideAttr;	     /* Depth of binary attribute objects reading. */
     int TokenStackPtr;
     char TokenStack[UNGET_STACK_SIZE][IRIT_LINE_LEN];
     int UnGetChar;
@@ -286,7 +289,10 @@ typedef struct IPStreamInfoStruct {
     int Read;
     int BufferSize;
     int BufferPtr;
-    unsigned char Buffer[IRIT_LINE_LEN_VLONG];
+    unsigned char *Buffer;     /* Socket streams only, IP_SOC_BUFFER_SIZE. */
+    int WriteBatch;	     /* TRUE to batch socket writes in WriteBuffer. */
+    int WriteBufferLen;
+    unsigned char *WriteBuffer;/* Socket streams only, IP_SOC_BUFFER_SIZE. */
 } IPStreamInfoStruct;
 
 IRIT_GLOBAL_DATA_HEADER IPStreamInfoStruct
@@ -324,6 +330,8 @@ void _IPFprintf(int Handler, int Indent, char *va_alist, ...);
 void _IPFprintf(int Handler, int Indent, char *Format, ...);
 #endif /* USE_VARARGS */
 
+void _IPSocEndWriteBatch(int Handler);
+
 /* Error handling. */
 #define IP_FATAL_ERROR_EX(MsgID, ErrLine, ErrDesc) \
 				_IPFatalErrorEx(MsgID, ErrLine, ErrDesc)
@@ -60,6 +60,9 @@
 static void IPSocUnblockSocket(int s);
 static void IPSocUnReadChar(int Handler, char c);
 static int IPSocReadObjPrefix(int Handler);
+static int IPSocSendBlock(int Handler, unsigned char *Line, int BlockLen);
+static int IPSocBatchBlock(int Handler, unsigned char *Line, int BlockLen);
+static int IPSocFlushBlock(int Handler);
 
 IRIT_STATIC_DATA int
     GlblAcceptedConnection = -1,
@@ -450,12 +453,18 @@ void IPSocWriteOneObject(int Handler, IPObjectStruct *PObj)
 	IPStderrObject(PObj);
 #   endif /* IP_SOC_DEBUG */
 
+    /* The object is dumped in many small blocks, so batch them into      */
+    /* IP_SOC_BUFFER_SIZE sized sends instead of a send per block.         */
     if (Handler == IP_CLNT_BROADCAST_ALL_HANDLES) {
 	int h;
 
-	for (h = 0; h < _IPMaxActiveStream; h++)
-	    if (_IPStream[h].InUse && _IPStream[h].Soc >= 0)
+	for (h = 0; h < _IPMaxActiveStream; h++) {
+	    if (_IPStream[h].InUse && _IPStream[h].Soc >= 0) {
+	        _IPStream[h].WriteBatch = TRUE;
 	        IPPutObjectToHandler(h, PObj);
+		_IPSocEndWriteBatch(h);
+	    }
+	}
     }
     else if (Handler >= 0 && Handler < IP_MAX_NUM_OF_STREAMS) {
 	if (!_IPStream[Handler].InUse || _IPStream[Handler].Soc < 0) {
@@ -463,7 +472,9 @@ void IPSocWriteOneObject(int Handler, IPObjectStruct *PObj)
 	    return;
 	}
 
+	_IPStream[Handler].WriteBatch = TRUE;
 	IPPutObjectToHandler(Handler, PObj);
+	_IPSocEndWriteBatch(Handler);
 
 	if (IPHasError(&ErrorMsg)) {
 	    IRIT_WARNING_MSG_PRINTF("Socket: %s\n", ErrorMsg);
@@ -493,12 +504,14 @@ void IPSocWriteOneObject(int Handler, IPObjectStruct *PObj)
 *****************************************************************************/
 int IPSocWriteBlock(int Handler, void *Block, int BlockLen)
 {
-    int i, h;
+    int h;
     unsigned char
         *Line = (unsigned char *) Block;
 
 #   ifdef DEBUG
     {
+        int i;
+
         IRIT_SET_IF_DEBUG_ON_PARAMETER(_DebugIPSocDebugRW, FALSE) {
 	    IRIT_INFO_MSG("IPSocWriteBlock: \"");
 	    for (i = 0; i < BlockLen; i++)
@@ -511,27 +524,10 @@ int IPSocWriteBlock(int Handler, void *Block, int BlockLen)
     if (Handler == IP_CLNT_BROADCAST_ALL_HANDLES) {
 	for (h = 0; h < _IPMaxActiveStream; h++) {
 	    if (_IPStream[h].InUse && _IPStream[h].Soc >= 0) {
-	        while ((i = send(_IPStream[h].Soc, Line,
-				 BlockLen, 0)) < BlockLen) {
-		    if (i < 0) {	        /* Lost connection probably. */
-			/* If buffer full do not close stream. */
-#			if defined(__WINNT__) || defined(__WINCE__)
-			if (WSAGetLastError() != WSAEWOULDBLOCK)
-#			endif /* __WINNT__ || __WINCE__ */
-#			ifdef __UNIX__
-		        if (errno != EAGAIN)
-#			endif /* __UNIX__ */
-			{
-			    IPCloseStream(h, TRUE);
-			    return FALSE;
-			}
-		    }
-		    else if (i > 0) {
-		        BlockLen -= i;
-			Line = &Line[i];
-		    }
-		    IritSleep(1);
-		}
+	        if (!(_IPStream[h].WriteBatch ?
+		          IPSocBatchBlock(h, Line, BlockLen) :
+		          IPSocSendBlock(h, Line, BlockLen)))
+		    return FALSE;
 	    }
 	}
 	return TRUE;
@@ -542,28 +538,9 @@ int IPSocWriteBlock(int Handler, void *Block, int BlockLen)
 	    return FALSE;
 	}
 
-	while ((i = send(_IPStream[Handler].Soc,
-			 Line, BlockLen, 0)) < BlockLen) {
-	    if (i < 0) {		       /* Lost connection probably. */
-		/* If buffer full do not close stream. */
-#		if defined(__WINNT__) || defined(__WINCE__)
-		if (WSAGetLastError() != WSAEWOULDBLOCK) {
-#		endif /* __WINNT__ || __WINCE__ */
-#		ifdef __UNIX__
-	        if (errno != EAGAIN) {
-#		endif /* __UNIX__ */
-		    IPCloseStream(Handler, TRUE);
-		    return FALSE;
-		}
-	    }
-	    else if (i > 0) {
-	        BlockLen -= i;
-		Line = &Line[i];
-	    }
-	    IritSleep(1);
-	}
-
-	return TRUE;
+	return _IPStream[Handler].WriteBatch ?
+			      IPSocBatchBlock(Handler, Line, BlockLen) :
+			      IPSocSendBlock(Handler, Line, BlockLen);
     }
     else {
 	IP_FATAL_ERROR(IP_ERR_INVALID_STREAM_HNDL);
@@ -571,6 +548,134 @@ int IPSocWriteBlock(int Handler, void *Block, int BlockLen)
     }
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+* Sends a single block of BlockLen bytes, retrying while the socket buffer   *
+* is full.  Closes the stream if the connection is lost.		     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:    The socket info handler.			             *
+*   Line:       Block to send.                                               *
+*   BlockLen:   Length of block to send.                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:	TRUE if send succesful, FALSE otherwise.                     *
+*****************************************************************************/
+static int IPSocSendBlock(int Handler, unsigned char *Line, int BlockLen)
+{
+    int i;
+
+    while ((i = send(_IPStream[Handler].Soc,
+		     Line, BlockLen, 0)) < BlockLen) {
+        if (i < 0) {		       /* Lost connection probably. */
+	    /* If buffer full do not close stream. */
+#	    if defined(__WINNT__) || defined(__WINCE__)
+	    if (WSAGetLastError() != WSAEWOULDBLOCK) {
+#	    endif /* __WINNT__ || __WINCE__ */
+#	    ifdef __UNIX__
+	    if (errno != EAGAIN) {
+#	    endif /* __UNIX__ */
+	        _IPStream[Handler].WriteBufferLen = 0;
+	        IPCloseStream(Handler, TRUE);
+		return FALSE;
+	    }
+	}
+	else if (i > 0) {
+	    BlockLen -= i;
+	    Line = &Line[i];
+	}
+	IritSleep(1);
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+* Appends a single block of BlockLen bytes to the write buffer of Handler,   *
+* sending the buffer whenever it fills up.				     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:    The socket info handler.			             *
+*   Line:       Block to write.                                              *
+*   BlockLen:   Length of block to write.                                    *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:	TRUE if write succesful, FALSE otherwise.                    *
+*****************************************************************************/
+static int IPSocBatchBlock(int Handler, unsigned char *Line, int BlockLen)
+{
+    IPStreamInfoStruct
+        *Strm = &_IPStream[Handler];
+
+    if (Strm -> WriteBufferLen + BlockLen > IP_SOC_BUFFER_SIZE &&
+	!IPSocFlushBlock(Handler))
+        return FALSE;
+
+    if (BlockLen >= IP_SOC_BUFFER_SIZE)      /* Too large to batch anyway. */
+        return IPSocSendBlock(Handler, Line, BlockLen);
+
+    IRIT_GEN_COPY(&Strm -> WriteBuffer[Strm -> WriteBufferLen],
+		  Line, BlockLen);
+    Strm -> WriteBufferLen += BlockLen;
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+* Sends all batched data in the write buffer of Handler, if any.	     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Handler:    The socket info handler.			             *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:	TRUE if send succesful, FALSE otherwise.                     *
+*****************************************************************************/
+static int IPSocFlushBlock(int Handler)
+{
+    int Len = _IPStream[Handler].WriteBufferLen;
+
+    if (Len == 0 || !_IPStream[Handler].InUse || _IPStream[Handler].Soc < 0)
+        return TRUE;
+
+    _IPStream[Handler].WriteBufferLen = 0;
+
+    return IPSocSendBlock(Handler, _IPStream[Handler].WriteBuffer, Len);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Ends batching of socket writes of Handler and sends the batched data.      M
+*   Invoked at the end of every object write, and also when a write is       M
+* aborted by a fatal error or the stream is closed, so a stream is never     M
+* left batching.							     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Handler:    The socket info handler.   If IP_CLNT_BROADCAST_ALL_HANDLES  M
+*	        ends the batching of all socket streams.		     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   _IPSocEndWriteBatch, ipc                                                 M
+*****************************************************************************/
+void _IPSocEndWriteBatch(int Handler)
+{
+    if (Handler == IP_CLNT_BROADCAST_ALL_HANDLES) {
+	int h;
+
+	for (h = 0; h < _IPMaxActiveStream; h++)
+	    if (_IPStream[h].InUse && _IPStream[h].Soc >= 0)
+	        _IPSocEndWriteBatch(h);
+    }
+    else if (Handler >= 0 && Handler < IP_MAX_NUM_OF_STREAMS) {
+	_IPStream[Handler].WriteBatch = FALSE;
+	IPSocFlushBlock(Handler);
+    }
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *  Sets echo printing of read input.                                         M
@@ -641,7 +746,7 @@ int IPSocReadCharNonBlock(int Handler)
 
     _IPStream[Handler].BufferSize = recv(_IPStream[Handler].Soc,
 					 _IPStream[Handler].Buffer,
-					 IRIT_LINE_LEN_LONG, 0);
+					 IP_SOC_BUFFER_SIZE, 0);
     if (_IPStream[Handler].BufferSize > 0) {
 	if (_IPStream[Handler].EchoInput) {
 	    int i;
@@ -9,6 +9,7 @@
 * Written by:  Gershon Elber				Ver 3.0, Apr. 1990   *
 *****************************************************************************/
 
+#include <Python.h>
 #include <ctype.h>
 #include <stdio.h>
 #include <string.h>
@@ -54,6 +55,13 @@ IRIT_STATIC_DATA struct termio GlblOrigTermio;
 
 #include "python_link.h"
 
+#if PY_VERSION_HEX >= 0x02060000
+#define IRIT_PY_NEW_BUFFER		   /* Buffers with a format and size. */
+typedef Py_buffer IritPyBufferType;
+#else
+typedef int IritPyBufferType;	  /* Old buffer protocol, nothing to release. */
+#endif /* PY_VERSION_HEX >= 0x02060000 */
+
 #ifdef NO_CONCAT_STR
 IRIT_STATIC_DATA char
     *VersionStr = "Irit		Version 10.0, Gershon Elber,\n\
@@ -1904,3 +1912,764 @@ int IritPyGetMeshSize(IPObjectStruct *FFObj, int Dir)
 
     return (int) GetMeshSize(FFObj, &R);
 }
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Fetches the control points' arrays of the first freeform in FFObj.       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   FFObj:      Freefrom object (curve, surface or trivariate).              *
+*   Len:        Number of control points is returned here.                   *
+*   PType:      Point type of the control points is returned here.           *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdRType **:   The Points vector of the freeform, NULL if not one.      *
+*****************************************************************************/
+static CagdRType **IritPyFFPoints(IPObjectStruct *FFObj,
+				  int *Len,
+				  CagdPointType *PType)
+{
+    if (FFObj == NULL)
+        return NULL;
+
+    switch (FFObj -> ObjType) {
+	case IP_OBJ_CURVE:
+	    *Len = FFObj -> U.Crvs -> Length;
+	    *PType = FFObj -> U.Crvs -> PType;
+	    return FFObj -> U.Crvs -> Points;
+	case IP_OBJ_SURFACE:
+	    *Len = FFObj -> U.Srfs -> ULength * FFObj -> U.Srfs -> VLength;
+	    *PType = FFObj -> U.Srfs -> PType;
+	    return FFObj -> U.Srfs -> Points;
+	case IP_OBJ_TRIVAR:
+	    *Len = FFObj -> U.Trivars -> ULength * FFObj -> U.Trivars -> VLength
+					     * FFObj -> U.Trivars -> WLength;
+	    *PType = FFObj -> U.Trivars -> PType;
+	    return FFObj -> U.Trivars -> Points;
+	default:
+	    return NULL;
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Wraps Len doubles at Data as a read-write python buffer object, without  *
+* copying, so numpy.frombuffer can map it in place.                          *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Data:      Doubles to wrap, NULL if none.                                *
+*   Len:       Number of doubles in Data.                                    *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   PyObject *:   A new reference to a buffer object, or to None.            *
+*****************************************************************************/
+static PyObject *IritPyBufferFromMemory(double *Data, int Len)
+{
+    if (Data == NULL || Len <= 0) {
+        Py_INCREF(Py_None);
+	return Py_None;
+    }
+
+#if PY_MAJOR_VERSION >= 3
+    return PyMemoryView_FromMemory((char *) Data,
+				   (Py_ssize_t) (sizeof(double) * Len),
+				   PyBUF_WRITE);
+#else
+    return PyBuffer_FromReadWriteMemory(Data,
+					(Py_ssize_t) (sizeof(double) * Len));
+#endif /* PY_MAJOR_VERSION >= 3 */
+}
+
+#ifdef IRIT_PY_NEW_BUFFER
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Returns TRUE if the given buffer format describes native doubles.        *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Format:    Buffer format, struct module syntax.  NULL for bytes.         *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:       TRUE if native doubles, FALSE otherwise.                      *
+*****************************************************************************/
+static int IritPyBufferIsDouble(const char *Format)
+{
+    int One = 1,
+	LittleEndian = *((char *) &One) == 1;
+
+    if (Format == NULL)
+        return FALSE;
+
+    switch (*Format) {
+	case '@':
+	case '=':
+	    Format++;
+	    break;
+	case '<':
+	    if (!LittleEndian)
+	        return FALSE;
+	    Format++;
+	    break;
+	case '>':
+	case '!':
+	    if (LittleEndian)
+	        return FALSE;
+	    Format++;
+	    break;
+    }
+
+    return strcmp(Format, "d") == 0;
+}
+
+#endif /* IRIT_PY_NEW_BUFFER */
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Fetches the doubles of a python object supporting the buffer protocol,   *
+* such as a numpy array of float64, in place.  Release with                  *
+* IritPyBufferRelease.							     *
+*   On failure a python exception is set, a TypeError if the buffer does not *
+* hold doubles.								     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Obj:       Python object to fetch its buffer.                            *
+*   Writable:  TRUE if the buffer is to be written to.                       *
+*   Len:       Number of doubles in the buffer is returned here.             *
+*   View:      Buffer view to release later with IritPyBufferRelease.        *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   double *:  The doubles of the buffer, or NULL if Obj has no proper       *
+*	       buffer.							     *
+*****************************************************************************/
+static double *IritPyBufferGet(PyObject *Obj,
+			       int Writable,
+			       int *Len,
+			       IritPyBufferType *View)
+{
+    void *Data;
+    Py_ssize_t Size;
+
+#ifdef IRIT_PY_NEW_BUFFER
+    if (PyObject_GetBuffer(Obj, View, (Writable ? PyBUF_WRITABLE
+					        : PyBUF_SIMPLE) |
+				      PyBUF_FORMAT) != 0)
+	return NULL;
+    if (View -> itemsize != sizeof(double) ||
+	!IritPyBufferIsDouble(View -> format)) {
+        PyBuffer_Release(View);
+	PyErr_SetString(PyExc_TypeError,
+			"Expected a buffer of float64, i.e. a numpy float64 array");
+	return NULL;
+    }
+    Data = View -> buf;
+    Size = View -> len;
+#else
+    /* The old buffer protocol carries no format to validate. */
+    *View = FALSE;
+    if ((Writable ? PyObject_AsWriteBuffer(Obj, &Data, &Size)
+		  : PyObject_AsReadBuffer(Obj, (const void **) &Data,
+					  &Size)) != 0)
+	return NULL;
+    *View = TRUE;
+#endif /* IRIT_PY_NEW_BUFFER */
+
+    *Len = (int) (Size / sizeof(double));
+    return (double *) Data;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Releases a buffer fetched by IritPyBufferGet.                            *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   View:      Buffer view to release.                                       *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IritPyBufferRelease(IritPyBufferType *View)
+{
+#ifdef IRIT_PY_NEW_BUFFER
+    PyBuffer_Release(View);
+#endif /* IRIT_PY_NEW_BUFFER */
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Returns the knot vector of the given freeform in the given direction.    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   FFObj:      Freefrom object (curve, surface or trivariate).              *
+*   Dir:        Direction of knot vector (0 for U, 1 for V, 2 for W).        *
+*   Len:        Length of knot vector is returned here.                      *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdRType *:  The knot vector, or NULL if none (i.e. a Bezier freeform). *
+*****************************************************************************/
+static CagdRType *IritPyFFKnotVector(IPObjectStruct *FFObj, int Dir, int *Len)
+{
+    if (FFObj == NULL)
+        return NULL;
+
+    switch (FFObj -> ObjType) {
+	case IP_OBJ_CURVE:
+	    if (Dir != 0)
+	        return NULL;
+	    *Len = CAGD_CRV_PT_LST_LEN(FFObj -> U.Crvs) +
+						      FFObj -> U.Crvs -> Order;
+	    return FFObj -> U.Crvs -> KnotVector;
+	case IP_OBJ_SURFACE:
+	    switch (Dir) {
+		case 0:
+		    *Len = CAGD_SRF_UPT_LST_LEN(FFObj -> U.Srfs) +
+						     FFObj -> U.Srfs -> UOrder;
+		    return FFObj -> U.Srfs -> UKnotVector;
+		case 1:
+		    *Len = CAGD_SRF_VPT_LST_LEN(FFObj -> U.Srfs) +
+						     FFObj -> U.Srfs -> VOrder;
+		    return FFObj -> U.Srfs -> VKnotVector;
+		default:
+		    return NULL;
+	    }
+	case IP_OBJ_TRIVAR:
+	    switch (Dir) {
+		case 0:
+		    *Len = TRIV_TV_UPT_LST_LEN(FFObj -> U.Trivars) +
+						  FFObj -> U.Trivars -> UOrder;
+		    return FFObj -> U.Trivars -> UKnotVector;
+		case 1:
+		    *Len = TRIV_TV_VPT_LST_LEN(FFObj -> U.Trivars) +
+						  FFObj -> U.Trivars -> VOrder;
+		    return FFObj -> U.Trivars -> VKnotVector;
+		case 2:
+		    *Len = TRIV_TV_WPT_LST_LEN(FFObj -> U.Trivars) +
+						  FFObj -> U.Trivars -> WOrder;
+		    return FFObj -> U.Trivars -> WKnotVector;
+		default:
+		    return NULL;
+	    }
+	default:
+	    return NULL;
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Returns the Axis coefficients of the control points of the given         M
+* freeform as a python read-write buffer, in place.  No copy is made so      M
+* numpy.frombuffer(GetCtlPtsAxis(FFObj, 1)) reads and modifies the X         M
+* coefficients directly, as long as FFObj is alive.  Axis 0 holds the        M
+* weights of rational freeforms.					     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FFObj:      Freefrom object (curve, surface or trivariate).		     M
+*   Axis:       Coefficient to fetch: 0 for W, 1 for X, 2 for Y, etc.	     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   PyObject *:   A buffer of the coefficients, or None if no such axis.     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IritPyGetMeshSize, IritPyGetKnotVector, IritPyCopyCtlPts                 M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyGetCtlPtsAxis                                                      M
+*****************************************************************************/
+PyObject *IritPyGetCtlPtsAxis(IPObjectStruct *FFObj, int Axis)
+{
+    int Len;
+    CagdPointType PType;
+    CagdRType
+	**Points = IritPyFFPoints(FFObj, &Len, &PType);
+
+    if (Points == NULL ||
+	Axis < !CAGD_IS_RATIONAL_PT(PType) ||
+	Axis > CAGD_NUM_OF_PT_COORD(PType))
+	return IritPyBufferFromMemory(NULL, 0);
+
+    return IritPyBufferFromMemory(Points[Axis], Len);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Returns the length of the knot vector of the given freeform in the given M
+* direction.								     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FFObj:      Freefrom object (curve, surface or trivariate).		     M
+*   Dir:        Direction of knot vector (0 for U, 1 for V, 2 for W).	     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:    Length of knot vector, zero if none (i.e. a Bezier freeform).    M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IritPyGetKnotVector                                                      M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyGetKnotVectorLength                                                M
+*****************************************************************************/
+int IritPyGetKnotVectorLength(IPObjectStruct *FFObj, int Dir)
+{
+    int Len;
+
+    return IritPyFFKnotVector(FFObj, Dir, &Len) == NULL ? 0 : Len;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Returns the knot vector of the given freeform in the given direction as  M
+* a python read-write buffer, in place.  No copy is made.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FFObj:      Freefrom object (curve, surface or trivariate).		     M
+*   Dir:        Direction of knot vector (0 for U, 1 for V, 2 for W).	     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   PyObject *:   A buffer of the knot vector, or None if none (i.e. a      M
+*		  Bezier freeform).					     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IritPyGetKnotVectorLength, IritPyGetCtlPtsAxis                           M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyGetKnotVector                                                      M
+*****************************************************************************/
+PyObject *IritPyGetKnotVector(IPObjectStruct *FFObj, int Dir)
+{
+    int Len = 0;
+    CagdRType
+	*KV = IritPyFFKnotVector(FFObj, Dir, &Len);
+
+    return IritPyBufferFromMemory(KV, Len);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Copies all control points of the given freeform into Buf, in one call,   M
+* interleaved as (W,) X, Y, Z,... per control point, with the weight only    M
+* present for rational freeforms.					     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FFObj:      Freefrom object (curve, surface or trivariate).		     M
+*   Buf:        A writable python buffer of doubles (i.e. a numpy float64    M
+*		array) where to place the coefficients.			     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:    Number of reals copied, or -1 if not a freeform or Buf is not a  M
+*	    writable buffer or too small.  A TypeError is raised if Buf does M
+*	    not hold float64 values.					     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IritPyGetCtlPtsAxis                                                      M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyCopyCtlPts                                                         M
+*****************************************************************************/
+int IritPyCopyCtlPts(IPObjectStruct *FFObj, PyObject *Buf)
+{
+    int i, j, Len, BufLen, NumCoords, IsNotRational;
+    CagdPointType PType;
+    CagdRType *Data,
+	**Points = IritPyFFPoints(FFObj, &Len, &PType);
+    IritPyBufferType View;
+
+    if (Points == NULL ||
+	(Data = IritPyBufferGet(Buf, TRUE, &BufLen, &View)) == NULL)
+	return -1;
+
+    IsNotRational = !CAGD_IS_RATIONAL_PT(PType);
+    NumCoords = CAGD_NUM_OF_PT_COORD(PType) + !IsNotRational;
+    if (Len * NumCoords > BufLen) {
+        IritPyBufferRelease(&View);
+	return -1;
+    }
+
+    for (j = IsNotRational; j <= CAGD_NUM_OF_PT_COORD(PType); j++) {
+	CagdRType
+	    *Pts = Points[j],
+	    *B = &Data[j - IsNotRational];
+
+	for (i = 0; i < Len; i++, B += NumCoords)
+	    *B = *Pts++;
+    }
+
+    IritPyBufferRelease(&View);
+
+    return Len * NumCoords;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Returns the vertices and the polygons of the given polygonal object, in  M
+* an indexed form, as two python bytearrays that numpy.frombuffer maps with  M
+* no further copy:							     M
+* + The unique vertices' (X, Y, Z) coordinates, as float64 triplets.	     M
+* + The indices of the vertices of every polygon, as int32, each polygon     M
+*   terminated by -1.							     M
+*   The vertices of a polygonal object are linked lists, not an array, so    M
+* the indexed form is built (see IPCnvPolyToPolyVrtxIdxStruct) and copied    M
+* once, directly into memory owned by python.				     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   PlObj:      Polygonal object to fetch its indexed form.		     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   PyObject *:   A (Vertices, Indices) tuple, or None if not a polygonal    M
+*		  object.						     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IPCnvPolyToPolyVrtxIdxStruct, IritPyGetCtlPtsAxis                        M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyGetIndexedMesh                                                     M
+*****************************************************************************/
+PyObject *IritPyGetIndexedMesh(IPObjectStruct *PlObj)
+{
+    int i, j,
+	NumIndices = 0;
+    int *Idx, *I;
+    double *V;
+    PyObject *Vrtcs, *Indices;
+    IPPolyVrtxIdxStruct *PVIdx;
+
+    if (PlObj == NULL ||
+	!IP_IS_POLY_OBJ(PlObj) ||
+	(PVIdx = IPCnvPolyToPolyVrtxIdxStruct(PlObj, FALSE, 0)) == NULL) {
+        Py_INCREF(Py_None);
+	return Py_None;
+    }
+
+    for (i = 0; i < PVIdx -> NumPlys; i++) {
+        for (Idx = PVIdx -> Polygons[i]; *Idx >= 0; Idx++)
+	    NumIndices++;
+	NumIndices++;
+    }
+
+    Vrtcs = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)
+				    (sizeof(double) * 3 * PVIdx -> NumVrtcs));
+    Indices = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)
+					    (sizeof(int) * NumIndices));
+    if (Vrtcs == NULL || Indices == NULL) {
+        Py_XDECREF(Vrtcs);
+        Py_XDECREF(Indices);
+	IPPolyVrtxIdxFree(PVIdx);
+	return NULL;
+    }
+
+    V = (double *) PyByteArray_AsString(Vrtcs);
+    for (i = 0; i < PVIdx -> NumVrtcs; i++)
+        for (j = 0; j < 3; j++)
+	    *V++ = PVIdx -> Vertices[i] -> Coord[j];
+
+    I = (int *) PyByteArray_AsString(Indices);
+    for (i = 0; i < PVIdx -> NumPlys; i++) {
+        for (Idx = PVIdx -> Polygons[i]; *Idx >= 0; )
+	    *I++ = *Idx++;
+	*I++ = -1;
+    }
+
+    IPPolyVrtxIdxFree(PVIdx);
+
+    return Py_BuildValue("(NN)", Vrtcs, Indices);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Evaluates the Order basis functions, at t, that are not zero, of a       *
+* Bezier (KV is NULL) or an (open or floating) B-spline basis.  Touches no   *
+* static data so it can be invoked with the python GIL released.             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   KV:        Knot vector of the B-spline basis, NULL for a Bezier basis.   *
+*   Order:     Order of the basis.                                           *
+*   Len:       Number of basis functions.                                    *
+*   t:         Parameter to evaluate at, in the domain.                      *
+*   Basis:     Where the Order basis functions are placed.                   *
+*   Left, Right:  Scratch space of Order reals each.                         *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:       Index of the first basis function placed in Basis.            *
+*****************************************************************************/
+static int IritPyEvalBasis(const CagdRType *KV,
+			   int Order,
+			   int Len,
+			   CagdRType t,
+			   CagdRType *Basis,
+			   CagdRType *Left,
+			   CagdRType *Right)
+{
+    int j, r, Low, High, Index;
+    CagdRType Saved, Tmp;
+
+    Basis[0] = 1.0;
+
+    if (KV == NULL) {
+        /* Bernstein basis, by a de Casteljau like recurrence. */
+        for (j = 1; j < Order; j++) {
+	    for (Saved = 0.0, r = 0; r < j; r++) {
+	        Tmp = Basis[r];
+		Basis[r] = Saved + (1.0 - t) * Tmp;
+		Saved = t * Tmp;
+	    }
+	    Basis[j] = Saved;
+	}
+	return 0;
+    }
+
+    /* Find Index so KV[Index] <= t < KV[Index + 1], within the domain. */
+    Low = Order - 1;
+    High = Len - 1;
+    while (Low < High) {
+        Index = (Low + High + 1) >> 1;
+        if (KV[Index] <= t)
+	    Low = Index;
+	else
+	    High = Index - 1;
+    }
+    Index = Low;
+
+    for (j = 1; j < Order; j++) {
+        Left[j] = t - KV[Index + 1 - j];
+	Right[j] = KV[Index + j] - t;
+	for (Saved = 0.0, r = 0; r < j; r++) {
+	    Tmp = Basis[r] / (Right[r + 1] + Left[j - r]);
+	    Basis[r] = Saved + Right[r + 1] * Tmp;
+	    Saved = Left[j - r] * Tmp;
+	}
+	Basis[j] = Saved;
+    }
+
+    return Index - Order + 1;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Converts the given point, with coefficients (W,) X, Y, Z,..., to E3.    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Pt:        The point's coefficients, W in Pt[0] even if not rational.    *
+*   PType:     Point type of Pt.                                             *
+*   Out:       Where the Euclidean X, Y, Z are placed.                       *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IritPyPtToE3(const CagdRType *Pt, CagdPointType PType, double *Out)
+{
+    int j,
+	MaxCoord = IRIT_MIN(CAGD_NUM_OF_PT_COORD(PType), 3);
+    CagdRType
+	W = CAGD_IS_RATIONAL_PT(PType) && Pt[0] != 0.0 ? 1.0 / Pt[0] : 1.0;
+
+    for (j = 1; j <= 3; j++)
+        Out[j - 1] = j <= MaxCoord ? Pt[j] * W : 0.0;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Evaluates the given curve at N parameters in one call, placing the       M
+* Euclidean (X, Y, Z) positions in Out.  All parameters are validated to be M
+* in the curve's domain first, and then evaluated with the python GIL       M
+* released, so other python threads can run meanwhile.  The curve must not  M
+* be modified by other threads during the evaluation.			     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   CrvObj:     Curve object to evaluate.				     M
+*   Params:     A python buffer of N parameter values (i.e. a numpy float64  M
+*		array).							     M
+*   Out:        A writable python buffer of at least 3 * N doubles where the M
+*		coordinates are placed.					     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:    Number of points evaluated, or -1 if not a curve, a parameter is M
+*	    out of the domain or the buffers are invalid.  A TypeError is    M
+*	    raised if a buffer does not hold float64 values.		     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IritPyEvalSrfBatch, CagdCrvEval                                          M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyEvalCrvBatch                                                       M
+*****************************************************************************/
+int IritPyEvalCrvBatch(IPObjectStruct *CrvObj, PyObject *Params, PyObject *Out)
+{
+    int i, j, r, N, OutLen, Order, Len, First, MaxCoord,
+	RetVal = -1;
+    CagdRType TMin, TMax, *KV, *Basis, *Left, *Right, *Pt, *T, *O;
+    CagdCrvStruct
+	*Crv = NULL;
+    IritPyBufferType ParamsView, OutView;
+
+    if (CrvObj == NULL || !IP_IS_CRV_OBJ(CrvObj))
+	return -1;
+
+    if ((T = IritPyBufferGet(Params, FALSE, &N, &ParamsView)) == NULL)
+        return -1;
+    if ((O = IritPyBufferGet(Out, TRUE, &OutLen, &OutView)) == NULL) {
+        IritPyBufferRelease(&ParamsView);
+        return -1;
+    }
+
+    /* Bring the curve to a Bezier or a non periodic B-spline form. */
+    Crv = CrvObj -> U.Crvs;
+    if (CAGD_IS_POWER_CRV(Crv))
+        Crv = CagdCnvrtPwr2BzrCrv(Crv);
+    else if (CAGD_IS_BSPLINE_CRV(Crv) && CAGD_IS_PERIODIC_CRV(Crv))
+        Crv = CagdCnvrtPeriodic2FloatCrv(Crv);
+
+    CagdCrvDomain(Crv, &TMin, &TMax);
+    for (i = 0; i < N; i++) {
+        if (T[i] < TMin || T[i] > TMax)
+	    break;
+    }
+
+    if (i == N && OutLen >= 3 * N) {
+        Order = Crv -> Order;
+	Len = Crv -> Length;
+	KV = CAGD_IS_BSPLINE_CRV(Crv) ? Crv -> KnotVector : NULL;
+	MaxCoord = CAGD_NUM_OF_PT_COORD(Crv -> PType);
+	Basis = (CagdRType *) IritMalloc(sizeof(CagdRType) *
+					 (3 * Order + CAGD_MAX_PT_SIZE));
+	Left = &Basis[Order];
+	Right = &Left[Order];
+	Pt = &Right[Order];
+
+	Py_BEGIN_ALLOW_THREADS
+	for (i = 0; i < N; i++, O += 3) {
+	    First = IritPyEvalBasis(KV, Order, Len, T[i], Basis, Left, Right);
+
+	    Pt[0] = 1.0;
+	    for (j = !CAGD_IS_RATIONAL_CRV(Crv); j <= MaxCoord; j++) {
+	        CagdRType
+		    *Coefs = &Crv -> Points[j][First];
+
+		for (Pt[j] = 0.0, r = 0; r < Order; r++)
+		    Pt[j] += Basis[r] * Coefs[r];
+	    }
+	    IritPyPtToE3(Pt, Crv -> PType, O);
+	}
+	Py_END_ALLOW_THREADS
+
+	IritFree(Basis);
+	RetVal = N;
+    }
+
+    if (Crv != CrvObj -> U.Crvs)
+        CagdCrvFree(Crv);
+    IritPyBufferRelease(&ParamsView);
+    IritPyBufferRelease(&OutView);
+
+    return RetVal;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Evaluates the given surface at N (u, v) parameters in one call, placing  M
+* the Euclidean (X, Y, Z) positions in Out.  All parameters are validated   M
+* to be in the surface's domain first, and then evaluated with the python   M
+* GIL released, so other python threads can run meanwhile.  The surface     M
+* must not be modified by other threads during the evaluation.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   SrfObj:     Surface object to evaluate.				     M
+*   UVs:        A python buffer of N (u, v) parameter pairs, interleaved     M
+*		(i.e. a numpy float64 array).				     M
+*   Out:        A writable python buffer of at least 3 * N doubles where the M
+*		coordinates are placed.					     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:    Number of points evaluated, or -1 if not a surface, a parameter  M
+*	    is out of the domain or the buffers are invalid.  A TypeError is M
+*	    raised if a buffer does not hold float64 values.		     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IritPyEvalCrvBatch, CagdSrfEval                                          M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IritPyEvalSrfBatch                                                       M
+*****************************************************************************/
+int IritPyEvalSrfBatch(IPObjectStruct *SrfObj, PyObject *UVs, PyObject *Out)
+{
+    int i, j, r, s, N, OutLen, UOrder, VOrder, UFirst, VFirst, MaxCoord,
+	RetVal = -1;
+    CagdRType UMin, UMax, VMin, VMax, *UKV, *VKV, *UBasis, *VBasis, *Left,
+	*Right, *Pt, *UV, *O;
+    CagdSrfStruct
+	*Srf = NULL;
+    IritPyBufferType UVsView, OutView;
+
+    if (SrfObj == NULL || !IP_IS_SRF_OBJ(SrfObj))
+	return -1;
+
+    if ((UV = IritPyBufferGet(UVs, FALSE, &N, &UVsView)) == NULL)
+        return -1;
+    if ((O = IritPyBufferGet(Out, TRUE, &OutLen, &OutView)) == NULL) {
+        IritPyBufferRelease(&UVsView);
+        return -1;
+    }
+    N >>= 1;
+
+    /* Bring the surface to a Bezier or a non periodic B-spline form. */
+    Srf = SrfObj -> U.Srfs;
+    if (CAGD_IS_POWER_SRF(Srf))
+        Srf = CagdCnvrtPwr2BzrSrf(Srf);
+    else if (CAGD_IS_BSPLINE_SRF(Srf) && CAGD_IS_PERIODIC_SRF(Srf))
+        Srf = CagdCnvrtPeriodic2FloatSrf(Srf);
+
+    CagdSrfDomain(Srf, &UMin, &UMax, &VMin, &VMax);
+    for (i = 0; i < N; i++) {
+        if (UV[i * 2] < UMin || UV[i * 2] > UMax ||
+	    UV[i * 2 + 1] < VMin || UV[i * 2 + 1] > VMax)
+	    break;
+    }
+
+    if (i == N && OutLen >= 3 * N) {
+        UOrder = Srf -> UOrder;
+	VOrder = Srf -> VOrder;
+	UKV = CAGD_IS_BSPLINE_SRF(Srf) ? Srf -> UKnotVector : NULL;
+	VKV = CAGD_IS_BSPLINE_SRF(Srf) ? Srf -> VKnotVector : NULL;
+	MaxCoord = CAGD_NUM_OF_PT_COORD(Srf -> PType);
+	UBasis = (CagdRType *)
+	    IritMalloc(sizeof(CagdRType) * (3 * (UOrder + VOrder) +
+					    CAGD_MAX_PT_SIZE));
+	VBasis = &UBasis[UOrder];
+	Left = &VBasis[VOrder];
+	Right = &Left[UOrder + VOrder];
+	Pt = &Right[UOrder + VOrder];
+
+	Py_BEGIN_ALLOW_THREADS
+	for (i = 0; i < N; i++, UV += 2, O += 3) {
+	    UFirst = IritPyEvalBasis(UKV, UOrder, Srf -> ULength, UV[0],
+				     UBasis, Left, Right);
+	    VFirst = IritPyEvalBasis(VKV, VOrder, Srf -> VLength, UV[1],
+				     VBasis, Left, Right);
+
+	    Pt[0] = 1.0;
+	    for (j = !CAGD_IS_RATIONAL_SRF(Srf); j <= MaxCoord; j++) {
+	        CagdRType
+		    *Coefs = Srf -> Points[j];
+
+		for (Pt[j] = 0.0, s = 0; s < VOrder; s++) {
+		    CagdRType
+		        *Row = &Coefs[CAGD_MESH_UV(Srf, UFirst, VFirst + s)],
+			Sum = 0.0;
+
+		    for (r = 0; r < UOrder; r++)
+		        Sum += UBasis[r] * Row[r];
+		    Pt[j] += VBasis[s] * Sum;
+		}
+	    }
+	    IritPyPtToE3(Pt, Srf -> PType, O);
+	}
+	Py_END_ALLOW_THREADS
+
+	IritFree(UBasis);
+	RetVal = N;
+    }
+
+    if (Srf != SrfObj -> U.Srfs)
+        CagdSrfFree(Srf);
+    IritPyBufferRelease(&UVsView);
+    IritPyBufferRelease(&OutView);
+
+    return RetVal;
+}
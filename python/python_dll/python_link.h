@@ -7,6 +7,8 @@
 #ifndef _PYTHON_IRIT_LINK
 #define _PYTHON_IRIT_LINK
 
+#include <Python.h>
+
 void IritInit();
 IPObjectStruct *CreateCtlPt(int type, int NumParams, IrtRType Params[]);
 void IritQueryFunctions(void);
@@ -26,6 +28,13 @@ int IritPyIsNullObject(IPObjectStruct *PObj);
 int IritPyThisObject(IPObjectStruct*);
 
 int IritPyGetMeshSize(IPObjectStruct *FFObj, int Dir);
+PyObject *IritPyGetCtlPtsAxis(IPObjectStruct *FFObj, int Axis);
+int IritPyGetKnotVectorLength(IPObjectStruct *FFObj, int Dir);
+PyObject *IritPyGetKnotVector(IPObjectStruct *FFObj, int Dir);
+int IritPyCopyCtlPts(IPObjectStruct *FFObj, PyObject *Buf);
+PyObject *IritPyGetIndexedMesh(IPObjectStruct *PlObj);
+int IritPyEvalCrvBatch(IPObjectStruct *CrvObj, PyObject *Params, PyObject *Out);
+int IritPyEvalSrfBatch(IPObjectStruct *SrfObj, PyObject *UVs, PyObject *Out);
 
 char* IritPyFetchStrObject( IPObjectStruct* obj );
 double IritPyFetchRealObject( IPObjectStruct* obj );
@@ -0,0 +1,134 @@
+#This is an IRIT script and as such requires both math and irit import:
+#
+import math
+import irit
+import array
+#
+
+
+#
+#  Compares the batched buffer entry points of the python bindings with
+#  the one at a time evaluations and coordinates queries.
+#
+
+def cmpreals( a, b, eps ):
+    return math.fabs( a - b ) < eps
+
+failed = 0
+
+c = irit.cbspline( 3, irit.list( irit.ctlpt( irit.E3, 0, 0, 0 ), \
+                                 irit.ctlpt( irit.E3, 1, 2, 0 ), \
+                                 irit.ctlpt( irit.E3, 2, (-1 ), 1 ), \
+                                 irit.ctlpt( irit.E3, 3, 1, 2 ), \
+                                 irit.ctlpt( irit.E3, 4, 0, 0 ) ), \
+                   irit.list( irit.KV_OPEN ) )
+
+s = irit.sbezier( irit.list( irit.list( irit.ctlpt( irit.E3, 0, 0, 0 ), \
+                                        irit.ctlpt( irit.E3, 0.5, 0, 0 ), \
+                                        irit.ctlpt( irit.E3, 1, 0, 0 ) ), \
+                             irit.list( irit.ctlpt( irit.E3, 0, 0.5, 0 ), \
+                                        irit.ctlpt( irit.E3, 0.5, 0.5, 0.5 ), \
+                                        irit.ctlpt( irit.E3, 1, 0.5, 0 ) ), \
+                             irit.list( irit.ctlpt( irit.E3, 0, 1, 0 ), \
+                                        irit.ctlpt( irit.E3, 0.5, 1, 0 ), \
+                                        irit.ctlpt( irit.E3, 1, 1, 0 ) ) ) )
+
+#
+#  CopyCtlPts and GetCtlPtsAxis against the control points, one at a time.
+#
+n = irit.GetMeshSize( c, 0 )
+ctlpts = array.array( "d", [ 0.0 ] * ( 3 * n ) )
+if ( irit.CopyCtlPts( c, ctlpts ) != 3 * n ):
+    failed = failed + 1
+xs = array.array( "d", bytes( irit.GetCtlPtsAxis( c, 1 ) ) )
+i = 0
+while ( i < n ):
+    pt = irit.coord( c, i )
+    j = 0
+    while ( j < 3 ):
+        if ( not cmpreals( ctlpts[ i * 3 + j ], \
+                           irit.FetchRealObject( irit.coord( pt, j + 1 ) ), \
+                           1e-12 ) ):
+            failed = failed + 1
+        j = j + 1
+    if ( not cmpreals( xs[ i ], ctlpts[ i * 3 ], 1e-12 ) ):
+        failed = failed + 1
+    i = i + 1
+
+#
+#  EvalCrvBatch against ceval.
+#
+n = 50
+params = array.array( "d", map( lambda i: i / ( n - 1.0 ), range( n ) ) )
+pts = array.array( "d", [ 0.0 ] * ( 3 * n ) )
+if ( irit.EvalCrvBatch( c, params, pts ) != n ):
+    failed = failed + 1
+i = 0
+while ( i < n ):
+    pt = irit.ceval( c, params[ i ] )
+    j = 0
+    while ( j < 3 ):
+        if ( not cmpreals( pts[ i * 3 + j ], \
+                           irit.FetchRealObject( irit.coord( pt, j + 1 ) ), \
+                           1e-10 ) ):
+            failed = failed + 1
+        j = j + 1
+    i = i + 1
+
+#
+#  EvalSrfBatch against seval.
+#
+n = 7
+uvs = array.array( "d" )
+i = 0
+while ( i < n ):
+    j = 0
+    while ( j < n ):
+        uvs.append( i / ( n - 1.0 ) )
+        uvs.append( j / ( n - 1.0 ) )
+        j = j + 1
+    i = i + 1
+pts = array.array( "d", [ 0.0 ] * ( 3 * n * n ) )
+if ( irit.EvalSrfBatch( s, uvs, pts ) != n * n ):
+    failed = failed + 1
+i = 0
+while ( i < n * n ):
+    pt = irit.seval( s, uvs[ i * 2 ], uvs[ i * 2 + 1 ] )
+    j = 0
+    while ( j < 3 ):
+        if ( not cmpreals( pts[ i * 3 + j ], \
+                           irit.FetchRealObject( irit.coord( pt, j + 1 ) ), \
+                           1e-10 ) ):
+            failed = failed + 1
+        j = j + 1
+    i = i + 1
+
+#
+#  GetIndexedMesh of a box: 8 shared corners and one index list per face.
+#
+b = irit.box( ( 0, 0, 0 ), 1, 2, 3 )
+mesh = irit.GetIndexedMesh( b )
+vrtcs = array.array( "d", bytes( mesh[ 0 ] ) )
+idcs = array.array( "i", bytes( mesh[ 1 ] ) )
+if ( len( vrtcs ) != 3 * 8 or \
+     idcs.count( -1 ) != irit.SizeOf( b ) or \
+     len( idcs ) != 5 * irit.SizeOf( b ) ):
+    failed = failed + 1
+i = 0
+while ( i < len( vrtcs ) ):
+    if ( not ( vrtcs[ i ] in ( 0, 1 ) and vrtcs[ i + 1 ] in ( 0, 2 ) and \
+               vrtcs[ i + 2 ] in ( 0, 3 ) ) ):
+        failed = failed + 1
+    i = i + 3
+if ( irit.GetIndexedMesh( c ) != None ):
+    failed = failed + 1
+
+if ( failed == 0 ):
+    print "pybatch: o.k."
+else:
+    print "pybatch: %d comparisons FAILED" % ( failed )
+
+irit.free( b )
+irit.free( c )
+irit.free( s )
+
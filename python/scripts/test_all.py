@@ -500,6 +500,9 @@ work_function(file_name)
 file_name = "puzzles.py"
 work_function(file_name)
 
+file_name = "pybatch.py"
+work_function(file_name)
+
 file_name = "quadric.py"
 work_function(file_name)
 
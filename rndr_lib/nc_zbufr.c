@@ -24,8 +24,9 @@ typedef struct INCZBufferStruct {
     IRndrTriangleStruct Tri;
     IRndrLineSegmentStruct Seg;
     INCModeType Mode;
-    IrtRType ClbkZ, ZPixelsRemoved;
+    IrtRType ClbkZ, ZPixelsRemoved, LastMaskPosZ;
     int GridSizeX, GridSizeY;
+    int LastMaskPosXY[2];
     int ActiveRegionXMin, ActiveRegionYMin,
         ActiveRegionXMax, ActiveRegionYMax;
 } INCZBufferStruct;
@@ -96,6 +97,8 @@ INCZBufferPtrType INCRndrInitialize(int ZBufSizeX,
     Rend -> ActiveRegionXMin = Rend -> ActiveRegionYMin = IRIT_MAX_INT;
     Rend -> ActiveRegionXMax = Rend -> ActiveRegionYMax = -1;
     Rend -> ZPixelsRemoved = 0.0;
+    Rend -> LastMaskPosXY[0] = Rend -> LastMaskPosXY[1] = -1;
+    Rend -> LastMaskPosZ = IRIT_INFNTY;
     SceneSetMatrices(&Rend -> Scene, NULL, NULL, NULL);
 
     /* All the initalizations are done once and for all. */
@@ -292,65 +295,150 @@ IrtRType INCRndrPutMask(INCZBufferPtrType Rend,
 			int MaskXSize,
 			int MaskYSize)
 {
-    IRIT_STATIC_DATA int
-	LastPosXY[2] = { -1, -1 };
-    IRIT_STATIC_DATA IrtRType
-	LastPosZ = IRIT_INFNTY;
-    int x, x1, x2, y, y1, y2;
+    int x, x1, x2, y, y1, y2, XMin, XMax, YMin, YMax;
     IrtRType
 	Volume = 0.0;
     IRndrZBufferStruct
         *ZBuffer = &Rend -> ZBuf;
 
-    if (IRIT_APX_EQ(LastPosZ, PosZ) &&
-	LastPosXY[0] == PosXY[0] &&
-	LastPosXY[1] == PosXY[1])
+    if (IRIT_APX_EQ(Rend -> LastMaskPosZ, PosZ) &&
+	Rend -> LastMaskPosXY[0] == PosXY[0] &&
+	Rend -> LastMaskPosXY[1] == PosXY[1])
 	return 0.0;
-    LastPosZ = PosZ;
-    LastPosXY[0] = PosXY[0];
-    LastPosXY[1] = PosXY[1];
+    Rend -> LastMaskPosZ = PosZ;
+    Rend -> LastMaskPosXY[0] = PosXY[0];
+    Rend -> LastMaskPosXY[1] = PosXY[1];
 
+    /* Clip the mask to the Z buffer once, and skip the outside locations. */
     x1 = PosXY[0] - MaskXSize / 2;
     x2 = x1 + MaskXSize - 1;
     y1 = PosXY[1] - MaskYSize / 2;
     y2 = y1 + MaskYSize - 1;
+    if (x1 < 0) {
+        Mask -= x1;
+	x1 = 0;
+    }
+    if (x2 >= ZBuffer -> SizeX)
+        x2 = ZBuffer -> SizeX - 1;
+    if (y1 < 0) {
+        Mask -= y1 * MaskXSize;
+	y1 = 0;
+    }
+    if (y2 >= ZBuffer -> SizeY)
+        y2 = ZBuffer -> SizeY - 1;
+
+    XMin = YMin = IRIT_MAX_INT;
+    XMax = YMax = -1;
+
+    for (y = y1; y <= y2; y++, Mask += MaskXSize) {
+        IrtRType
+	    *RowMask = Mask - x1;
+        IRndrZListStruct
+	    *RowZ = ZBuffer -> z[y];
 
-    for (y = y1; y <= y2; y++) {
         for (x = x1; x <= x2; x++) {
-	    if (x < 0 ||
-		x >= ZBuffer -> SizeX ||
-		y < 0 ||
-		y >= ZBuffer -> SizeY)
-	        Mask++;  /* Skip the location that is outside the Z Buffer. */
-	    else {
-	        IRndrZListStruct
-		    *CurrZ = &ZBuffer -> z[y][x];
-
-		if (*Mask++ != IRIT_INFNTY &&
-		    CurrZ -> First.z > PosZ + Mask[-1]) {
-		    Volume += CurrZ -> First.z - (PosZ + Mask[-1]);
-
-		    if (Rend -> ActiveRegionXMin > x)
-		        Rend -> ActiveRegionXMin = x;
-		    if (Rend -> ActiveRegionXMax < x)
-		        Rend -> ActiveRegionXMax = x;
-
-		    if (Rend -> ActiveRegionYMin > y)
-		        Rend -> ActiveRegionYMin = y;
-		    if (Rend -> ActiveRegionYMax < y)
-		        Rend -> ActiveRegionYMax = y;
-
-		    CurrZ -> First.z = (IRndrZDepthType) (PosZ + Mask[-1]);
-		}
+	    IrtRType Z;
+	    IRndrZListStruct *CurrZ;
+
+	    if (RowMask[x] == IRIT_INFNTY)
+	        continue;
+
+	    Z = PosZ + RowMask[x];
+	    CurrZ = &RowZ[x];
+	    if (CurrZ -> First.z > Z) {
+	        Volume += CurrZ -> First.z - Z;
+		CurrZ -> First.z = (IRndrZDepthType) Z;
+
+		if (XMin > x)
+		    XMin = x;
+		if (XMax < x)
+		    XMax = x;
+		if (YMin > y)
+		    YMin = y;
+		YMax = y;
 	    }
 	}
     }
 
+    if (XMax >= 0) {
+        /* Update the active region once with the changed region. */
+        if (Rend -> ActiveRegionXMin > XMin)
+	    Rend -> ActiveRegionXMin = XMin;
+	if (Rend -> ActiveRegionXMax < XMax)
+	    Rend -> ActiveRegionXMax = XMax;
+	if (Rend -> ActiveRegionYMin > YMin)
+	    Rend -> ActiveRegionYMin = YMin;
+	if (Rend -> ActiveRegionYMax < YMax)
+	    Rend -> ActiveRegionYMax = YMax;
+    }
+
     Rend -> ZPixelsRemoved += Volume;
 
     return Volume;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Sweeps a depth Mask along a linear motion of the tool, from PosXY1 at    M
+* depth PosZ1 to PosXY2 at depth PosZ2, scan converting the Mask into the    M
+* Zbuffer at every pixel along the way.  The depth is linearly interpolated. M
+*   The Mask is not placed again at the starting location if it was the     M
+* last location of a previous mask, so a tool path can be swept line after   M
+* line while getting the amount of material removed by each line.	     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Rend:      IN, OUT, the rendering context.                               M
+*   PosXY1:    IN, XY starting location of the center of the mask.           M
+*   PosZ1:     IN, The starting depth of the mask.			     M
+*   PosXY2:    IN, XY terminal location of the center of the mask.           M
+*   PosZ2:     IN, The terminal depth of the mask.			     M
+*   Mask:      IN, The 2D square array of depth values.                      M
+*   MaskXSize: IN, X size of Mask.                                           M
+*   MaskYSize: IN, Y size of Mask.                                           M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IrtRType:   Amount of material removed by this motion in Pixels^2*Z     M
+*		volume units.	                                             M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   INCRndrPutMask                                                           M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   INCRndrPutMaskAlongLine, scan mask, tool sweep, polygon z-buffer         M
+*****************************************************************************/
+IrtRType INCRndrPutMaskAlongLine(INCZBufferPtrType Rend,
+				 int *PosXY1,
+				 IrtRType PosZ1,
+				 int *PosXY2,
+				 IrtRType PosZ2,
+				 IrtRType *Mask,
+				 int MaskXSize,
+				 int MaskYSize)
+{
+    int i, PosXY[2],
+	Dx = PosXY2[0] - PosXY1[0],
+	Dy = PosXY2[1] - PosXY1[1],
+	n = IRIT_MAX(IRIT_ABS(Dx), IRIT_ABS(Dy));
+    IrtRType
+	Volume = 0.0;
+
+    if (n == 0)
+        return INCRndrPutMask(Rend, PosXY2, PosZ2, Mask, MaskXSize, MaskYSize);
+
+    for (i = 0; i <= n; i++) {
+        IrtRType
+	    t = i / (IrtRType) n;
+
+	PosXY[0] = PosXY1[0] + (int) IRIT_REAL_TO_INT(Dx * t);
+	PosXY[1] = PosXY1[1] + (int) IRIT_REAL_TO_INT(Dy * t);
+
+	Volume += INCRndrPutMask(Rend, PosXY, PosZ1 + (PosZ2 - PosZ1) * t,
+				 Mask, MaskXSize, MaskYSize);
+    }
+
+    return Volume;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Marks the end of  the object scaning.                                    M
@@ -74,109 +74,52 @@ static CagdCrvStruct *ApproxCrvsAsQuadratics(
 CagdCrvStruct *BzrCrvMult(const CagdCrvStruct *CCrv1,
 			  const CagdCrvStruct *CCrv2)
 {
-    IRIT_STATIC_DATA int
-	CpPtsLen = 0;
-    IRIT_STATIC_DATA CagdRType
-	*CpPts1 = NULL,
-	*CpPts2 = NULL;
     CagdBType IsNotRational;
-    int i, j, ij, l, MaxCoord, IsScalar, ProdOrder,
+    int l, MaxCoord,
 	Order1 = CCrv1 -> Order,
-	Order2 = CCrv2 -> Order,
-	Degree1 = Order1 - 1,
-        Degree2 = Order2 - 1,
-        ProdDegree = Degree1 + Degree2;
+	Order2 = CCrv2 -> Order;
     CagdCrvStruct *ProdCrv,
-        *Crv1 = CagdCrvCopy(CCrv1),
-	*Crv2 = CagdCrvCopy(CCrv2);
-    CagdRType **PPoints, **Points1, **Points2;
+        *Crv1 = NULL,
+	*Crv2 = NULL;
+    CagdRType * const *Points1, * const *Points2;
 
-    if (!CAGD_IS_BEZIER_CRV(Crv1) || !CAGD_IS_BEZIER_CRV(Crv2)) {
-	CagdCrvFree(Crv1);
-	CagdCrvFree(Crv2);
+    if (!CAGD_IS_BEZIER_CRV(CCrv1) || !CAGD_IS_BEZIER_CRV(CCrv2)) {
 	SYMB_FATAL_ERROR(SYMB_ERR_BZR_CRV_EXPECT);
 	return NULL;
     }
 
-    if (Crv1 -> PType != Crv2 -> PType &&
-	!CagdMakeCrvsCompatible(&Crv1, &Crv2, FALSE, FALSE)) {
-	CagdCrvFree(Crv1);
-	CagdCrvFree(Crv2);
-	SYMB_FATAL_ERROR(SYMB_ERR_CRV_FAIL_CMPT);
-	return NULL;
+    /* Only copy the curves if they need to be made compatible. */
+    if (CCrv1 -> PType != CCrv2 -> PType) {
+        Crv1 = CagdCrvCopy(CCrv1);
+	Crv2 = CagdCrvCopy(CCrv2);
+	if (!CagdMakeCrvsCompatible(&Crv1, &Crv2, FALSE, FALSE)) {
+	    CagdCrvFree(Crv1);
+	    CagdCrvFree(Crv2);
+	    SYMB_FATAL_ERROR(SYMB_ERR_CRV_FAIL_CMPT);
+	    return NULL;
+	}
+	Points1 = Crv1 -> Points;
+	Points2 = Crv2 -> Points;
+    }
+    else {
+        Points1 = CCrv1 -> Points;
+	Points2 = CCrv2 -> Points;
     }
 
-    ProdCrv = BzrCrvNew(ProdOrder = Order1 + Order2 - 1, Crv1 -> PType);
+    ProdCrv = BzrCrvNew(Order1 + Order2 - 1,
+			Crv1 != NULL ? Crv1 -> PType : CCrv1 -> PType);
     IsNotRational = !CAGD_IS_RATIONAL_CRV(ProdCrv);
     MaxCoord = CAGD_NUM_OF_PT_COORD(ProdCrv -> PType);
-    IsScalar = IsNotRational && MaxCoord == 1;
-
-    PPoints = ProdCrv -> Points;
-    Points1 = Crv1 -> Points;
-    Points2 = Crv2 -> Points;
 
     for (l = IsNotRational; l <= MaxCoord; l++)
-        IRIT_ZAP_MEM(PPoints[l], sizeof(CagdRType) * ProdOrder);
-
-    /* Allocate temporary data, if necessary. */
-    if (CpPtsLen < IRIT_MAX(Order1, Order2)) {
-        CpPtsLen = IRIT_MAX(Order1, Order2) * 2;
-	if (CpPts1 != NULL)
-	    IritFree(CpPts1);
-	if (CpPts2 != NULL)
-	    IritFree(CpPts2);
-	CpPts1 = (CagdRType *) IritMalloc(sizeof(CagdRType) * CpPtsLen);
-	CpPts2 = (CagdRType *) IritMalloc(sizeof(CagdRType) * CpPtsLen);
-    }
-
-    if (ProdOrder < CAGD_MAX_BEZIER_CACHE_ORDER) {             /* Use cache. */
-        for (l = IsNotRational; l <= MaxCoord; l++) {
-	    CagdRType
-	        *PPts = PPoints[l];
-
-	    /* Place the combinatorial coefficients with the control points. */
-	    for (i = 0; i < Order1; i++)
-	        CpPts1[i] = Points1[l][i] * CagdIChooseKTable[Degree1][i];
-	    for (i = 0; i < Order2; i++)
-	        CpPts2[i] = Points2[l][i] * CagdIChooseKTable[Degree2][i];
-
-            /* Do the convolution. */
-	    for (i = 0; i < Order1; i++) {
-		for (j = 0, ij = i; j < Order2; j++, ij++)
-		    PPts[ij] += CpPts1[i] * CpPts2[j];
-	    }
-
-	    /* Update the denominator combinatorial coefficient. */
-	    for (i = 0; i < ProdOrder; i++)
-	        PPts[i] /= CagdIChooseKTable[ProdDegree][i];
-	}
-    }
-    else {
-        for (l = IsNotRational; l <= MaxCoord; l++) {
-	    CagdRType
-	        *PPts = PPoints[l];
-
-	    /* Place the combinatorial coefficients with the control points. */
-	    for (i = 0; i < Order1; i++)
-	        CpPts1[i] = Points1[l][i] * CagdIChooseK(i, Degree1);
-	    for (i = 0; i < Order2; i++)
-	        CpPts2[i] = Points2[l][i] * CagdIChooseK(i, Degree2);
-        
-            /* Do the convolution. */
-	    for (i = 0; i < Order1; i++) {
-		for (j = 0, ij = i; j < Order2; j++, ij++)
-		    PPts[ij] += CpPts1[i] * CpPts2[j];
-	    }
+        BzrCrvMultPtsVecs(Points1[l], Order1, Points2[l], Order2,
+			  ProdCrv -> Points[l]);
 
-	    /* Update the denominator combinatorial coefficient. */
-	    for (i = 0; i < ProdOrder; i++)
-	        PPts[i] /= CagdIChooseK(i, ProdDegree);
-	}
+    if (Crv1 != NULL) {
+        CagdCrvFree(Crv1);
+	CagdCrvFree(Crv2);
     }
 
-    CagdCrvFree(Crv1);
-    CagdCrvFree(Crv2);
-
     return ProdCrv;
 }
 
@@ -191,7 +134,8 @@ CagdCrvStruct *BzrCrvMult(const CagdCrvStruct *CCrv1,
 *   Pts2:    Second vector of scalars of second Bezier curve.                M
 *   Order2:  Order of second Bezier curve.				     M
 *   ProdPts: Result vector of scalars of product Bezier curve.  Result       M
-*	     vector is of length Order1+Order2-1.                            M
+*	     vector is of length Order1+Order2-1.  Zeroed if the product's   M
+*	     order is too large for its combinatorial coefficients.	     M
 *                                                                            *
 * RETURN VALUE:                                                              M
 *   void								     M
@@ -213,14 +157,18 @@ void BzrCrvMultPtsVecs(const CagdRType *Pts1,
     IRIT_STATIC_DATA CagdRType
 	*CpPts1 = NULL,
 	*CpPts2 = NULL;
-    int i, j, ij,
-	Degree1 = Order1 - 1,
-	Degree2 = Order2 - 1,
-	ProdOrder = Order1 + Order2 - 1,
-	ProdDegree = ProdOrder - 1;
+    int i, j,
+	ProdOrder = Order1 + Order2 - 1;
+    const CagdRType
+	*IChooseK1 = CagdIChooseKRow(Order1 - 1),
+	*IChooseK2 = CagdIChooseKRow(Order2 - 1),
+	*IChooseKProd = CagdIChooseKRow(ProdOrder - 1);
 
     IRIT_ZAP_MEM(ProdPts, sizeof(CagdRType) * ProdOrder);
 
+    if (IChooseK1 == NULL || IChooseK2 == NULL || IChooseKProd == NULL)
+        return;				     /* Order too large, error raised. */
+
     /* Allocate temporary data, if necessary. */
     if (CpPtsLen < IRIT_MAX(Order1, Order2)) {
         CpPtsLen = IRIT_MAX(Order1, Order2) * 2;
@@ -232,40 +180,26 @@ void BzrCrvMultPtsVecs(const CagdRType *Pts1,
 	CpPts2 = (CagdRType *) IritMalloc(sizeof(CagdRType) * CpPtsLen);
     }
 
-    if (ProdOrder < CAGD_MAX_BEZIER_CACHE_ORDER) {           /* Use cache. */
-        /* Place the combinatorial coefficients with the control points. */
-        for (i = 0; i < Order1; i++)
-	    CpPts1[i] = Pts1[i] * CagdIChooseKTable[Degree1][i];
-        for (i = 0; i < Order2; i++)
-	    CpPts2[i] = Pts2[i] * CagdIChooseKTable[Degree2][i];
+    /* Place the combinatorial coefficients with the control points. */
+    for (i = 0; i < Order1; i++)
+        CpPts1[i] = Pts1[i] * IChooseK1[i];
+    for (i = 0; i < Order2; i++)
+        CpPts2[i] = Pts2[i] * IChooseK2[i];
 
-	/* Do the convolution. */
-        for (i = 0; i < Order1; i++) {
-	    for (j = 0, ij = i; j < Order2; j++, ij++)
-		ProdPts[ij] += CpPts1[i] * CpPts2[j];
-	}
+    /* Do the convolution.  The inner loop runs over contiguous data with   */
+    /* no dependencies between iterations, so it vectorizes well.	    */
+    for (i = 0; i < Order1; i++) {
+        CagdRType
+	    r1 = CpPts1[i],
+	    *p = &ProdPts[i];
 
-        /* Update the denominator combinatorial coefficient. */
-        for (i = 0; i < ProdOrder; i++)
-	    ProdPts[i] /= CagdIChooseKTable[ProdDegree][i];
+	for (j = 0; j < Order2; j++)
+	    p[j] += r1 * CpPts2[j];
     }
-    else {
-        /* Place the combinatorial coefficients with the control points. */
-        for (i = 0; i < Order1; i++)
-	    CpPts1[i] = Pts1[i] * CagdIChooseK(i, Degree1);
-        for (i = 0; i < Order2; i++)
-	    CpPts2[i] = Pts2[i] * CagdIChooseK(i, Degree2);
 
-	/* Do the convolution. */
-        for (i = 0; i < Order1; i++) {
-	    for (j = 0, ij = i; j < Order2; j++, ij++)
-		ProdPts[ij] += CpPts1[i] * CpPts2[j];
-	}
-
-        /* Update the denominator combinatorial coefficient. */
-        for (i = 0; i < ProdOrder; i++)
-	    ProdPts[i] /= CagdIChooseK(i, ProdDegree);
-    }
+    /* Update the denominator combinatorial coefficient. */
+    for (i = 0; i < ProdOrder; i++)
+        ProdPts[i] /= IChooseKProd[i];
 }
 
 /*****************************************************************************
@@ -346,6 +280,8 @@ CagdSrfStruct *BzrSrfMult(const CagdSrfStruct *CSrf1,
 	*Srf1 = CagdSrfCopy(CSrf1),
         *Srf2 = CagdSrfCopy(CSrf2);
     CagdRType **PPoints, **Points1, **Points2;
+    const CagdRType *UIChooseK1, *VIChooseK1, *UIChooseK2, *VIChooseK2,
+	*UIChooseK, *VIChooseK;
 
     if (!CAGD_IS_BEZIER_SRF(CSrf1) || !CAGD_IS_BEZIER_SRF(CSrf2)) {
         CagdSrfFree(Srf1);
@@ -389,120 +325,85 @@ CagdSrfStruct *BzrSrfMult(const CagdSrfStruct *CSrf1,
     for (k = IsNotRational; k <= MaxCoord; k++)
 	IRIT_ZAP_MEM(PPoints[k], sizeof(CagdRType) * Size);
 
-    if (UOrder < CAGD_MAX_BEZIER_CACHE_ORDER &&
-	VOrder < CAGD_MAX_BEZIER_CACHE_ORDER) {
-        for (k = IsNotRational; k <= MaxCoord; k++) {
-	    CagdRType *p, *p1, *p2,
-	        *PPts = PPoints[k];
-
-	    /* Place the combinatorial coefficients with the control points. */
-	    for (p1 = Points1[k], p = CpPts1, j = l = 0; j < VOrder1; j++) {
-	        for (i = 0; i < UOrder1; i++, l++)
-		    *p++ = *p1++ * CagdIChooseKTable[VDegree1][j]
-				 * CagdIChooseKTable[UDegree1][i];
-	    }
-	    for (p2 = Points2[k], p = CpPts2, j = l = 0; j < VOrder2; j++) {
-	        for (i = 0; i < UOrder2; i++, l++)
-		    *p++ = *p2++ * CagdIChooseKTable[VDegree2][j]
-			  	 * CagdIChooseKTable[UDegree2][i];
-	    }
-
-	    /* Do the convolution. */
-	    for (j = 0; j < VOrder1; j++) {
-	        for (i = 0; i < UOrder1; i++) {
-		    CagdRType
-			r1 = CpPts1[CAGD_MESH_UV(Srf1, i, j)];
-
-		    p2 = CpPts2;
-
-		    for (m = 0; m < VOrder2; m++) {
-		        p = &PPts[CAGD_MESH_UV(ProdSrf, i, j + m)];
-
-			for (l = 0; l++ < UOrder2; )
-			    *p++ += r1 * *p2++;
-		    }
-		}
-	    }
-
-	    /* Update the denominator combinatorial coefficient. */
-	    for (j = 0; j < VOrder; j++) {
-	        p = &PPts[CAGD_MESH_UV(ProdSrf, 0, j)];
+    UIChooseK1 = CagdIChooseKRow(UDegree1);
+    VIChooseK1 = CagdIChooseKRow(VDegree1);
+    UIChooseK2 = CagdIChooseKRow(UDegree2);
+    VIChooseK2 = CagdIChooseKRow(VDegree2);
+    UIChooseK = CagdIChooseKRow(UDegree);
+    VIChooseK = CagdIChooseKRow(VDegree);
+    if (UIChooseK1 == NULL || VIChooseK1 == NULL ||
+	UIChooseK2 == NULL || VIChooseK2 == NULL ||
+	UIChooseK == NULL || VIChooseK == NULL) {
+        CagdSrfFree(Srf1);		     /* Order too large, error raised. */
+	CagdSrfFree(Srf2);
+	CagdSrfFree(ProdSrf);
+	return NULL;
+    }
 
-	        for (i = 0; i < UOrder; i++)
-		    *p++ /= CagdIChooseKTable[UDegree][i] *
-			    CagdIChooseKTable[VDegree][j];
-	    }
+    /* The original product - easier to follow but not so optimized.         */
+    /* 									     */
+    /* int il, jm;							     */
+    /* 									     */
+    /* for (i = 0; i < UOrder1; i++) {					     */
+    /*     for (j = 0; j < VOrder1; j++) {				     */
+    /*         for (l = 0, il = i; l < UOrder2; l++, il++) {		     */
+    /*             for (m = 0, jm = j; m < VOrder2; m++, jm++) {	     */
+    /*                 int Index = CAGD_MESH_UV(ProdSrf, il, jm),	     */
+    /*                     Index1 = CAGD_MESH_UV(Srf1, i, j),		     */
+    /*                     Index2 = CAGD_MESH_UV(Srf2, l, m);		     */
+    /*                 CagdRType					     */
+    /*                     Coef = CagdIChooseK(i, UDegree1) *		     */
+    /*                            CagdIChooseK(l, UDegree2) *		     */
+    /*                            CagdIChooseK(j, VDegree1) *		     */
+    /*                            CagdIChooseK(m, VDegree2) /		     */
+    /*                            (CagdIChooseK(il, UDegree) *		     */
+    /*                             CagdIChooseK(jm, VDegree));		     */
+    /*									     */
+    /*                 for (k = IsNotRational; k <= MaxCoord; k++)	     */
+    /*                     PPoints[k][Index] += Coef * 			     */
+    /*                         Points1[k][Index1] * Points2[k][Index2];      */
+    /*             }							     */
+    /*         }							     */
+    /*     }								     */
+    /* }								     */
+    for (k = IsNotRational; k <= MaxCoord; k++) {
+        CagdRType *p, *p1, *p2,
+	    *PPts = PPoints[k];
+
+	/* Place the combinatorial coefficients with the control points. */
+	for (p1 = Points1[k], p = CpPts1, j = 0; j < VOrder1; j++) {
+	    for (i = 0; i < UOrder1; i++)
+	        *p++ = *p1++ * VIChooseK1[j] * UIChooseK1[i];
+	}
+	for (p2 = Points2[k], p = CpPts2, j = 0; j < VOrder2; j++) {
+	    for (i = 0; i < UOrder2; i++)
+	        *p++ = *p2++ * VIChooseK2[j] * UIChooseK2[i];
 	}
-    }
-    else {
-	/* The original product - easier to follow but not so optimized.     */
-	/* 								     */
-        /* int il, jm;							     */
-	/* 								     */
-	/* for (i = 0; i < UOrder1; i++) {				     */
-	/*     for (j = 0; j < VOrder1; j++) {				     */
-        /*         for (l = 0, il = i; l < UOrder2; l++, il++) {	     */
-        /*             for (m = 0, jm = j; m < VOrder2; m++, jm++) {	     */
-        /*                 int Index = CAGD_MESH_UV(ProdSrf, il, jm),	     */
-        /*                     Index1 = CAGD_MESH_UV(Srf1, i, j),	     */
-        /*                     Index2 = CAGD_MESH_UV(Srf2, l, m);	     */
-        /*                 CagdRType					     */
-        /*                     Coef = CagdIChooseK(i, UDegree1) *	     */
-        /*                            CagdIChooseK(l, UDegree2) *	     */
-        /*                            CagdIChooseK(j, VDegree1) *	     */
-        /*                            CagdIChooseK(m, VDegree2) /	     */
-        /*                            (CagdIChooseK(il, UDegree) *	     */
-        /*                             CagdIChooseK(jm, VDegree));	     */
-        /*								     */
-        /*                 for (k = IsNotRational; k <= MaxCoord; k++)	     */
-        /*                     PPoints[k][Index] += Coef * 		     */
-        /*                         Points1[k][Index1] * Points2[k][Index2];  */
-        /*             }						     */
-        /*         }							     */
-        /*     }							     */
-	/* }								     */
-
-        for (k = IsNotRational; k <= MaxCoord; k++) {
-	    CagdRType *p, *p1, *p2,
-	        *PPts = PPoints[k];
-
-	    /* Place the combinatorial coefficients with the control points. */
-	    for (p1 = Points1[k], p = CpPts1, j = l = 0; j < VOrder1; j++) {
-	        for (i = 0; i < UOrder1; i++, l++)
-		    *p++ = *p1++ * CagdIChooseK(j, VDegree1)
-				 * CagdIChooseK(i, UDegree1);
-	    }
-	    for (p2 = Points2[k], p = CpPts2, j = l = 0; j < VOrder2; j++) {
-	        for (i = 0; i < UOrder2; i++, l++)
-		    *p++ = *p2++ * CagdIChooseK(j, VDegree2)
-				 * CagdIChooseK(i, UDegree2);
-	    }
 
-	    /* Do the convolution. */
-	    for (j = 0; j < VOrder1; j++) {
-	        for (i = 0; i < UOrder1; i++) {
-		    CagdRType
-			r1 = CpPts1[CAGD_MESH_UV(Srf1, i, j)];
+	/* Do the convolution. */
+	for (j = 0; j < VOrder1; j++) {
+	    for (i = 0; i < UOrder1; i++) {
+	        CagdRType
+		    r1 = CpPts1[CAGD_MESH_UV(Srf1, i, j)];
 
-		    p2 = CpPts2;
+		p2 = CpPts2;
 
-		    for (m = 0; m < VOrder2; m++) {
-		        p = &PPts[CAGD_MESH_UV(ProdSrf, i, j + m)];
+		for (m = 0; m < VOrder2; m++) {
+		    p = &PPts[CAGD_MESH_UV(ProdSrf, i, j + m)];
 
-		        for (l = 0; l++ < UOrder2; )
-			    *p++ += r1 * *p2++;
-		    }
+		    for (l = 0; l < UOrder2; l++)
+		        p[l] += r1 * p2[l];
+		    p2 += UOrder2;
 		}
 	    }
+	}
 
-	    /* Update the denominator combinatorial coefficient. */
-	    for (j = 0; j < VOrder; j++) {
-	        p = &PPts[CAGD_MESH_UV(ProdSrf, 0, j)];
+	/* Update the denominator combinatorial coefficient. */
+	for (j = 0; j < VOrder; j++) {
+	    p = &PPts[CAGD_MESH_UV(ProdSrf, 0, j)];
 
-	        for (i = 0; i < UOrder; i++)
-		    *p++ /= CagdIChooseK(i, UDegree) *
-			    CagdIChooseK(j, VDegree);
-	    }
+	    for (i = 0; i < UOrder; i++)
+	        *p++ /= UIChooseK[i] * VIChooseK[j];
 	}
     }
 
@@ -20,12 +20,30 @@
 #define CONTOUR_EPS   5.6*.38841e-8 /* Level above zero to actually contour. */
 #define CNTR_DIAGONAL_EPS		1e-3
 
-static int GetMatchedTrimParameter(const CagdCrvStruct *Crv,
-				   CagdPtStruct *Pts,
-				   CagdPtStruct **Pt1,
-				   int *Idx1,
-				   CagdPtStruct **Pt2,
-				   int *Idx2);
+typedef struct OffsetTrimEndPtStruct {
+    CagdPtStruct *Pt;		      /* The valid domain this end point is in. */
+    int Idx;				  /* Either 0 (start) or 1 (end) of Pt. */
+    int Matched;
+    CagdPType Pos;			 /* Euclidean (E2) location on curve. */
+} OffsetTrimEndPtStruct;
+
+typedef struct OffsetTrimPairStruct {
+    CagdRType DistSqr;
+    int Order;		  /* Enumeration order, to break ties consistently. */
+    int EndPt1, EndPt2;
+} OffsetTrimPairStruct;
+
+#if defined(ultrix) && defined(mips)
+static int OffsetTrimPairSortCmpr(VoidPtr VPair1, VoidPtr VPair2);
+#else
+static int OffsetTrimPairSortCmpr(const VoidPtr VPair1, const VoidPtr VPair2);
+#endif /* ultrix && mips (no const support) */
+static void MatchAndImproveTrimParameters(const CagdCrvStruct *Crv,
+					  const CagdCrvStruct *DCrv,
+					  CagdPtStruct *Pts,
+					  CagdRType TMin,
+					  CagdRType TMax,
+					  CagdRType NumerTol);
 static CagdPtStruct *ExtractValidDomainFromContours(IPPolygonStruct *Cntrs);
 static void InsertInvalidDomainIntoList(CagdPtStruct **PtList,
 					CagdRType TMin,
@@ -1391,24 +1409,11 @@ CagdCrvStruct *SymbCrvTrimGlblOffsetSelfInter(const CagdCrvStruct *Crv,
     CagdCrvDomain(Crv, &TMin, &TMax);
 
     if (NumerTol > 0.0) {
-	int Idx1, Idx2;
-	CagdPtStruct *Pt1, *Pt2;
-
 	DCrv = CagdCrvDerive(OffCrv);
 
-	/* Mark the end points if on the original boundary as unused. */
-	if (IRIT_APX_EQ(ValidDomains -> Pt[0], TMin))
-	    AttrSetIntAttrib(&ValidDomains -> Attr, "_MtchedStrt", TRUE);
-	Pt1 = CagdListLast(ValidDomains);
-	if (IRIT_APX_EQ(Pt1 -> Pt[0], TMax))
-	    AttrSetIntAttrib(&Pt1 -> Attr, "_MtchedEnd", TRUE);
-
 	/* Improve as much as we can and while we can. */
-        while (GetMatchedTrimParameter(OffCrv, ValidDomains,
-				       &Pt1, &Idx1, &Pt2, &Idx2)) {
-    	    OffsetGlblTrimUpdateInter(OffCrv, DCrv, &Pt1 -> Pt[Idx1],
-				      &Pt2 -> Pt[Idx2], NumerTol);
-	}
+	MatchAndImproveTrimParameters(OffCrv, DCrv, ValidDomains,
+				      TMin, TMax, NumerTol);
     }
 
     for (Pt = ValidDomains; Pt != NULL; Pt = Pt -> Pnext) {
@@ -1427,128 +1432,134 @@ CagdCrvStruct *SymbCrvTrimGlblOffsetSelfInter(const CagdCrvStruct *Crv,
 
 /*****************************************************************************
 * DESCRIPTION:                                                               *
-*   Get the closest pair among all possible matches to try and improve it    *
-* numerically.  Closest is measured in Euclidean space.                      *
-*   The end points locations are ignored as possible macthes.                *
+*   Routine to compare two end point pairs for sorting purposes.  Pairs are  *
+* ordered by their distance and then by their enumeration order.             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   VPair1, VPair2:  Two pointers to OffsetTrimPairStruct.                   *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   >0, 0, or <0 as the relation between the two pairs.               *
+*****************************************************************************/
+#if defined(ultrix) && defined(mips)
+static int OffsetTrimPairSortCmpr(VoidPtr VPair1, VoidPtr VPair2)
+#else
+static int OffsetTrimPairSortCmpr(const VoidPtr VPair1, const VoidPtr VPair2)
+#endif /* ultrix && mips (no const support) */
+{
+    const OffsetTrimPairStruct
+	*Pair1 = (const OffsetTrimPairStruct *) VPair1,
+	*Pair2 = (const OffsetTrimPairStruct *) VPair2;
+
+    if (Pair1 -> DistSqr != Pair2 -> DistSqr)
+        return Pair1 -> DistSqr < Pair2 -> DistSqr ? -1 : 1;
+
+    return Pair1 -> Order - Pair2 -> Order;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Repeatedly match the closest pair among all possible unmatched end       *
+* points of the valid domains and improve it numerically.  Closest is        *
+* measured in Euclidean space.                                               *
+*   The end points locations on the original boundary are ignored as        *
+* possible macthes.                                                          *
+*   Since every improvement only moves the two end points it matched, the    *
+* end points are evaluated once and all candidate pairs are sorted by        *
+* distance up front, so the greedy matching is one pass over sorted pairs    *
+* rather than a full rescan (and curve evaluations) per matched pair.        *
 *                                                                            *
 * PARAMETERS:                                                                *
 *   Crv:       The curve to look for closest point.                          *
-*   Pts:       List of points to search for best match.			     *
-*   Pt1:       First matched entry.					     *
-*   Idx1:      Index in the first matched entry, either 0 or 1.		     *
-*   Pt2:       Second matched entry.					     *
-*   Idx2:      Index in the second matched entry, either 0 or 1.	     *
+*   DCrv:      The derivative curve of Crv.                                  *
+*   Pts:       List of valid domains to search for best matches.	     *
+*   TMin, TMax: Parametric domain of the original curve.		     *
+*   NumerTol:  Tolerance of the numeric improvement.                         *
 *                                                                            *
 * RETURN VALUE:                                                              *
-*   int:       TRUE of found match, FALSE otherwise.                         *
+*   void                                                                     *
 *****************************************************************************/
-static int GetMatchedTrimParameter(const CagdCrvStruct *Crv,
-				   CagdPtStruct *Pts,
-				   CagdPtStruct **Pt1,
-				   int *Idx1,
-				   CagdPtStruct **Pt2,
-				   int *Idx2)
+static void MatchAndImproveTrimParameters(const CagdCrvStruct *Crv,
+					  const CagdCrvStruct *DCrv,
+					  CagdPtStruct *Pts,
+					  CagdRType TMin,
+					  CagdRType TMax,
+					  CagdRType NumerTol)
 {
-    int MinIndx1 = -1,
-	MinIndx2 = -1;
-    CagdPtStruct *PtFirst, *PtSecond,
-	*MinPt1 = NULL,
-	*MinPt2 = NULL;
-    CagdRType DistSqr, *R,
-	MinDistSqr = IRIT_INFNTY;
-    CagdPType PtE2Tmp1, PtE2Tmp2;
-
-    for (PtFirst = Pts; PtFirst != NULL; PtFirst = PtFirst -> Pnext) {
-	for (PtSecond = PtFirst -> Pnext;
-	     PtSecond != NULL;
-	     PtSecond = PtSecond -> Pnext) {
-	    if (AttrGetIntAttrib(PtFirst -> Attr, "_MtchedStrt") != TRUE &&
-		AttrGetIntAttrib(PtSecond -> Attr, "_MtchedStrt") != TRUE) {
-	        R = CagdCrvEval(Crv, PtFirst -> Pt[0]);
-		CagdCoerceToE2(PtE2Tmp1, &R, -1, Crv -> PType);
-		R = CagdCrvEval(Crv, PtSecond -> Pt[0]);
-		CagdCoerceToE2(PtE2Tmp2, &R, -1, Crv -> PType);
-
-		DistSqr = IRIT_PT2D_DIST_SQR(PtE2Tmp1, PtE2Tmp2);
-		if (MinDistSqr > DistSqr) {
-		    MinDistSqr = DistSqr;
-		    MinIndx1 = 0;
-		    MinIndx2 = 0;
-		    MinPt1 = PtFirst;
-		    MinPt2 = PtSecond;
-		}
-	    }
-	    if (AttrGetIntAttrib(PtFirst -> Attr, "_MtchedStrt") != TRUE &&
-		AttrGetIntAttrib(PtSecond -> Attr, "_MtchedEnd") != TRUE) {
-	        R = CagdCrvEval(Crv, PtFirst -> Pt[0]);
-		CagdCoerceToE2(PtE2Tmp1, &R, -1, Crv -> PType);
-		R = CagdCrvEval(Crv, PtSecond -> Pt[1]);
-		CagdCoerceToE2(PtE2Tmp2, &R, -1, Crv -> PType);
-
-		DistSqr = IRIT_PT2D_DIST_SQR(PtE2Tmp1, PtE2Tmp2);
-		if (MinDistSqr > DistSqr) {
-		    MinDistSqr = DistSqr;
-		    MinIndx1 = 0;
-		    MinIndx2 = 1;
-		    MinPt1 = PtFirst;
-		    MinPt2 = PtSecond;
-		}
-	    }
-	    if (AttrGetIntAttrib(PtFirst -> Attr, "_MtchedEnd") != TRUE &&
-		AttrGetIntAttrib(PtSecond -> Attr, "_MtchedEnd") != TRUE) {
-	        R = CagdCrvEval(Crv, PtFirst -> Pt[1]);
-		CagdCoerceToE2(PtE2Tmp1, &R, -1, Crv -> PType);
-		R = CagdCrvEval(Crv, PtSecond -> Pt[1]);
-		CagdCoerceToE2(PtE2Tmp2, &R, -1, Crv -> PType);
-
-		DistSqr = IRIT_PT2D_DIST_SQR(PtE2Tmp1, PtE2Tmp2);
-		if (MinDistSqr > DistSqr) {
-		    MinDistSqr = DistSqr;
-		    MinIndx1 = 1;
-		    MinIndx2 = 1;
-		    MinPt1 = PtFirst;
-		    MinPt2 = PtSecond;
-		}
-	    }
-	    if (AttrGetIntAttrib(PtFirst -> Attr, "_MtchedEnd") != TRUE &&
-		AttrGetIntAttrib(PtSecond -> Attr, "_MtchedStrt") != TRUE) {
-	        R = CagdCrvEval(Crv, PtFirst -> Pt[1]);
-		CagdCoerceToE2(PtE2Tmp1, &R, -1, Crv -> PType);
-		R = CagdCrvEval(Crv, PtSecond -> Pt[0]);
-		CagdCoerceToE2(PtE2Tmp2, &R, -1, Crv -> PType);
-
-		DistSqr = IRIT_PT2D_DIST_SQR(PtE2Tmp1, PtE2Tmp2);
-		if (MinDistSqr > DistSqr) {
-		    MinDistSqr = DistSqr;
-		    MinIndx1 = 1;
-		    MinIndx2 = 0;
-		    MinPt1 = PtFirst;
-		    MinPt2 = PtSecond;
-		}
+    IRIT_STATIC_DATA const int
+        PairIdx[4][2] = { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 1, 0 } };
+    int i, j, k, n, NumEndPts, NumPairs;
+    CagdRType *R;
+    CagdPtStruct *Pt;
+    OffsetTrimEndPtStruct *EndPts;
+    OffsetTrimPairStruct *Pairs;
+
+    if ((n = CagdListLength(Pts)) < 2)
+        return;
+
+    /* Evaluate all end points once. */
+    NumEndPts = n * 2;
+    EndPts = (OffsetTrimEndPtStruct *)
+			 IritMalloc(sizeof(OffsetTrimEndPtStruct) * NumEndPts);
+    for (Pt = Pts, i = 0; Pt != NULL; Pt = Pt -> Pnext) {
+        for (j = 0; j < 2; j++, i++) {
+	    EndPts[i].Pt = Pt;
+	    EndPts[i].Idx = j;
+	    EndPts[i].Matched = FALSE;
+	    R = CagdCrvEval(Crv, Pt -> Pt[j]);
+	    CagdCoerceToE2(EndPts[i].Pos, &R, -1, Crv -> PType);
+	}
+    }
+
+    /* Mark the end points if on the original boundary as unused. */
+    if (IRIT_APX_EQ(Pts -> Pt[0], TMin))
+        EndPts[0].Matched = TRUE;
+    if (IRIT_APX_EQ(EndPts[NumEndPts - 1].Pt -> Pt[0], TMax))
+        EndPts[NumEndPts - 1].Matched = TRUE;
+
+    /* Build all candidate pairs between end points of different domains. */
+    NumPairs = n * (n - 1) * 2;
+    Pairs = (OffsetTrimPairStruct *)
+			  IritMalloc(sizeof(OffsetTrimPairStruct) * NumPairs);
+    for (i = k = 0; i < n; i++) {
+        for (j = i + 1; j < n; j++) {
+	    int l;
+
+	    for (l = 0; l < 4; l++, k++) {
+	        int EndPt1 = i * 2 + PairIdx[l][0],
+		    EndPt2 = j * 2 + PairIdx[l][1];
+
+		Pairs[k].DistSqr = IRIT_PT2D_DIST_SQR(EndPts[EndPt1].Pos,
+						      EndPts[EndPt2].Pos);
+		Pairs[k].Order = k;
+		Pairs[k].EndPt1 = EndPt1;
+		Pairs[k].EndPt2 = EndPt2;
 	    }
-        }
+	}
     }
 
-    if (MinPt1 != NULL && MinPt2 != NULL) {
-	if (MinIndx1 == 1)
-	    AttrSetIntAttrib(&MinPt1 -> Attr, "_MtchedEnd", TRUE);
-	else
-	    AttrSetIntAttrib(&MinPt1 -> Attr, "_MtchedStrt", TRUE);
+    qsort(Pairs, NumPairs, sizeof(OffsetTrimPairStruct),
+	  OffsetTrimPairSortCmpr);
 
-	if (MinIndx2 == 1)
-	    AttrSetIntAttrib(&MinPt2 -> Attr, "_MtchedEnd", TRUE);
-	else
-	    AttrSetIntAttrib(&MinPt2 -> Attr, "_MtchedStrt", TRUE);
+    /* Greedily match closest pairs whose both end points are unmatched. */
+    for (k = 0; k < NumPairs; k++) {
+        OffsetTrimEndPtStruct
+	    *EndPt1 = &EndPts[Pairs[k].EndPt1],
+	    *EndPt2 = &EndPts[Pairs[k].EndPt2];
 
-	*Idx1 = MinIndx1;
-	*Idx2 = MinIndx2;
-	*Pt1 = MinPt1;
-	*Pt2 = MinPt2;
+	if (EndPt1 -> Matched || EndPt2 -> Matched)
+	    continue;
 
-	return TRUE;
+	EndPt1 -> Matched = EndPt2 -> Matched = TRUE;
+
+	OffsetGlblTrimUpdateInter(Crv, DCrv,
+				  &EndPt1 -> Pt -> Pt[EndPt1 -> Idx],
+				  &EndPt2 -> Pt -> Pt[EndPt2 -> Idx],
+				  NumerTol);
     }
-    else
-        return FALSE;
+
+    IritFree(Pairs);
+    IritFree(EndPts);
 }
 
 /*****************************************************************************
@@ -0,0 +1,1354 @@
+/*****************************************************************************
+* Smoke tests of the batched, indexed and streamed library entry points.     *
+* Every test computes the same result through the new entry point and        *
+* through the older (one at a time or fully kept) code path and compares.    *
+* Prints one line per test and exits with the number of failed tests.        *
+******************************************************************************
+* (C) Gershon Elber, Technion, Israel Institute of Technology                *
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "irit_sm.h"
+#include "iritprsr.h"
+#include "allocate.h"
+#include "attribut.h"
+#include "cagd_lib.h"
+#include "geom_lib.h"
+#include "trim_lib.h"
+#include "triv_lib.h"
+#include "trng_lib.h"
+#include "mdl_lib.h"
+#include "mrchcube.h"
+#include "rndr_lib.h"
+#include "user_lib.h"
+
+#define SMOKE_EPS		1e-9
+#define SMOKE_VOL_SIZE		16
+#define SMOKE_MASK_SIZE		5
+
+#define SMOKE_UV_APX_EQ(UV1, UV2, Eps) \
+		(IRIT_APX_EQ_EPS((UV1)[0], (UV2)[0], Eps) && \
+		 IRIT_APX_EQ_EPS((UV1)[1], (UV2)[1], Eps))
+
+#define SMOKE_IBD_FILE		"_smoke.ibd"
+#define SMOKE_VOL_FILE		"_smoke.vol"
+#define SMOKE_NC_FILE		"_smoke.nc"
+
+typedef int (*SmokeTestFuncType)(void);
+
+typedef struct SmokeTestStruct {
+    const char *Name;
+    SmokeTestFuncType Func;
+} SmokeTestStruct;
+
+static CagdRType SmokeRand(CagdRType Min, CagdRType Max);
+static CagdRType SmokePlsArea(const IPPolygonStruct *Pls);
+static CagdRType SmokePlsSumCoords(const IPPolygonStruct *Pls);
+#if defined(ultrix) && defined(mips)
+static int SmokeCmpInts(VoidPtr I1, VoidPtr I2);
+#else
+static int SmokeCmpInts(const VoidPtr I1, const VoidPtr I2);
+#endif /* ultrix && mips (no const support) */
+static CagdSrfStruct *SmokeBumpBzrSrf(void);
+static TrimSrfStruct *SmokeHoledTrimSrf(const CagdSrfStruct *Srf);
+static TrivTVStruct *SmokeTV(void);
+static int SmokeIChooseKRow(void);
+static int SmokeAlphaCoefCache(void);
+static int SmokeTrivTVEvalPts(void);
+static int SmokeTrivFFDPolygons(void);
+static int SmokeMCIsoSurfaceIdx(void);
+static int SmokeTrngTriSrfEvalGrid(void);
+static int SmokeGMSubSrfsRefine(void);
+static int SmokeGMPolyVrtxAdj(void);
+static int SmokeGMPlCrvtrEvalVrtcs(void);
+static int SmokeGMPolyMeshTaubinSmoothing(void);
+static int SmokeIndexedDataFile(void);
+static int SmokeNCGCodeStreaming(void);
+static int SmokeNCMaskAlongLine(void);
+static int SmokeSrfsHierarchy(void);
+static int SmokeRayTraceSrfsPacket(void);
+static int SmokeTrimRayTraceSrfsPacket(void);
+static int SmokeMdl2TrimmedSrfs2(void);
+
+IRIT_STATIC_DATA SmokeTestStruct SmokeTests[] = {
+    { "CagdIChooseKRow",		SmokeIChooseKRow },
+    { "BspKnotSetAlphaCoefCacheSize",	SmokeAlphaCoefCache },
+    { "TrivTVEvalPts",			SmokeTrivTVEvalPts },
+    { "TrivFFDPolygons",		SmokeTrivFFDPolygons },
+    { "MCExtractIsoSurfaceIdx",		SmokeMCIsoSurfaceIdx },
+    { "TrngTriSrfEvalGrid",		SmokeTrngTriSrfEvalGrid },
+    { "GMSubSrfsRefine",		SmokeGMSubSrfsRefine },
+    { "GMPolyVrtxAdjNew",		SmokeGMPolyVrtxAdj },
+    { "GMPlCrvtrEvalVrtcs",		SmokeGMPlCrvtrEvalVrtcs },
+    { "GMPolyMeshTaubinSmoothing",	SmokeGMPolyMeshTaubinSmoothing },
+    { "IPGetIndexedObjectByName",	SmokeIndexedDataFile },
+    { "IPNCGCodeLoadFileLength",	SmokeNCGCodeStreaming },
+    { "INCRndrPutMaskAlongLine",	SmokeNCMaskAlongLine },
+    { "IntrSrfsHierarchyTestRays",	SmokeSrfsHierarchy },
+    { "CagdRayTraceSrfsPacket",		SmokeRayTraceSrfsPacket },
+    { "TrimRayTraceSrfsPacket",		SmokeTrimRayTraceSrfsPacket },
+    { "MdlCnvrtMdl2TrimmedSrfs2",	SmokeMdl2TrimmedSrfs2 },
+    { NULL, NULL }
+};
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+* Main module of smoke - runs all the tests.				     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   argc, argv:   Command line.                                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    Number of failed tests.                                          *
+*****************************************************************************/
+int main(int argc, char **argv)
+{
+    int i,
+	NumFailed = 0;
+
+    for (i = 0; SmokeTests[i].Name != NULL; i++) {
+        int Success = SmokeTests[i].Func();
+
+	printf("%-32s %s\n", SmokeTests[i].Name, Success ? "o.k." : "FAILED");
+	if (!Success)
+	    NumFailed++;
+    }
+
+    remove(SMOKE_IBD_FILE);
+    remove(SMOKE_VOL_FILE);
+    remove(SMOKE_NC_FILE);
+
+    return NumFailed;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Returns a pseudo random number between Min and Max.                      *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Min, Max:  Range of the number.                                          *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdRType:  A pseudo random number.                                      *
+*****************************************************************************/
+static CagdRType SmokeRand(CagdRType Min, CagdRType Max)
+{
+    return Min + (Max - Min) * (rand() / (CagdRType) RAND_MAX);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the total area of the given polygons.                           *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Pls:    Polygons to compute their area.                                  *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdRType:  Total area.                                                  *
+*****************************************************************************/
+static CagdRType SmokePlsArea(const IPPolygonStruct *Pls)
+{
+    CagdRType
+	Area = 0.0;
+
+    for ( ; Pls != NULL; Pls = Pls -> Pnext)
+        Area += GMPolyOnePolyArea(Pls);
+
+    return Area;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Sums all the coordinates of all the vertices of the given polygons, as   *
+* an order independent signature of their geometry.                          *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Pls:    Polygons to sum their vertices.                                  *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdRType:  Sum of all coordinates.                                      *
+*****************************************************************************/
+static CagdRType SmokePlsSumCoords(const IPPolygonStruct *Pls)
+{
+    CagdRType
+	Sum = 0.0;
+
+    for ( ; Pls != NULL; Pls = Pls -> Pnext) {
+        const IPVertexStruct
+	    *V = Pls -> PVertex;
+
+	do {
+	    Sum += V -> Coord[0] + V -> Coord[1] + V -> Coord[2];
+	    V = V -> Pnext;
+	}
+	while (V != NULL && V != Pls -> PVertex);
+    }
+
+    return Sum;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares two integers for qsort.                                         *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   I1, I2:    The two integers to compare.                                  *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:       Negative, zero, positive as I1 is smaller, equal or larger.   *
+*****************************************************************************/
+#if defined(ultrix) && defined(mips)
+static int SmokeCmpInts(VoidPtr I1, VoidPtr I2)
+#else
+static int SmokeCmpInts(const VoidPtr I1, const VoidPtr I2)
+#endif /* ultrix && mips (no const support) */
+{
+    return *((int *) I1) - *((int *) I2);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Constructs a bumpy biquadratic Bezier surface over [0,1]^2, in E3.       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdSrfStruct *:  The surface.                                           *
+*****************************************************************************/
+static CagdSrfStruct *SmokeBumpBzrSrf(void)
+{
+    int i, j;
+    CagdSrfStruct
+	*Srf = BzrSrfNew(3, 3, CAGD_PT_E3_TYPE);
+
+    for (j = 0; j < 3; j++) {
+        for (i = 0; i < 3; i++) {
+	    int Idx = CAGD_MESH_UV(Srf, i, j);
+
+	    Srf -> Points[1][Idx] = i * 0.5;
+	    Srf -> Points[2][Idx] = j * 0.5;
+	    Srf -> Points[3][Idx] = i == 1 && j == 1 ? 0.5 : 0.0;
+	}
+    }
+
+    return Srf;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Constructs a trimmed surface out of a copy of Srf, with a square hole    *
+* in the middle of its [0,1]^2 domain.					     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Srf:    Surface to trim, defined over [0,1]^2.                           *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   TrimSrfStruct *:  The trimmed surface.                                   *
+*****************************************************************************/
+static TrimSrfStruct *SmokeHoledTrimSrf(const CagdSrfStruct *Srf)
+{
+    IRIT_STATIC_DATA CagdRType
+	Square[5][2] = {
+	    { 0.25, 0.25 },
+	    { 0.75, 0.25 },
+	    { 0.75, 0.75 },
+	    { 0.25, 0.75 },
+	    { 0.25, 0.25 }
+	};
+    int i;
+    CagdCrvStruct
+	*UVCrv = BspCrvNew(5, 2, CAGD_PT_E2_TYPE);
+
+    BspKnotUniformOpen(5, 2, UVCrv -> KnotVector);
+    for (i = 0; i < 5; i++) {
+        UVCrv -> Points[1][i] = Square[i][0];
+        UVCrv -> Points[2][i] = Square[i][1];
+    }
+
+    return TrimSrfNew(CagdSrfCopy(Srf),
+		      TrimCrvNew(TrimCrvSegNew(UVCrv, NULL)), TRUE);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Constructs a perturbed quadratic B-spline trivariate over [0,1]^3 in E3. *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   TrivTVStruct *:  The trivariate.                                         *
+*****************************************************************************/
+static TrivTVStruct *SmokeTV(void)
+{
+    int i, j, k;
+    TrivTVStruct
+	*TV = TrivBspTVNew(4, 4, 4, 3, 3, 3, CAGD_PT_E3_TYPE);
+
+    BspKnotUniformOpen(4, 3, TV -> UKnotVector);
+    BspKnotUniformOpen(4, 3, TV -> VKnotVector);
+    BspKnotUniformOpen(4, 3, TV -> WKnotVector);
+
+    for (k = 0; k < 4; k++) {
+        for (j = 0; j < 4; j++) {
+	    for (i = 0; i < 4; i++) {
+	        int Idx = TRIV_MESH_UVW(TV, i, j, k);
+
+		TV -> Points[1][Idx] = i / 3.0 + SmokeRand(-0.1, 0.1);
+		TV -> Points[2][Idx] = j / 3.0 + SmokeRand(-0.1, 0.1);
+		TV -> Points[3][Idx] = k / 3.0 + SmokeRand(-0.1, 0.1);
+	    }
+	}
+    }
+
+    return TV;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the rows of CagdIChooseKRow with CagdIChooseK.                  *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeIChooseKRow(void)
+{
+    IRIT_STATIC_DATA int
+	Ks[] = { 0, 1, 5, 12, 40, 41, 100, 333, 1000, -1 };
+    int i, k;
+
+    for (k = 0; Ks[k] >= 0; k++) {
+        const CagdRType
+	    *Row = CagdIChooseKRow(Ks[k]);
+
+	if (Row == NULL)
+	    return FALSE;
+
+	for (i = 0; i <= Ks[k]; i++) {
+	    CagdRType
+		c = CagdIChooseK(i, Ks[k]);
+
+	    if (IRIT_FABS(Row[i] - c) > SMOKE_EPS * c)
+	        return FALSE;
+	}
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares curve refinements with and without the alpha matrix cache.      *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeAlphaCoefCache(void)
+{
+    int i, OldSize,
+	Success = TRUE;
+    CagdRType t[7];
+    CagdCrvStruct *RefCrv, *CachedCrv,
+	*Crv = BspCrvNew(8, 4, CAGD_PT_E3_TYPE);
+
+    BspKnotUniformOpen(8, 4, Crv -> KnotVector);
+    for (i = 0; i < 8; i++) {
+        Crv -> Points[1][i] = i;
+        Crv -> Points[2][i] = SmokeRand(-1.0, 1.0);
+        Crv -> Points[3][i] = SmokeRand(-1.0, 1.0);
+    }
+    for (i = 0; i < 7; i++)
+        t[i] = (i + 0.5) / 7.0;
+
+    OldSize = BspKnotSetAlphaCoefCacheSize(0);
+    RefCrv = BspCrvKnotInsertNDiff(Crv, FALSE, t, 7);
+
+    BspKnotSetAlphaCoefCacheSize(CAGD_DEF_ALPHA_COEF_CACHE_SIZE);
+    for (i = 0; i < 3; i++) {	       /* Second time on hits the cache. */
+        CachedCrv = BspCrvKnotInsertNDiff(Crv, FALSE, t, 7);
+	if (!CagdCrvsSame(RefCrv, CachedCrv, SMOKE_EPS))
+	    Success = FALSE;
+	CagdCrvFree(CachedCrv);
+    }
+    BspKnotSetAlphaCoefCacheSize(OldSize);
+
+    CagdCrvFree(RefCrv);
+    CagdCrvFree(Crv);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares TrivTVEvalPts with TrivTVEval and with finite differences.      *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeTrivTVEvalPts(void)
+{
+    int i, j, l,
+	n = 100,
+	Success = TRUE;
+    CagdPType *Params;
+    TrivTVBlockEvalStruct *Evals;
+    TrivTVStruct
+	*TV = SmokeTV();
+
+    Params = (CagdPType *) IritMalloc(sizeof(CagdPType) * n);
+    for (i = 0; i < n; i++) {
+        for (l = 0; l < 3; l++)
+	    Params[i][l] = SmokeRand(0.01, 0.99);
+    }
+    Evals = TrivTVEvalPts(TV, (const CagdPType *) Params, n, TRUE);
+
+    for (i = 0; i < n && Success; i++) {
+        CagdRType
+	    *R = TrivTVEval(TV, Params[i][0], Params[i][1], Params[i][2]);
+
+	for (l = 0; l < 3; l++) {
+	    if (!IRIT_APX_EQ_EPS(R[l + 1], Evals[i].Pos[l], SMOKE_EPS))
+	        Success = FALSE;
+	}
+
+	/* Central differences of the position, for the Jacobian. */
+	for (j = 0; j < 3; j++) {
+	    CagdPType Pm, Pp;
+
+	    IRIT_PT_COPY(Pm, Params[i]);
+	    IRIT_PT_COPY(Pp, Params[i]);
+	    Pm[j] -= 1e-6;
+	    Pp[j] += 1e-6;
+	    R = TrivTVEval(TV, Pm[0], Pm[1], Pm[2]);
+	    IRIT_PT_COPY(Pm, &R[1]);
+	    R = TrivTVEval(TV, Pp[0], Pp[1], Pp[2]);
+	    IRIT_PT_COPY(Pp, &R[1]);
+
+	    for (l = 0; l < 3; l++) {
+	        if (!IRIT_APX_EQ_EPS((Pp[l] - Pm[l]) / 2e-6,
+				     Evals[i].Jcbn[j][l], 1e-4))
+		    Success = FALSE;
+	    }
+	}
+    }
+
+    IritFree(Evals);
+    IritFree(Params);
+    TrivTVFree(TV);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares TrivFFDPolygons with mapping every vertex using TrivTVEval.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeTrivFFDPolygons(void)
+{
+    int Success = TRUE;
+    IrtVecType
+	Center = { 0.5, 0.5, 0.5 };
+    IPPolygonStruct *Pl, *FFDPl;
+    IPObjectStruct
+	*PObj = PrimGenSPHEREObject(Center, 0.4),
+	*FFDObj = IPCopyObject(NULL, PObj, FALSE);
+    TrivTVStruct
+	*TV = SmokeTV();
+
+    TrivFFDPolygons(TV, FFDObj -> U.Pl);
+
+    for (Pl = PObj -> U.Pl, FFDPl = FFDObj -> U.Pl;
+	 Pl != NULL && FFDPl != NULL && Success;
+	 Pl = Pl -> Pnext, FFDPl = FFDPl -> Pnext) {
+        IPVertexStruct
+	    *V = Pl -> PVertex,
+	    *FFDV = FFDPl -> PVertex;
+
+	do {
+	    CagdRType
+		*R = TrivTVEval(TV, V -> Coord[0], V -> Coord[1],
+				V -> Coord[2]);
+
+	    if (!IRIT_PT_APX_EQ_EPS(&R[1], FFDV -> Coord, SMOKE_EPS))
+	        Success = FALSE;
+
+	    V = V -> Pnext;
+	    FFDV = FFDV -> Pnext;
+	}
+	while (V != NULL && V != Pl -> PVertex);
+    }
+
+    IPFreeObject(PObj);
+    IPFreeObject(FFDObj);
+    TrivTVFree(TV);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares MCExtractIsoSurfaceIdx with MCExtractIsoSurface, over a volume  *
+* of the distance from the center of the volume.                             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeMCIsoSurfaceIdx(void)
+{
+    int i, j, k,
+	Success = TRUE;
+    CagdRType
+	Area = 0.0,
+	c = (SMOKE_VOL_SIZE - 1) * 0.5;
+    IrtPtType
+	CubeDim = { 1.0, 1.0, 1.0 };
+    IPObjectStruct *PObj;
+    IPPolyVrtxIdxStruct *PVIdx;
+    FILE *f;
+
+    if ((f = fopen(SMOKE_VOL_FILE, "wb")) == NULL)
+        return FALSE;
+    for (k = 0; k < SMOKE_VOL_SIZE; k++) {
+        for (j = 0; j < SMOKE_VOL_SIZE; j++) {
+	    for (i = 0; i < SMOKE_VOL_SIZE; i++) {
+	        double
+		    d = sqrt(IRIT_SQR(i - c) + IRIT_SQR(j - c) +
+			     IRIT_SQR(k - c));
+
+		fwrite(&d, sizeof(double), 1, f);
+	    }
+	}
+    }
+    fclose(f);
+
+    PObj = MCExtractIsoSurface(SMOKE_VOL_FILE, 6, CubeDim, SMOKE_VOL_SIZE,
+			       SMOKE_VOL_SIZE, SMOKE_VOL_SIZE, 1, c * 0.7);
+    PVIdx = MCExtractIsoSurfaceIdx(SMOKE_VOL_FILE, 6, CubeDim,
+				   SMOKE_VOL_SIZE, SMOKE_VOL_SIZE,
+				   SMOKE_VOL_SIZE, 1, c * 0.7);
+    if (PObj == NULL || PVIdx == NULL) {
+        Success = FALSE;
+    }
+    else {
+        /* Compare the areas, as the polygons of the old path are not      */
+	/* necessarily triangles.					    */
+        for (i = 0; i < PVIdx -> NumPlys; i++) {
+	    int *Idx = PVIdx -> Polygons[i];
+	    IrtVecType V1, V2, Nrml;
+
+	    IRIT_PT_SUB(V1, PVIdx -> Vertices[Idx[1]] -> Coord,
+			    PVIdx -> Vertices[Idx[0]] -> Coord);
+	    IRIT_PT_SUB(V2, PVIdx -> Vertices[Idx[2]] -> Coord,
+			    PVIdx -> Vertices[Idx[0]] -> Coord);
+	    IRIT_CROSS_PROD(Nrml, V1, V2);
+	    Area += IRIT_VEC_LENGTH(Nrml) * 0.5;
+	}
+
+	Success = IRIT_APX_EQ_EPS(Area, SmokePlsArea(PObj -> U.Pl),
+				  1e-6 * Area) &&
+		  PVIdx -> NumVrtcs > 0;
+    }
+
+    if (PObj != NULL)
+        IPFreeObject(PObj);
+    if (PVIdx != NULL) {
+        for (i = 0; i < PVIdx -> NumVrtcs; i++)
+	    IPFreeVertex(PVIdx -> Vertices[i]);
+	IPPolyVrtxIdxFree(PVIdx);
+    }
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares TrngTriSrfEvalGrid with TrngTriSrfEval2 and TrngTriSrfNrml.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeTrngTriSrfEvalGrid(void)
+{
+    int i, j, l,
+	FineNess = 8,
+	Success = TRUE;
+    CagdRType UMin, UMax, VMin, VMax, WMin, WMax, Du, Dv;
+    CagdPType *Pts;
+    CagdVType *Nrmls;
+    TrngTriangSrfStruct
+	*TriSrf = TrngBzrTriSrfNew(4, CAGD_PT_E3_TYPE);
+
+    for (l = 1; l <= 3; l++) {
+        for (i = 0; i < TRNG_TRISRF_MESH_SIZE(TriSrf); i++)
+	    TriSrf -> Points[l][i] = SmokeRand(-1.0, 1.0);
+    }
+
+    Pts = (CagdPType *) IritMalloc(sizeof(CagdPType) *
+				   (FineNess + 1) * (FineNess + 2) / 2);
+    Nrmls = (CagdVType *) IritMalloc(sizeof(CagdVType) *
+				     (FineNess + 1) * (FineNess + 2) / 2);
+    if (!TrngTriSrfEvalGrid(TriSrf, FineNess, Pts, Nrmls))
+        Success = FALSE;
+
+    TrngTriSrfDomain(TriSrf, &UMin, &UMax, &VMin, &VMax, &WMin, &WMax);
+    Du = (UMax - UMin - IRIT_UEPS) / FineNess;
+    Dv = (VMax - VMin - IRIT_UEPS) / FineNess;
+
+    for (i = 0; i <= FineNess && Success; i++) {
+        for (j = 0; i + j <= FineNess; j++) {
+	    int p = TRNG_GRID_IJ(FineNess, i, j);
+	    CagdRType
+		u = UMin + i * Du,
+		v = VMin + j * Dv,
+		*R = TrngTriSrfEval2(TriSrf, u, v);
+	    CagdVecStruct *Nrml;
+
+	    if (!IRIT_PT_APX_EQ_EPS(&R[1], Pts[p], SMOKE_EPS))
+	        Success = FALSE;
+
+	    /* Normals at the corners of the domain can be degenerate. */
+	    if (i + j > 0 && i + j < FineNess && i < FineNess && j > 0) {
+	        Nrml = TrngTriSrfNrml(TriSrf, u, v);
+		IRIT_VEC_NORMALIZE(Nrml -> Vec);
+		if (IRIT_FABS(IRIT_DOT_PROD(Nrml -> Vec, Nrmls[p])) <
+		    1.0 - 1e-6)
+		    Success = FALSE;
+	    }
+	}
+    }
+
+    IritFree(Pts);
+    IritFree(Nrmls);
+    TrngTriSrfFree(TriSrf);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares GMSubSrfsRefine with repeated GMSubCatmullClark and GMSubLoop.  *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeGMSubSrfsRefine(void)
+{
+    int i, s, OldCirc,
+	Success = TRUE;
+    IrtVecType
+	Org = { 0.0, 0.0, 0.0 };
+
+    /* The edge adjacency of GMSubLoop expects circular vertex lists. */
+    OldCirc = IPSetPolyListCirc(TRUE);
+
+    for (s = 0; s < 2; s++) {
+        IPObjectStruct *PRefined, *PTmp,
+	    *PObj = PrimGenBOXObject(Org, 1.0, 2.0, 3.0);
+
+	if (s == 1) {
+	    /* Loop subdivision requires triangles. */
+	    PTmp = GMConvertPolysToTriangles(PObj);
+	    IPFreeObject(PObj);
+	    PObj = PTmp;
+	}
+
+	PRefined = GMSubSrfsRefine(PObj, s == 0 ? GM_SUB_SRFS_CATMULL_CLARK
+					        : GM_SUB_SRFS_LOOP,
+				   2, 0.0, NULL);
+	for (i = 0; i < 2; i++) {
+	    PTmp = s == 0 ? GMSubCatmullClark(PObj) : GMSubLoop(PObj);
+	    IPFreeObject(PObj);
+	    PObj = PTmp;
+	}
+
+	if (PRefined == NULL ||
+	    IPPolyListLen(PRefined -> U.Pl) != IPPolyListLen(PObj -> U.Pl) ||
+	    !IRIT_APX_EQ_EPS(SmokePlsArea(PRefined -> U.Pl),
+			     SmokePlsArea(PObj -> U.Pl), 1e-6) ||
+	    !IRIT_APX_EQ_EPS(SmokePlsSumCoords(PRefined -> U.Pl),
+			     SmokePlsSumCoords(PObj -> U.Pl), 1e-6))
+	    Success = FALSE;
+
+	if (PRefined != NULL)
+	    IPFreeObject(PRefined);
+	IPFreeObject(PObj);
+    }
+
+    IPSetPolyListCirc(OldCirc);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the rings of GMPolyVrtxAdjRings with IPCnvPolyVrtxNeighbors.    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeGMPolyVrtxAdj(void)
+{
+    int i, j, Rings, NumNbrs, *Nbrs,
+	Success = TRUE;
+    IrtVecType
+	Center = { 0.0, 0.0, 0.0 };
+    IPObjectStruct *PTmp,
+	*PObj = PrimGenSPHEREObject(Center, 1.0);
+    IPPolyVrtxIdxStruct *PVIdx;
+    GMPolyVrtxAdjStruct *Adj;
+
+    /* IPCnvPolyVrtxNeighbors only supports triangles. */
+    PTmp = GMConvertPolysToTriangles(PObj);
+    IPFreeObject(PObj);
+    PObj = PTmp;
+
+    PVIdx = IPCnvPolyToPolyVrtxIdxStruct(PObj, TRUE, 0);
+    Adj = GMPolyVrtxAdjNew(PVIdx);
+
+    Nbrs = (int *) IritMalloc(sizeof(int) * (PVIdx -> NumVrtcs + 1));
+
+    for (Rings = 1; Rings <= 2; Rings++) {
+        for (i = 0; i < PVIdx -> NumVrtcs && Success; i++) {
+	    int *OldNbrs = IPCnvPolyVrtxNeighbors(PVIdx, i, Rings);
+
+	    NumNbrs = GMPolyVrtxAdjRings(Adj, i, Rings, Nbrs,
+					 PVIdx -> NumVrtcs);
+	    for (j = 0; OldNbrs[j] >= 0; j++);
+	    if (j != NumNbrs) {
+	        Success = FALSE;
+		break;
+	    }
+
+	    qsort(OldNbrs, j, sizeof(int), SmokeCmpInts);
+	    qsort(Nbrs, j, sizeof(int), SmokeCmpInts);
+	    for (j = 0; j < NumNbrs; j++) {
+	        if (OldNbrs[j] != Nbrs[j])
+		    Success = FALSE;
+	    }
+	}
+    }
+
+    IritFree(Nbrs);
+    GMPolyVrtxAdjFree(Adj);
+    IPPolyVrtxIdxFree(PVIdx);
+    IPFreeObject(PObj);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the curvatures of GMPlCrvtrEvalVrtcs over a sphere with the     *
+* curvatures of the sphere, and with the attributes that		     *
+* GMPlCrvtrSetCurvatureAttr places.					     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeGMPlCrvtrEvalVrtcs(void)
+{
+    int i,
+	Success = TRUE;
+    CagdRType
+	R = 2.0;
+    IrtVecType
+	Center = { 0.0, 0.0, 0.0 };
+    IPObjectStruct *PTmp,
+	*PObj = PrimGenSPHEREObject(Center, R);
+    IPPolyVrtxIdxStruct *PVIdx;
+    GMPlCrvtrVrtxStruct *Crvtr;
+
+    PTmp = GMConvertPolysToTriangles(PObj);
+    IPFreeObject(PObj);
+    PObj = PTmp;
+
+    GMPlCrvtrSetCurvatureAttr(PObj -> U.Pl, 1, TRUE);
+    PVIdx = IPCnvPolyToPolyVrtxIdxStruct(PObj, FALSE, 0);
+    Crvtr = GMPlCrvtrEvalVrtcs(PVIdx, NULL, 1);
+
+    for (i = 0; i < PVIdx -> NumVrtcs; i++) {
+        CagdRType
+	    K = AttrGetRealAttrib(PVIdx -> Vertices[i] -> Attr, "KCurv");
+
+	if (!IRIT_APX_EQ_EPS(K, Crvtr[i].K, SMOKE_EPS) ||
+	    !IRIT_APX_EQ_EPS(Crvtr[i].K, 1.0 / IRIT_SQR(R), 0.05) ||
+	    !IRIT_APX_EQ_EPS(IRIT_FABS(Crvtr[i].H), 1.0 / R, 0.05))
+	    Success = FALSE;
+    }
+
+    IritFree(Crvtr);
+    IPPolyVrtxIdxFree(PVIdx);
+    IPFreeObject(PObj);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares Taubin smoothing of a sphere with Laplacian smoothing (Mu = 0), *
+* which shrinks it.							     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeGMPolyMeshTaubinSmoothing(void)
+{
+    int i, Success;
+    CagdRType Area[2];
+    IrtVecType
+	Center = { 0.0, 0.0, 0.0 };
+
+    for (i = 0; i < 2; i++) {
+        IPObjectStruct
+	    *PObj = PrimGenSPHEREObject(Center, 1.0);
+
+	GMPolyMeshTaubinSmoothing(PObj, 10, 0.5, i == 0 ? -0.53 : 0.0);
+	Area[i] = SmokePlsArea(PObj -> U.Pl);
+	IPFreeObject(PObj);
+    }
+
+    /* A unit sphere has an area of 4 Pi. */
+    Success = IRIT_FABS(Area[0] - 4 * M_PI) < IRIT_FABS(Area[1] - 4 * M_PI) &&
+	      IRIT_APX_EQ_EPS(Area[0], 4 * M_PI, 0.5);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares objects fetched by name from an indexed data file with the      *
+* original objects and with the objects read sequentially from the file.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeIndexedDataFile(void)
+{
+    int i, Handler,
+	Success = TRUE;
+    CagdCrvStruct
+	*Crv = BspCrvNew(5, 3, CAGD_PT_E3_TYPE);
+    IPObjectStruct *PObj, *PObjList, *PSeqList;
+    VoidPtr IdxFile;
+
+    BspKnotUniformOpen(5, 3, Crv -> KnotVector);
+    for (i = 0; i < 5; i++) {
+        Crv -> Points[1][i] = i;
+        Crv -> Points[2][i] = SmokeRand(-1.0, 1.0);
+        Crv -> Points[3][i] = SmokeRand(-1.0, 1.0);
+    }
+    PObjList = IPGenCRVObject(Crv);
+    IP_SET_OBJ_NAME2(PObjList, "SmokeCrv");
+    PObjList -> Pnext = IPGenSRFObject(SmokeBumpBzrSrf());
+    IP_SET_OBJ_NAME2(PObjList -> Pnext, "SmokeSrf");
+
+    if (!IPPutIndexedDataFile(SMOKE_IBD_FILE, PObjList) ||
+	(IdxFile = IPOpenIndexedDataFile(SMOKE_IBD_FILE, TRUE)) == NULL) {
+        IPFreeObjectList(PObjList);
+	return FALSE;
+    }
+
+    /* The old path - read the file sequentially. */
+    if ((Handler = IPOpenDataFile(SMOKE_IBD_FILE, TRUE, TRUE)) >= 0) {
+        PSeqList = IPGetObjects(Handler);
+	IPCloseStream(Handler, TRUE);
+    }
+    else
+        PSeqList = NULL;
+
+    if (IPIndexedDataFileNumObjs(IdxFile) != 2 ||
+	IPObjListLen(PSeqList) != 2)
+        Success = FALSE;
+
+    for (PObj = PObjList; PObj != NULL && Success; PObj = PObj -> Pnext) {
+        IPObjectStruct
+	    *PIdxObj = IPGetIndexedObjectByName(IdxFile,
+						IP_GET_OBJ_NAME(PObj)),
+	    *PSeqObj = IPGetObjectByName(IP_GET_OBJ_NAME(PObj), PSeqList,
+						FALSE);
+
+	if (PIdxObj == NULL || PSeqObj == NULL)
+	    Success = FALSE;
+	else if (IP_IS_CRV_OBJ(PObj))
+	    Success = CagdCrvsSame(PObj -> U.Crvs, PIdxObj -> U.Crvs,
+				   SMOKE_EPS) &&
+	              CagdCrvsSame(PSeqObj -> U.Crvs, PIdxObj -> U.Crvs,
+				   SMOKE_EPS);
+	else
+	    Success = CagdSrfsSame(PObj -> U.Srfs, PIdxObj -> U.Srfs,
+				   SMOKE_EPS) &&
+	              CagdSrfsSame(PSeqObj -> U.Srfs, PIdxObj -> U.Srfs,
+				   SMOKE_EPS);
+
+	if (PIdxObj != NULL)
+	    IPFreeObject(PIdxObj);
+    }
+
+    if (IPGetIndexedObjectByName(IdxFile, "NoSuchObject") != NULL)
+        Success = FALSE;
+
+    IPCloseIndexedDataFile(IdxFile);
+    IPFreeObjectList(PObjList);
+    IPFreeObjectList(PSeqList);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the streamed G code toolpath length with the length computed    *
+* by a parser that keeps all the G codes.                                    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeNCGCodeStreaming(void)
+{
+    IRIT_STATIC_DATA const char
+	*GCodes[] = {
+	    "G90 G21",
+	    "G0 X0 Y0 Z5",
+	    "G1 Z0 F100",
+	    "G1 X10 Y0",
+	    "G1 X10 Y10",
+	    "G2 X0 Y10 I-5 J0",
+	    "G3 X0 Y0 I0 J-5",
+	    "G0 Z5",
+	    "G0 X20 Y20",
+	    "M30",
+	    NULL
+	};
+    int i;
+    IrtRType Len, FastLen, StrmLen, StrmFastLen;
+    IPObjectStruct *PObj;
+    VoidPtr GStream;
+    FILE *f;
+
+    if ((f = fopen(SMOKE_NC_FILE, "w")) == NULL)
+        return FALSE;
+    for (i = 0; GCodes[i] != NULL; i++)
+        fprintf(f, "%s\n", GCodes[i]);
+    fclose(f);
+
+    /* The old path - keep all the G codes and then measure. */
+    GStream = IPNCGCodeParserInit(TRUE, 1.0, 1000.0, 1, FALSE, NULL);
+    for (i = 0; GCodes[i] != NULL; i++)
+        IPNCGCodeParserParseLine(GStream, GCodes[i], i + 1);
+    IPNCGCodeParserDone(GStream);
+    if ((PObj = IPNCGCode2Geometry(GStream)) != NULL) /* Sets lengths. */
+        IPFreeObject(PObj);
+    Len = IPNCGCodeLength(GStream, &FastLen);
+    IPNCGCodeParserFree(GStream);
+
+    StrmLen = IPNCGCodeLoadFileLength(SMOKE_NC_FILE, TRUE, &StrmFastLen);
+
+    return Len > 0.0 &&
+	   IRIT_APX_EQ_EPS(Len, StrmLen, SMOKE_EPS) &&
+	   IRIT_APX_EQ_EPS(FastLen, StrmFastLen, SMOKE_EPS);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares sweeping a mask along a line with placing it at every pixel     *
+* along the line.							     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeNCMaskAlongLine(void)
+{
+    int i, x,
+	PosXY1[2] = { 10, 20 },
+	PosXY2[2] = { 40, 20 };
+    IrtRType Mask[SMOKE_MASK_SIZE * SMOKE_MASK_SIZE],
+	Vol[2] = { 0.0, 0.0 };
+    IrtPtType
+	XYZMin = { 0.0, 0.0, 0.0 },
+	XYZMax = { 50.0, 50.0, 10.0 };
+
+    for (i = 0; i < SMOKE_MASK_SIZE * SMOKE_MASK_SIZE; i++)
+        Mask[i] = (i % SMOKE_MASK_SIZE) * 0.1 + (i / SMOKE_MASK_SIZE) * 0.1;
+
+    for (i = 0; i < 2; i++) {
+        INCZBufferPtrType
+	    Rend = INCRndrInitialize(50, 50, 5, 5, XYZMin, XYZMax, TRUE);
+
+	if (Rend == NULL)
+	    return FALSE;
+
+	if (i == 0) {
+	    Vol[i] = INCRndrPutMaskAlongLine(Rend, PosXY1, 5.0, PosXY2, 5.0,
+					     Mask, SMOKE_MASK_SIZE,
+					     SMOKE_MASK_SIZE);
+	}
+	else {
+	    for (x = PosXY1[0]; x <= PosXY2[0]; x++) {
+	        int PosXY[2];
+
+		PosXY[0] = x;
+		PosXY[1] = PosXY1[1];
+		Vol[i] += INCRndrPutMask(Rend, PosXY, 5.0, Mask,
+					 SMOKE_MASK_SIZE, SMOKE_MASK_SIZE);
+	    }
+	}
+
+	INCRndrDestroy(Rend);
+    }
+
+    return Vol[0] > 0.0 && IRIT_APX_EQ_EPS(Vol[0], Vol[1], SMOKE_EPS);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the hierarchy of several surfaces, single and batched rays,     *
+* with the hierarchy of a single surface.				     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeSrfsHierarchy(void)
+{
+    int i, SrfIndices[16],
+	NumRays = 16,
+	Success = TRUE;
+    CagdRType InterTs[16];
+    CagdUVType InterUVs[16];
+    CagdPType RayOrigins[16];
+    CagdVType RayDirs[16];
+    CagdSrfStruct
+	*Srfs = SmokeBumpBzrSrf();
+    VoidPtr SrfsHandle;
+    VoidPtr SrfHandle;
+
+    /* A second surface below the first one, that rays hit second. */
+    Srfs -> Pnext = CagdPrimPlaneSrf(0.0, 0.0, 1.0, 1.0, -1.0);
+    SrfsHandle = IntrSrfsHierarchyPreprocess(Srfs, 0.01);
+    SrfHandle = IntrSrfHierarchyPreprocessSrf(Srfs, 0.01);
+
+    for (i = 0; i < NumRays; i++) {
+        RayOrigins[i][0] = SmokeRand(0.05, 0.95);
+        RayOrigins[i][1] = SmokeRand(0.05, 0.95);
+        RayOrigins[i][2] = 2.0;
+	RayDirs[i][0] = RayDirs[i][1] = 0.0;
+	RayDirs[i][2] = -1.0;
+    }
+    RayOrigins[NumRays - 1][0] = 5.0;		    /* And one that misses. */
+
+    if (IntrSrfsHierarchyTestRays(SrfsHandle, NumRays,
+				  (const CagdPType *) RayOrigins,
+				  (const CagdVType *) RayDirs, FALSE,
+				  SrfIndices, InterUVs,
+				  InterTs) != NumRays - 1)
+        Success = FALSE;
+
+    for (i = 0; i < NumRays && Success; i++) {
+        int SrfIndex;
+        CagdRType InterT;
+        CagdUVType InterUV, OldInterUV;
+	CagdBType
+	    Hit = IntrSrfsHierarchyTestRay(SrfsHandle, RayOrigins[i],
+					   RayDirs[i], FALSE, &SrfIndex,
+					   InterUV, &InterT),
+	    OldHit = IntrSrfHierarchyTestRay(SrfHandle, RayOrigins[i],
+					     RayDirs[i], OldInterUV);
+
+	if (Hit != OldHit || Hit != (SrfIndices[i] >= 0))
+	    Success = FALSE;
+	else if (Hit &&
+		 (SrfIndex != 0 ||
+		  SrfIndices[i] != 0 ||
+		  !IRIT_APX_EQ_EPS(InterT, InterTs[i], SMOKE_EPS) ||
+		  !SMOKE_UV_APX_EQ(InterUV, InterUVs[i], SMOKE_EPS) ||
+		  !SMOKE_UV_APX_EQ(InterUV, OldInterUV, 0.01)))
+	    Success = FALSE;
+    }
+
+    IntrSrfsHierarchyFreePreprocess(SrfsHandle);
+    IntrSrfHierarchyFreePreprocess(SrfHandle);
+    CagdSrfFreeList(Srfs);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares packet ray tracing with CagdRayTraceBzrSrf, one ray at a time.  *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeRayTraceSrfsPacket(void)
+{
+    int i, SrfIndices[16],
+	NumRays = 16,
+	Success = TRUE;
+    CagdRType InterTs[16];
+    CagdUVType InterUVs[16];
+    CagdPType StPts[16];
+    CagdVType Dirs[16];
+    CagdSrfStruct
+	*Srf = SmokeBumpBzrSrf();
+    VoidPtr
+	RayTrcPrep = CagdRayTracePrepSrfs(Srf);
+
+    for (i = 0; i < NumRays; i++) {
+        StPts[i][0] = SmokeRand(0.05, 0.95);
+        StPts[i][1] = SmokeRand(0.05, 0.95);
+        StPts[i][2] = 2.0;
+	Dirs[i][0] = Dirs[i][1] = 0.0;
+	Dirs[i][2] = -1.0;
+    }
+
+    if (RayTrcPrep == NULL ||
+	CagdRayTraceSrfsPacket(RayTrcPrep, NumRays,
+			       (const CagdPType *) StPts,
+			       (const CagdVType *) Dirs, SrfIndices,
+			       InterUVs, InterTs, NULL, NULL) != NumRays) {
+        Success = FALSE;
+    }
+
+    for (i = 0; i < NumRays && Success; i++) {
+        CagdUVStruct *UVs, *UV;
+        CagdPtStruct *Pts, *Pt;
+	CagdRType
+	    MinT = IRIT_INFNTY;
+	CagdUVType MinUV;
+
+	if (SrfIndices[i] != 0 ||
+	    !CagdRayTraceBzrSrf(StPts[i], Dirs[i], Srf, &UVs, &Pts)) {
+	    Success = FALSE;
+	    break;
+	}
+
+	for (UV = UVs, Pt = Pts;
+	     UV != NULL && Pt != NULL;
+	     UV = UV -> Pnext, Pt = Pt -> Pnext) {
+	    CagdRType
+		t = StPts[i][2] - Pt -> Pt[2];
+
+	    if (t < MinT) {
+	        MinT = t;
+		IRIT_UV_COPY(MinUV, UV -> UV);
+	    }
+	}
+
+	if (!IRIT_APX_EQ_EPS(MinT, InterTs[i], 1e-5) ||
+	    !SMOKE_UV_APX_EQ(MinUV, InterUVs[i], 1e-5))
+	    Success = FALSE;
+
+	CagdUVFreeList(UVs);
+	CagdPtFreeList(Pts);
+    }
+
+    if (RayTrcPrep != NULL)
+        CagdRayTraceFreePrepSrfs(RayTrcPrep);
+    CagdSrfFree(Srf);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares packet ray tracing of trimmed surfaces with packet ray tracing  *
+* of the untrimmed surfaces, filtered by TrimIsPointInsideTrimSrf.           *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeTrimRayTraceSrfsPacket(void)
+{
+    int i, SrfIndices[16], TrimSrfIndices[16],
+	NumRays = 16,
+	NumInside = 0,
+	Success = TRUE;
+    CagdRType InterTs[16], TrimInterTs[16];
+    CagdUVType InterUVs[16], TrimInterUVs[16];
+    CagdPType StPts[16];
+    CagdVType Dirs[16];
+    CagdSrfStruct
+	*Srf = SmokeBumpBzrSrf();
+    TrimSrfStruct
+	*TrimSrf = SmokeHoledTrimSrf(Srf);
+    VoidPtr RayTrcPrep;
+    VoidPtr TrimRayTrcPrep;
+
+    RayTrcPrep = CagdRayTracePrepSrfs(Srf);
+    TrimRayTrcPrep = TrimRayTracePrepSrfs(TrimSrf);
+
+    for (i = 0; i < NumRays; i++) {
+        StPts[i][0] = SmokeRand(0.05, 0.95);
+        StPts[i][1] = SmokeRand(0.05, 0.95);
+        StPts[i][2] = 2.0;
+	Dirs[i][0] = Dirs[i][1] = 0.0;
+	Dirs[i][2] = -1.0;
+    }
+
+    if (RayTrcPrep == NULL || TrimRayTrcPrep == NULL) {
+        Success = FALSE;
+    }
+    else {
+        CagdRayTraceSrfsPacket(RayTrcPrep, NumRays,
+			       (const CagdPType *) StPts,
+			       (const CagdVType *) Dirs, SrfIndices,
+			       InterUVs, InterTs, NULL, NULL);
+	TrimRayTraceSrfsPacket(TrimRayTrcPrep, NumRays,
+			       (const CagdPType *) StPts,
+			       (const CagdVType *) Dirs, TrimSrfIndices,
+			       TrimInterUVs, TrimInterTs);
+
+	for (i = 0; i < NumRays; i++) {
+	    CagdBType
+		Inside = SrfIndices[i] >= 0 &&
+			 TrimIsPointInsideTrimSrf(TrimSrf, InterUVs[i]);
+
+	    if (Inside)
+	        NumInside++;
+
+	    if (Inside != (TrimSrfIndices[i] >= 0))
+	        Success = FALSE;
+	    else if (Inside &&
+		     (!IRIT_APX_EQ_EPS(InterTs[i], TrimInterTs[i],
+				       SMOKE_EPS) ||
+		      !SMOKE_UV_APX_EQ(InterUVs[i], TrimInterUVs[i],
+					  SMOKE_EPS)))
+	        Success = FALSE;
+	}
+    }
+
+    /* Some rays must pass through the hole and some must not. */
+    if (NumInside == 0 || NumInside == NumRays)
+        Success = FALSE;
+
+    if (RayTrcPrep != NULL)
+        CagdRayTraceFreePrepSrfs(RayTrcPrep);
+    if (TrimRayTrcPrep != NULL)
+        TrimRayTraceFreePrepSrfs(TrimRayTrcPrep);
+    TrimSrfFree(TrimSrf);
+    CagdSrfFree(Srf);
+
+    return Success;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Compares the trimmed surfaces of a model of a holed surface, with        *
+* piecewise linear trimming curves, with those with exact trimming curves.   *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:    TRUE if successful, FALSE otherwise.                             *
+*****************************************************************************/
+static int SmokeMdl2TrimmedSrfs2(void)
+{
+    int i, j,
+	NumInside = 0,
+	Success = TRUE;
+    CagdSrfStruct
+	*Srf = SmokeBumpBzrSrf();
+    TrimSrfStruct
+	*TrimSrf = SmokeHoledTrimSrf(Srf);
+    MdlModelStruct
+	*Mdl = MdlCnvrtTrimmedSrf2Mdl(TrimSrf);
+    TrimSrfStruct *TSrf, *TSrf2,
+	*TSrfs = MdlCnvrtMdl2TrimmedSrfs(Mdl),
+	*TSrfs2 = MdlCnvrtMdl2TrimmedSrfs2(Mdl, 1e-3);
+
+    if (TSrfs == NULL ||
+	TSrfs2 == NULL ||
+	CagdListLength(TSrfs) != CagdListLength(TSrfs2))
+        Success = FALSE;
+
+    for (TSrf = TSrfs, TSrf2 = TSrfs2;
+	 TSrf != NULL && TSrf2 != NULL && Success;
+	 TSrf = TSrf -> Pnext, TSrf2 = TSrf2 -> Pnext) {
+        if (!CagdSrfsSame(TSrf -> Srf, TSrf2 -> Srf, SMOKE_EPS)) {
+	    Success = FALSE;
+	    break;
+	}
+
+	/* Away from the trimming curves, both must classify alike. */
+        for (i = 1; i < 10; i++) {
+	    for (j = 1; j < 10; j++) {
+	        CagdUVType UV;
+
+		UV[0] = i / 10.0;
+		UV[1] = j / 10.0;
+		if (TrimIsPointInsideTrimSrf(TSrf, UV)) {
+		    if (!TrimIsPointInsideTrimSrf(TSrf2, UV))
+		        Success = FALSE;
+		    NumInside++;
+		}
+		else if (TrimIsPointInsideTrimSrf(TSrf2, UV))
+		    Success = FALSE;
+	    }
+	}
+    }
+
+    /* The hole must be classified as well. */
+    if (NumInside == 0 || NumInside == 81)
+        Success = FALSE;
+
+    TrimSrfFreeList(TSrfs);
+    TrimSrfFreeList(TSrfs2);
+    MdlModelFree(Mdl);
+    TrimSrfFree(TrimSrf);
+    CagdSrfFree(Srf);
+
+    return Success;
+}
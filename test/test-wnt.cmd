@@ -0,0 +1 @@
+smoke
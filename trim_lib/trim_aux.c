@@ -26,11 +26,19 @@
     }
 
 
+typedef struct TrimRayTrcPrepStruct {
+    VoidPtr CagdRayTrcPrep;      /* The untrimmed surfaces' ray tracing data. */
+    const TrimSrfStruct **TrimSrfs;	    /* Indexed as the hit surfaces. */
+} TrimRayTrcPrepStruct;
+
 IRIT_GLOBAL_DATA CagdBType
     _TrimEuclidComposedFromUV = FALSE;
 
 static TrimCrvStruct *TrimChainTrimmingCurves2LoopsAux(TrimCrvStruct *TrimCrvs,
 						       IrtRType Tol);
+static CagdBType TrimRayTraceHitTest(int SrfIndex,
+				     CagdUVType UV,
+				     VoidPtr HitTestData);
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -1730,3 +1738,161 @@ TrimSrfStruct *TrimClipSrfToTrimCrvs(TrimSrfStruct *TrimSrf)
 
     return NewTrimSrf;
 }
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Prepares a list of trimmed surfaces for packet ray tracing.  The         M
+* untrimmed surfaces are prepared by CagdRayTracePrepSrfs and the hits are   M
+* then tested against the trimming curves by TrimRayTraceSrfsPacket.         M
+*   The trimmed surfaces are referenced, not copied, and must be kept alive  M
+* until TrimRayTraceFreePrepSrfs is invoked.				     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   TrimSrfs:  List of trimmed surfaces to prepare for ray tracing.          M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   VoidPtr:   A handle to the prepared data, or NULL if error.  Free with   M
+*	       TrimRayTraceFreePrepSrfs.				     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   TrimRayTraceSrfsPacket, TrimRayTraceFreePrepSrfs, CagdRayTracePrepSrfs   M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   TrimRayTracePrepSrfs, ray tracing                                        M
+*****************************************************************************/
+VoidPtr TrimRayTracePrepSrfs(const TrimSrfStruct *TrimSrfs)
+{
+    int i,
+	NumSrfs = CagdListLength(TrimSrfs);
+    const TrimSrfStruct *TrimSrf;
+    CagdSrfStruct
+	*Srfs = NULL;
+    TrimRayTrcPrepStruct *Prep;
+
+    if (NumSrfs == 0)
+        return NULL;
+
+    /* Collect the untrimmed surfaces, in order, as one list. */
+    Prep = (TrimRayTrcPrepStruct *) IritMalloc(sizeof(TrimRayTrcPrepStruct));
+    Prep -> TrimSrfs = (const TrimSrfStruct **)
+			    IritMalloc(sizeof(TrimSrfStruct *) * NumSrfs);
+    for (TrimSrf = TrimSrfs, i = 0;
+	 TrimSrf != NULL;
+	 TrimSrf = TrimSrf -> Pnext, i++) {
+        CagdSrfStruct
+	    *Srf = CagdSrfCopy(TrimSrf -> Srf);
+
+	Prep -> TrimSrfs[i] = TrimSrf;
+	IRIT_LIST_PUSH(Srf, Srfs);
+    }
+    Srfs = CagdListReverse(Srfs);
+
+    Prep -> CagdRayTrcPrep = CagdRayTracePrepSrfs(Srfs);
+    CagdSrfFreeList(Srfs);
+
+    if (Prep -> CagdRayTrcPrep == NULL) {
+        IritFree(Prep -> TrimSrfs);
+	IritFree(Prep);
+	return NULL;
+    }
+
+    return Prep;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Releases the data allocated by TrimRayTracePrepSrfs.                     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   RayTrcPrep:   Handle returned by TrimRayTracePrepSrfs.                   M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   TrimRayTracePrepSrfs                                                     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   TrimRayTraceFreePrepSrfs, ray tracing                                    M
+*****************************************************************************/
+void TrimRayTraceFreePrepSrfs(VoidPtr RayTrcPrep)
+{
+    TrimRayTrcPrepStruct
+        *Prep = (TrimRayTrcPrepStruct *) RayTrcPrep;
+
+    if (Prep == NULL)
+        return;
+
+    CagdRayTraceFreePrepSrfs(Prep -> CagdRayTrcPrep);
+    IritFree(Prep -> TrimSrfs);
+    IritFree(Prep);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Hit test call back of TrimRayTraceSrfsPacket - accepts only hits inside  *
+* the trimming curves of the hit trimmed surface.                            *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   SrfIndex:      Index of hit surface.                                     *
+*   UV:            Parametric location of the hit.                           *
+*   HitTestData:   The TrimRayTrcPrepStruct.                                 *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdBType:     TRUE if inside the trimmed domain, FALSE otherwise.       *
+*****************************************************************************/
+static CagdBType TrimRayTraceHitTest(int SrfIndex,
+				     CagdUVType UV,
+				     VoidPtr HitTestData)
+{
+    TrimRayTrcPrepStruct
+        *Prep = (TrimRayTrcPrepStruct *) HitTestData;
+
+    return TrimIsPointInsideTrimSrf(Prep -> TrimSrfs[SrfIndex], UV);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Traces a packet of rays against trimmed surfaces prepared by             M
+* TrimRayTracePrepSrfs, finding the closest hit of every ray that is inside  M
+* the trimming curves of the hit surface.  Hits in trimmed away regions are  M
+* ignored and the ray continues to look for farther hits.		     M
+*   See CagdRayTraceSrfsPacket for the details of the tracing.		     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   RayTrcPrep: Handle returned by TrimRayTracePrepSrfs.                     M
+*   NumRays:    Number of rays in the packet.                                M
+*   StPts:      Start points of the rays, NumRays of them.                   M
+*   Dirs:       Directions of the rays, NumRays of them.                     M
+*   SrfIndices: Index of the hit trimmed surface in the list given to        M
+*		TrimRayTracePrepSrfs, per ray, or -1 if the ray missed.      M
+*   InterUVs:   UV parameters of the closest hit, in the domain of the hit   M
+*		surface, per ray.  Undefined where missed.		     M
+*   InterTs:    Ray parameter t of the closest hit, StPt + t * Dir, per ray. M
+*		Undefined where missed.					     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:        Number of rays in the packet that hit some trimmed surface.  M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   TrimRayTracePrepSrfs, CagdRayTraceSrfsPacket, TrimIsPointInsideTrimSrf   M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   TrimRayTraceSrfsPacket, ray tracing                                      M
+*****************************************************************************/
+int TrimRayTraceSrfsPacket(VoidPtr RayTrcPrep,
+			   int NumRays,
+			   const CagdPType *StPts,
+			   const CagdVType *Dirs,
+			   int *SrfIndices,
+			   CagdUVType *InterUVs,
+			   CagdRType *InterTs)
+{
+    TrimRayTrcPrepStruct
+        *Prep = (TrimRayTrcPrepStruct *) RayTrcPrep;
+
+    return CagdRayTraceSrfsPacket(Prep == NULL ? NULL : Prep -> CagdRayTrcPrep,
+				  NumRays, StPts, Dirs,
+				  SrfIndices, InterUVs, InterTs,
+				  TrimRayTraceHitTest, Prep);
+}
@@ -20,6 +20,12 @@
 #include <io.h>
 #endif /* __WINNT__ */
 
+#define MC_READ_BUF_SIZE	4096    /* In doubles, for binary layer reads. */
+
+#define MC_PT_SAME(Pt1, Pt2) ((Pt1)[0] == (Pt2)[0] && \
+			      (Pt1)[1] == (Pt2)[1] && \
+			      (Pt1)[2] == (Pt2)[2])
+
 typedef enum {
     INPUT_ASCII = 1,
     INPUT_INTEGER,
@@ -42,7 +48,33 @@ IRIT_STATIC_DATA CagdRType
     *GlblLayerOne = NULL,
     *GlblLayerTwo = NULL;
 
+/* Lattice offsets (in samples) and layer of the 8 cube corners, and the   */
+/* lower corner and direction (0 - X, 1 - Y, 2 - Z) of the 12 cube edges.  */
+IRIT_STATIC_DATA const int
+    MCCrnrDX[8] = { 0, 1, 1, 0, 0, 1, 1, 0 },
+    MCCrnrDY[8] = { 0, 0, 1, 1, 0, 0, 1, 1 },
+    MCCrnrDZ[8] = { 0, 0, 0, 0, 1, 1, 1, 1 },
+    MCEdgeCrnr[12] = { 0, 1, 3, 0, 0, 1, 2, 3, 4, 5, 7, 4 },
+    MCEdgeDir[12] = { 0, 1, 0, 1, 2, 2, 2, 2, 0, 1, 0, 1 };
+
+typedef struct MCIdxCacheStruct {/* Mesh indices (plus one) of lattice vrtcs.*/
+    int *Crnrs[2];     /* Iso vertices at lattice points, bottom/top layers. */
+    int *XEdges[2];	     /* Iso vertices on X lattice edges, bottom/top. */
+    int *YEdges[2];	     /* Iso vertices on Y lattice edges, bottom/top. */
+    int *ZEdges;		   /* Iso vertices on Z edges between layers. */
+} MCIdxCacheStruct;
+
 static CagdRType GetOneScalar(FILE *Fin);
+static int MCScalarSize(void);
+static int MCReadLayer(FILE *f, CagdRType *Layer, int Size);
+static int MCSkipLayers(FILE *f, int NumLayers, int Size);
+static int *MCIdxVrtxSlot(const MCCubeCornerScalarStruct *CCS,
+			  const CagdRType *Pos,
+			  MCIdxCacheStruct *Cache,
+			  int x,
+			  int y,
+			  int Skip,
+			  int Width);
 static MCCubeCornerScalarStruct *GetCubeFile(FILE *f, int FirstTime);
 static MCCubeCornerScalarStruct *GetCubeTV(CagdRType *TVPoints, int FirstTime);
 static int GetLayerFromImage(CagdRType *Layer, IPObjectStruct *ImageNameObj);
@@ -187,6 +219,252 @@ IPObjectStruct *MCExtractIsoSurface(const char *FileName,
         return NULL;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Extract a polygonal iso-surface out of volumetric data file, as an       M
+* indexed triangular mesh.  Same as MCExtractIsoSurface, but iso vertices    M
+* on lattice edges that are shared by several cubes are created only once.  M
+*   The volume is streamed slab by slab, holding two layers of the volume    M
+* and a cache of the iso vertices on the lattice of these two layers only,   M
+* so volumes much larger than the available memory can be processed.  Only  M
+* cubes that the iso surface crosses are thresholded.                        M
+*   The returned vertices are owned by the returned structure (its PObj is   M
+* NULL), and should be freed using IPFreeVertex before the structure itself  M
+* is freed using IPPolyVrtxIdxFree.                                          M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   FileName:   Containing the volumetric data.                              M
+*   DataType:   Type of scalar value in volume.  See MCExtractIsoSurface.    M
+*   CubeDim:	Width, height, and depth of a single cube, in object space   M
+*		coordinates.						     M
+*   Width:      Of volumetric data set.                                      M
+*   Height:     Of volumetric data set.                                      M
+*   Depth:      Of volumetric data set.                                      M
+*   SkipFactor: Typically 1.  For 2, only every second sample is considered  M
+*		and for i, only every i'th sample is considered, in all axes.M
+*   IsoVal:     At which to extract the iso-surface.                         M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   IPPolyVrtxIdxStruct *: A triangular approximation of the iso-surface at  M
+*		IsoVal, or NULL if empty or an error occured.                M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   MCThresholdCube, MCExtractIsoSurface, IPCnvPolyToPolyVrtxIdxStruct       M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   MCExtractIsoSurfaceIdx                                                   M
+*****************************************************************************/
+IPPolyVrtxIdxStruct *MCExtractIsoSurfaceIdx(const char *FileName,
+					    int DataType,
+					    IrtPtType CubeDim,
+					    int Width,
+					    int Height,
+					    int Depth,
+					    int SkipFactor,
+					    CagdRType IsoVal)
+{
+    int i, x, y, z,
+	LayerSize = Width * Height,
+	NumVrtcs = 0,
+	MaxVrtcs = 1024,
+	NumTris = 0,
+	MaxTris = 1024,
+	*Tris, *CacheMem;
+    FILE *f;
+    CagdRType *Layer1, *Layer2, *LayersMem;
+    IPVertexStruct **Vrtcs;
+    IPPolyVrtxIdxStruct *PVIdx;
+    MCIdxCacheStruct Cache;
+    MCCubeCornerScalarStruct CCS;
+
+    if ((f = fopen(FileName, "r")) == NULL) {
+        TRIV_FATAL_ERROR(TRIV_ERR_FAIL_READ_FILE);
+        return NULL;
+    }
+
+#if defined(__OS2GCC__)
+    if (DataType != INPUT_ASCII)
+	setmode(fileno(f), O_BINARY);    /* Make sure it is in binary mode. */
+#endif /* __OS2GCC__ */
+#if defined(__WINNT__)
+    if (DataType != INPUT_ASCII)
+	_setmode(_fileno(f), _O_BINARY); /* Make sure it is in binary mode. */
+#endif /* __WINNT__ */
+
+    GlblInputFormat = (ScalarFormatType) DataType;
+
+    Layer1 = LayersMem = (CagdRType *)
+			     IritMalloc(sizeof(CagdRType) * LayerSize * 2);
+    Layer2 = &Layer1[LayerSize];
+    Cache.Crnrs[0] = CacheMem = (int *) IritMalloc(sizeof(int) * LayerSize * 7);
+    IRIT_ZAP_MEM(CacheMem, sizeof(int) * LayerSize * 7);
+    Vrtcs = (IPVertexStruct **) IritMalloc(sizeof(IPVertexStruct *) *
+								   MaxVrtcs);
+    Tris = (int *) IritMalloc(sizeof(int) * 4 * MaxTris);
+    Cache.Crnrs[1] = &Cache.Crnrs[0][LayerSize];
+    Cache.XEdges[0] = &Cache.Crnrs[1][LayerSize];
+    Cache.XEdges[1] = &Cache.XEdges[0][LayerSize];
+    Cache.YEdges[0] = &Cache.XEdges[1][LayerSize];
+    Cache.YEdges[1] = &Cache.YEdges[0][LayerSize];
+    Cache.ZEdges = &Cache.YEdges[1][LayerSize];
+
+    IRIT_PT_COPY(CCS.CubeDim, CubeDim);
+
+    if (!MCReadLayer(f, Layer2, LayerSize))
+        z = Depth;					 /* Nothing to process. */
+    else
+        z = 0;
+
+    for ( ; z < Depth - SkipFactor; z += SkipFactor) {
+        /* Advance one slab - the top layer and its cache are now bottom. */
+        IRIT_SWAP(CagdRType *, Layer1, Layer2);
+	if (!MCSkipLayers(f, SkipFactor - 1, LayerSize) ||
+	    !MCReadLayer(f, Layer2, LayerSize))
+	    break;
+
+	IRIT_SWAP(int *, Cache.Crnrs[0], Cache.Crnrs[1]);
+	IRIT_SWAP(int *, Cache.XEdges[0], Cache.XEdges[1]);
+	IRIT_SWAP(int *, Cache.YEdges[0], Cache.YEdges[1]);
+	IRIT_ZAP_MEM(Cache.Crnrs[1], sizeof(int) * LayerSize);
+	IRIT_ZAP_MEM(Cache.XEdges[1], sizeof(int) * LayerSize);
+	IRIT_ZAP_MEM(Cache.YEdges[1], sizeof(int) * LayerSize);
+	IRIT_ZAP_MEM(Cache.ZEdges, sizeof(int) * LayerSize);
+
+	for (y = 0; y < Height - SkipFactor; y += SkipFactor) {
+	    for (x = 0; x < Width - SkipFactor; x += SkipFactor) {
+	        int NumAbove = 0,
+		    Idx = y * Width + x,
+		    DIdx = SkipFactor * Width;
+		CagdRType
+		    *C = CCS.Corners;
+		MCPolygonStruct *MCPolys;
+
+		C[0] = Layer1[Idx];
+		C[1] = Layer1[Idx + SkipFactor];
+		C[2] = Layer1[Idx + DIdx + SkipFactor];
+		C[3] = Layer1[Idx + DIdx];
+		C[4] = Layer2[Idx];
+		C[5] = Layer2[Idx + SkipFactor];
+		C[6] = Layer2[Idx + DIdx + SkipFactor];
+		C[7] = Layer2[Idx + DIdx];
+		for (i = 0; i < 8; i++)
+		    NumAbove += C[i] >= IsoVal;
+		if (NumAbove == 0 || NumAbove == 8)
+		    continue;		  /* Iso surface does not cross cube. */
+
+		CCS.Vrtx0Lctn[0] = x * CubeDim[0] / SkipFactor;
+		CCS.Vrtx0Lctn[1] = y * CubeDim[1] / SkipFactor;
+		CCS.Vrtx0Lctn[2] = z * CubeDim[2] / SkipFactor;
+		EstimateGradient(&CCS);
+
+		MCPolys = MCThresholdCube(&CCS, IsoVal);
+
+		while (MCPolys != NULL) {
+		    int j, VIdx[13],
+		        n = MCPolys -> NumOfVertices - 1; /* Last is first. */
+		    MCPolygonStruct
+		        *MCPolyTmp = MCPolys -> Pnext;
+
+		    /* Find or create the mesh vertices of this polygon. */
+		    for (j = 0; j < n; j++) {
+		        int NoSlot = 0,
+			    *Slot = MCIdxVrtxSlot(&CCS, MCPolys -> V[j], &Cache,
+						  x, y, SkipFactor, Width);
+
+			if (Slot == NULL)
+			    Slot = &NoSlot;
+
+			if (*Slot == 0) {
+			    IPVertexStruct
+			        *V = IPAllocVertex2(NULL);
+
+			    IRIT_PT_COPY(V -> Coord, MCPolys -> V[j]);
+			    IRIT_PT_COPY(V -> Normal, MCPolys -> N[j]);
+			    IP_SET_NORMAL_VRTX(V);
+
+			    if (NumVrtcs >= MaxVrtcs) {
+			        Vrtcs = (IPVertexStruct **)
+				    IritRealloc(Vrtcs,
+					sizeof(IPVertexStruct *) * MaxVrtcs,
+					sizeof(IPVertexStruct *) *
+					    MaxVrtcs * 2);
+				MaxVrtcs *= 2;
+			    }
+			    Vrtcs[NumVrtcs++] = V;
+			    *Slot = NumVrtcs;
+			}
+			VIdx[j] = *Slot - 1;
+		    }
+
+		    /* Triangulate as a fan, oriented along the gradient. */
+		    for (j = 1; j < n - 1; j++) {
+		        int *Tri;
+			IrtVecType V1, V2, Nrml;
+
+			if (VIdx[0] == VIdx[j] ||
+			    VIdx[0] == VIdx[j + 1] ||
+			    VIdx[j] == VIdx[j + 1])
+			    continue;		      /* A degenerated triangle. */
+
+			if (NumTris >= MaxTris) {
+			    Tris = (int *) IritRealloc(Tris,
+					      sizeof(int) * 4 * MaxTris,
+					      sizeof(int) * 8 * MaxTris);
+			    MaxTris *= 2;
+			}
+			Tri = &Tris[4 * NumTris++];
+
+			IRIT_PT_SUB(V1, MCPolys -> V[j], MCPolys -> V[0]);
+			IRIT_PT_SUB(V2, MCPolys -> V[j + 1], MCPolys -> V[0]);
+			IRIT_CROSS_PROD(Nrml, V1, V2);
+			Tri[0] = VIdx[0];
+			if (IRIT_DOT_PROD(Nrml, MCPolys -> N[0]) >= 0.0) {
+			    Tri[1] = VIdx[j];
+			    Tri[2] = VIdx[j + 1];
+			}
+			else {
+			    Tri[1] = VIdx[j + 1];
+			    Tri[2] = VIdx[j];
+			}
+			Tri[3] = -1;
+		    }
+
+		    IritFree(MCPolys);
+
+		    MCPolys = MCPolyTmp;
+		}
+	    }
+	}
+    }
+
+    fclose(f);
+    IritFree(LayersMem);
+    IritFree(CacheMem);
+
+    if (NumTris == 0) {
+        for (i = 0; i < NumVrtcs; i++)
+	    IPFreeVertex(Vrtcs[i]);
+	IritFree(Vrtcs);
+	IritFree(Tris);
+        return NULL;
+    }
+
+    PVIdx = IPPolyVrtxIdxNew(NumVrtcs, NumTris);
+    PVIdx -> PObj = NULL;
+    PVIdx -> TriangularMesh = TRUE;
+    PVIdx -> _AuxVIndices = Tris;
+    IRIT_GEN_COPY(PVIdx -> Vertices, Vrtcs,
+		  sizeof(IPVertexStruct *) * NumVrtcs);
+    PVIdx -> Vertices[NumVrtcs] = NULL;
+    for (i = 0; i < NumTris; i++)
+        PVIdx -> Polygons[i] = &Tris[4 * i];
+    PVIdx -> Polygons[NumTris] = NULL;
+
+    IritFree(Vrtcs);
+
+    return PVIdx;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               M
 *   Extract a polygonal iso-surface out of a trivariate function.            M
@@ -537,7 +815,7 @@ IPObjectStruct *MCExtractIsoSurface3(IPObjectStruct *ImageList,
 static CagdRType GetOneScalar(FILE *Fin)
 {
     short i;
-    long l;
+    int l;
     float f;
     double d;
     CagdRType r;
@@ -555,7 +833,7 @@ static CagdRType GetOneScalar(FILE *Fin)
 	    r = getc(Fin) * 256.0 + i;
 	    break;
 	case INPUT_LONG:
-	    if (fread(&l, 4, 1, Fin) != 4)
+	    if (fread(&l, 4, 1, Fin) != 1)
 		return IRIT_INFNTY;
 	    r = l;
 	    break;
@@ -563,12 +841,12 @@ static CagdRType GetOneScalar(FILE *Fin)
 	    r = getc(Fin);
 	    break;
 	case INPUT_IRIT_FLOAT:
-	    if (fread(&f, 4, 1, Fin) != 4)
+	    if (fread(&f, 4, 1, Fin) != 1)
 		return IRIT_INFNTY;
 	    r = f;
 	    break;
 	case INPUT_IRIT_DOUBLE:
-	    if (fread(&d, 8, 1, Fin) != 8)
+	    if (fread(&d, 8, 1, Fin) != 1)
 		return IRIT_INFNTY;
 	    r = d;
 	    break;
@@ -580,6 +858,189 @@ static CagdRType GetOneScalar(FILE *Fin)
     return r;
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Returns the size, in bytes, of one scalar in a binary input file.       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   None                                                                     *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   Size of one scalar, or zero if not a binary format.               *
+*****************************************************************************/
+static int MCScalarSize(void)
+{
+    switch (GlblInputFormat) {
+	case INPUT_INTEGER:
+	    return 2;
+	case INPUT_LONG:
+	case INPUT_IRIT_FLOAT:
+	    return 4;
+	case INPUT_BYTE:
+	    return 1;
+	case INPUT_IRIT_DOUBLE:
+	    return 8;
+	default:
+	    return 0;
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Reads Size scalars, one layer of the volume, from the input file.        *
+* Binary formats are read in large blocks, not scalar by scalar.             *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   f:       Input file to read from.                                        *
+*   Layer:   Where to place the Size read scalars.                           *
+*   Size:    Number of scalars to read.                                      *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   TRUE if succesful, FALSE otherwise (i.e. premature EOF).          *
+*****************************************************************************/
+static int MCReadLayer(FILE *f, CagdRType *Layer, int Size)
+{
+    int i, j, n, ChunkSize,
+	ElemSize = MCScalarSize();
+    double Buf[MC_READ_BUF_SIZE];		 /* Aligned for all formats. */
+
+    if (ElemSize == 0) {
+        for (i = 0; i < Size; i++) {
+	    if ((*Layer++ = GetOneScalar(f)) == IRIT_INFNTY)
+	        return FALSE;
+	}
+	return TRUE;
+    }
+
+    ChunkSize = sizeof(Buf) / ElemSize;
+    for (i = 0; i < Size; i += n) {
+        n = IRIT_MIN(Size - i, ChunkSize);
+	if ((int) fread(Buf, ElemSize, n, f) != n)
+	    return FALSE;
+
+	switch (GlblInputFormat) {
+	    case INPUT_INTEGER:
+	        {
+		    unsigned char
+		        *p = (unsigned char *) Buf;
+
+		    for (j = 0; j < n; j++, p += 2)
+		        *Layer++ = p[1] * 256.0 + p[0];
+		}
+		break;
+	    case INPUT_LONG:
+		for (j = 0; j < n; j++)
+		    *Layer++ = ((int *) Buf)[j];
+		break;
+	    case INPUT_BYTE:
+		for (j = 0; j < n; j++)
+		    *Layer++ = ((unsigned char *) Buf)[j];
+		break;
+	    case INPUT_IRIT_FLOAT:
+		for (j = 0; j < n; j++)
+		    *Layer++ = ((float *) Buf)[j];
+		break;
+	    case INPUT_IRIT_DOUBLE:
+		for (j = 0; j < n; j++)
+		    *Layer++ = Buf[j];
+		break;
+	    default:
+		break;
+	}
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Skips NumLayers layers of Size scalars each in the input file.  Binary   *
+* files are seeked over, if possible, rather than read.                      *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   f:          Input file to skip in.                                       *
+*   NumLayers:  Number of layers to skip, possibly zero.                     *
+*   Size:       Number of scalars in one layer.                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:   TRUE if succesful, FALSE otherwise (i.e. premature EOF).          *
+*****************************************************************************/
+static int MCSkipLayers(FILE *f, int NumLayers, int Size)
+{
+    int i,
+	ElemSize = MCScalarSize();
+
+    if (NumLayers <= 0)
+        return TRUE;
+
+    if (ElemSize > 0 &&
+	fseek(f, ((long) Size) * ElemSize * NumLayers, SEEK_CUR) == 0)
+        return TRUE;
+
+    for (i = Size * NumLayers; i > 0; i--) {
+        if (GetOneScalar(f) == IRIT_INFNTY)
+	    return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Locates the lattice vertex or lattice edge that the given iso surface    *
+* vertex, as computed by MCThresholdCube for CCS, lies on, and returns the   *
+* slot that holds the index of this vertex in the indexed mesh.              *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   CCS:       The cube that was just thresholded.                           *
+*   Pos:       A vertex of a polygon of CCS's iso surface.                   *
+*   Cache:     Of mesh indices of vertices on the current slab's lattice.    *
+*   x, y:      Lattice indices of the lowest corner of CCS.                  *
+*   Skip:      Skip factor between lattice samples.                          *
+*   Width:     Of the volumetric data set.                                   *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int *:     Slot in Cache holding the mesh index (plus one) of the vertex *
+*	       at Pos, zero if none yet, or NULL if not found.               *
+*****************************************************************************/
+static int *MCIdxVrtxSlot(const MCCubeCornerScalarStruct *CCS,
+			  const CagdRType *Pos,
+			  MCIdxCacheStruct *Cache,
+			  int x,
+			  int y,
+			  int Skip,
+			  int Width)
+{
+    int i, c, Idx;
+
+    /* Iso values that hit a lattice point exactly yield it as a vertex. */
+    for (i = 0; i < 8; i++) {
+        if (MC_PT_SAME(Pos, CCS -> _VrtxPos[i])) {
+	    Idx = (y + MCCrnrDY[i] * Skip) * Width + x + MCCrnrDX[i] * Skip;
+	    return &Cache -> Crnrs[MCCrnrDZ[i]][Idx];
+	}
+    }
+
+    for (i = 0; i < 12; i++) {
+        if (CCS -> _Inter[i]._HighV != MC_VRTX_NONE &&
+	    MC_PT_SAME(Pos, CCS -> _Inter[i]._Pos)) {
+	    c = MCEdgeCrnr[i];
+	    Idx = (y + MCCrnrDY[c] * Skip) * Width + x + MCCrnrDX[c] * Skip;
+
+	    switch (MCEdgeDir[i]) {
+	        case 0:
+		    return &Cache -> XEdges[MCCrnrDZ[c]][Idx];
+	        case 1:
+		    return &Cache -> YEdges[MCCrnrDZ[c]][Idx];
+	        default:
+		    return &Cache -> ZEdges[Idx];
+	    }
+	}
+    }
+
+    return NULL;
+}
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 *   Reads input file and returns one cube at a time.                         *
@@ -597,8 +1058,6 @@ static MCCubeCornerScalarStruct *GetCubeFile(FILE *f, int FirstTime)
 	LayerNumber = -1,
 	LayerCountX = -1,
 	LayerCountY = 0;
-    int i, j;
-    CagdRType *p;
 
     if (FirstTime) {
 	/* Initialize the CCS constant data */
@@ -609,9 +1068,7 @@ static MCCubeCornerScalarStruct *GetCubeFile(FILE *f, int FirstTime)
 	LayerCountX = -1;
 	LayerCountY = 0;
 
-	for (p = GlblLayerTwo, i = 0; i < GlblDataWidth * GlblDataHeight; i++)
-	    if ((*p++ = GetOneScalar(f)) == IRIT_INFNTY)
-	        return NULL;
+	MCReadLayer(f, GlblLayerTwo, GlblDataWidth * GlblDataHeight);
 
 	return NULL;
     }
@@ -623,13 +1080,11 @@ static MCCubeCornerScalarStruct *GetCubeFile(FILE *f, int FirstTime)
 
 	IRIT_SWAP(CagdRType *, GlblLayerOne, GlblLayerTwo);/*Swap two layers.*/
 
-	for (j = 0; j < GlblSkipInputData; j++) { /* And get the next layer. */
-	    for (p = GlblLayerTwo, i = 0;
-		 i < GlblDataWidth * GlblDataHeight;
-		 i++)
-	        if ((*p++ = GetOneScalar(f)) == IRIT_INFNTY)
-		    return NULL;
-	}
+	/* And get the next layer. */
+	if (!MCSkipLayers(f, GlblSkipInputData - 1,
+			  GlblDataWidth * GlblDataHeight) ||
+	    !MCReadLayer(f, GlblLayerTwo, GlblDataWidth * GlblDataHeight))
+	    return NULL;
 
 	LayerCountX = 0;
 	LayerCountY = 0;
@@ -947,7 +1402,6 @@ TrivTVStruct *TrivLoadVolumeIntoTV(const char *FileName,
 				   IrtVecType VolSize,
 				   IrtVecType Orders)
 {
-    int i;
     FILE *f;
     TrivTVStruct
         *TV = TrivBspTVNew((int) VolSize[0],
@@ -988,13 +1442,11 @@ TrivTVStruct *TrivLoadVolumeIntoTV(const char *FileName,
 
     GlblInputFormat = (ScalarFormatType) DataType;
 
-    for (i = TV -> ULength * TV -> VLength * TV -> WLength; i > 0; i--) {
-	if ((*R++ = GetOneScalar(f)) == IRIT_INFNTY) {
-	    TrivTVFree(TV);
-	    fclose(f);
-	    TRIV_FATAL_ERROR(TRIV_ERR_READ_FAIL);
-	    return NULL;
-	}
+    if (!MCReadLayer(f, R, TV -> ULength * TV -> VLength * TV -> WLength)) {
+	TrivTVFree(TV);
+	fclose(f);
+	TRIV_FATAL_ERROR(TRIV_ERR_READ_FAIL);
+	return NULL;
     }
 
     fclose(f);
@@ -34,6 +34,14 @@ static void TrivTVMultEvalAux(CagdPType *Mesh,
 			      int NumOfParams,
 			      IrtRType *Results,
 			      int ResultsStep);
+static void TrivTVEvalBasisFuncs(const CagdRType *KV,
+				 int Order,
+				 int Span,
+				 CagdRType t,
+				 CagdRType *N,
+				 CagdRType *DN,
+				 CagdRType *Left,
+				 CagdRType *Right);
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -1260,6 +1268,402 @@ void TrivTVBlockEvalDone(void)
     IritFree(GlblBlockEvals);
 }
 
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Evaluates the Order non zero B-spline basis functions at t, and         *
+* optionally their first derivatives.  Uses no static data.                  *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   KV:      Knot sequence.                                                  *
+*   Order:   Of the B-spline basis functions.                                *
+*   Span:    Index of knot interval holding t, KV[Span] <= t < KV[Span+1].  *
+*   t:       Parameter to evaluate the basis functions at.                   *
+*   N:       Where to place the Order basis function values.                 *
+*   DN:      Where to place the Order derivatives, or NULL if not needed.    *
+*   Left:    Auxiliary vector of size Order.                                 *
+*   Right:   Auxiliary vector of size Order.                                 *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void TrivTVEvalBasisFuncs(const CagdRType *KV,
+				 int Order,
+				 int Span,
+				 CagdRType t,
+				 CagdRType *N,
+				 CagdRType *DN,
+				 CagdRType *Left,
+				 CagdRType *Right)
+{
+    int j, r,
+	p = Order - 1;
+
+    N[0] = 1.0;
+    if (DN != NULL && p == 0)
+        DN[0] = 0.0;
+
+    for (j = 1; j < Order; j++) {
+        CagdRType
+	    Saved = 0.0;
+
+	if (DN != NULL && j == p)	 /* Keep the degree p - 1 functions. */
+	    CAGD_GEN_COPY(DN, N, sizeof(CagdRType) * p);
+
+        Left[j] = t - KV[Span + 1 - j];
+	Right[j] = KV[Span + j] - t;
+	for (r = 0; r < j; r++) {
+	    CagdRType
+		Denom = Right[r + 1] + Left[j - r],
+	        Temp = Denom == 0.0 ? 0.0 : N[r] / Denom;
+
+	    N[r] = Saved + Right[r + 1] * Temp;
+	    Saved = Left[j - r] * Temp;
+	}
+	N[j] = Saved;
+    }
+
+    if (DN != NULL && p > 0) {
+        /* Derivatives from the degree p - 1 functions, in place. */
+        for (r = p; r >= 0; r--) {
+	    CagdRType
+	        d1 = KV[Span + r] - KV[Span + r - p],
+	        d2 = KV[Span + r + 1] - KV[Span + r + 1 - p],
+		D = 0.0;
+
+	    if (r > 0 && d1 != 0.0)
+	        D += DN[r - 1] / d1;
+	    if (r < p && d2 != 0.0)
+	        D -= DN[r] / d2;
+	    DN[r] = p * D;
+	}
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Evaluates the given trivariate at NumOfParams parametric locations, and  M
+* optionally its Jacobian at these locations, in one batch.                  M
+*   The locations are processed in the given order and the basis functions M
+* of a direction are reused while the parameter in that direction is        M
+* unchanged, as is typical of locations sampled on a grid.  Hence, coherent M
+* input (i.e. mesh vertices in order) is evaluated faster.                  M
+*   Unlike TrivTVEval and the TrivTVBlockEval* functions, no static data is  M
+* used and hence this function is reentrant.  It is the building block of    M
+* freeform deformations, see TrivFFDPolygons.                                M
+*   Only the first three coordinates of TV's point type are evaluated.       M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   TV:            To evaluate at the NumOfParams locations.                 M
+*   Params:        The (u, v, w) parametric locations to evaluate TV at.     M
+*   NumOfParams:   Size of vector Params.                                    M
+*   EvalJacobian:  TRUE to also compute the Jacobian at each location.       M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   TrivTVBlockEvalStruct *:  A vector of NumOfParams evaluations, in the    M
+*		   order of Params.  Pos holds the Euclidean (projected)     M
+*		   location and Jcbn[0..2] the partial derivatives in u, v,  M
+*		   and w, if EvalJacobian.  Allocated dynamically.	     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   TrivTVEval, TrivTVMultEval, TrivTVBlockEvalInit, TrivFFDPolygons         M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   TrivTVEvalPts, evaluation, trivariates, freeform deformation             M
+*****************************************************************************/
+TrivTVBlockEvalStruct *TrivTVEvalPts(const TrivTVStruct *TV,
+				     const CagdPType *Params,
+				     int NumOfParams,
+				     CagdBType EvalJacobian)
+{
+    int i, j, k, l, n, MaxCoord, UVLength, MaxOrder,
+	Orders[3], Lengths[3], Spans[3];
+    CagdRType Min[3], Max[3], LastPrms[3], *Basis[3], *DBasis[3], *VW,
+	*DVW, *VDW, *Left, *Right;
+    CagdBType IsNotRational;
+    const CagdRType *KVs[3];
+    TrivTVStruct
+	*TVTmp = NULL;
+    TrivTVBlockEvalStruct
+	*Evals = (TrivTVBlockEvalStruct *)
+	    IritMalloc(sizeof(TrivTVBlockEvalStruct) * IRIT_MAX(NumOfParams, 1));
+
+    if (NumOfParams <= 0)
+        return Evals;
+
+    if (TRIV_IS_BEZIER_TV(TV))
+        TV = TVTmp = TrivCnvrtBzr2BspTV(TV);
+    else if (TRIV_IS_PERIODIC_TV(TV))
+        TV = TVTmp = TrivCnvrtPeriodic2FloatTV(TV);
+
+    IsNotRational = !TRIV_IS_RATIONAL_TV(TV);
+    MaxCoord = IRIT_MIN(CAGD_NUM_OF_PT_COORD(TV -> PType), 3);
+    Orders[0] = TV -> UOrder;
+    Orders[1] = TV -> VOrder;
+    Orders[2] = TV -> WOrder;
+    Lengths[0] = TV -> ULength;
+    Lengths[1] = TV -> VLength;
+    Lengths[2] = TV -> WLength;
+    KVs[0] = TV -> UKnotVector;
+    KVs[1] = TV -> VKnotVector;
+    KVs[2] = TV -> WKnotVector;
+    UVLength = Lengths[0] * Lengths[1];
+    MaxOrder = IRIT_MAX(IRIT_MAX(Orders[0], Orders[1]), Orders[2]);
+    TrivTVDomain(TV, &Min[0], &Max[0], &Min[1], &Max[1], &Min[2], &Max[2]);
+
+    /* Allocate all auxiliary vectors at once. */
+    Basis[0] = (CagdRType *) IritMalloc(sizeof(CagdRType) *
+				    (6 * MaxOrder + 3 * Orders[1] * Orders[2]));
+    Basis[1] = &Basis[0][MaxOrder];
+    Basis[2] = &Basis[1][MaxOrder];
+    DBasis[0] = &Basis[2][MaxOrder];
+    DBasis[1] = &DBasis[0][MaxOrder];
+    DBasis[2] = &DBasis[1][MaxOrder];
+    VW = &DBasis[2][MaxOrder];
+    DVW = &VW[Orders[1] * Orders[2]];
+    VDW = &DVW[Orders[1] * Orders[2]];
+    Left = (CagdRType *) IritMalloc(sizeof(CagdRType) * 2 * MaxOrder);
+    Right = &Left[MaxOrder];
+
+    for (n = 0; n < NumOfParams; n++) {
+	CagdBType
+	    VWChanged = FALSE;
+	int Base;
+	CagdRType Val[4], DVal[3][4];
+	TrivTVBlockEvalStruct
+	    *Eval = &Evals[n];
+
+	/* Update the basis functions in the directions that changed. */
+	for (l = 0; l < 3; l++) {
+	    CagdRType
+	        t = Params[n][l];
+
+	    if (n > 0 && t == LastPrms[l])
+	        continue;
+
+	    if (t < Min[l] - IRIT_EPS || t > Max[l] + IRIT_EPS)
+	        TRIV_FATAL_ERROR(TRIV_ERR_WRONG_DOMAIN);
+	    LastPrms[l] = t;
+
+	    if (t > Max[l] - IRIT_UEPS * 2)
+	        t = Max[l] - IRIT_UEPS * 2;
+	    else if (t < Min[l])
+	        t = Min[l];
+
+	    Spans[l] = BspKnotLastIndexLE(KVs[l], Lengths[l] + Orders[l], t);
+	    Spans[l] = IRIT_BOUND(Spans[l], Orders[l] - 1, Lengths[l] - 1);
+
+	    TrivTVEvalBasisFuncs(KVs[l], Orders[l], Spans[l], t,
+				 Basis[l], EvalJacobian ? DBasis[l] : NULL,
+				 Left, Right);
+	    if (l > 0)
+	        VWChanged = TRUE;
+	}
+
+	if (VWChanged) {
+	    CagdRType
+		*VWPtr = VW,
+		*DVWPtr = DVW,
+		*VDWPtr = VDW;
+
+	    for (k = 0; k < Orders[2]; k++) {
+	        for (j = 0; j < Orders[1]; j++) {
+		    *VWPtr++ = Basis[1][j] * Basis[2][k];
+		    if (EvalJacobian) {
+		        *DVWPtr++ = DBasis[1][j] * Basis[2][k];
+			*VDWPtr++ = Basis[1][j] * DBasis[2][k];
+		    }
+		}
+	    }
+	}
+
+	/* Blend the (Orders[0] x Orders[1] x Orders[2]) control points. */
+	Base = (Spans[2] - Orders[2] + 1) * UVLength +
+	       (Spans[1] - Orders[1] + 1) * Lengths[0] +
+	       (Spans[0] - Orders[0] + 1);
+	IRIT_ZAP_MEM(Val, sizeof(Val));
+	IRIT_ZAP_MEM(DVal, sizeof(DVal));
+
+	for (l = IsNotRational; l <= MaxCoord; l++) {
+	    CagdRType
+		*Points = TV -> Points[l],
+		*VWPtr = VW,
+		*DVWPtr = DVW,
+		*VDWPtr = VDW;
+
+	    for (k = 0; k < Orders[2]; k++) {
+	        for (j = 0; j < Orders[1]; j++) {
+		    CagdRType
+			*P = &Points[Base + k * UVLength + j * Lengths[0]],
+			Sum = 0.0,
+			DSum = 0.0;
+
+		    for (i = 0; i < Orders[0]; i++)
+		        Sum += P[i] * Basis[0][i];
+		    if (EvalJacobian) {
+		        for (i = 0; i < Orders[0]; i++)
+			    DSum += P[i] * DBasis[0][i];
+		    }
+
+		    Val[l] += Sum * *VWPtr;
+		    if (EvalJacobian) {
+		        DVal[0][l] += DSum * *VWPtr;
+			DVal[1][l] += Sum * *DVWPtr++;
+			DVal[2][l] += Sum * *VDWPtr++;
+		    }
+		    VWPtr++;
+		}
+	    }
+	}
+
+	/* Project rational results, the Jacobian by the quotient rule. */
+	IRIT_PT_RESET(Eval -> Pos);
+	if (IsNotRational) {
+	    for (l = 1; l <= MaxCoord; l++)
+	        Eval -> Pos[l - 1] = Val[l];
+	}
+	else {
+	    for (l = 1; l <= MaxCoord; l++)
+	        Eval -> Pos[l - 1] = Val[0] == 0.0 ? IRIT_INFNTY
+						   : Val[l] / Val[0];
+	}
+
+	if (EvalJacobian) {
+	    for (j = 0; j < 3; j++) {
+	        IRIT_PT_RESET(Eval -> Jcbn[j]);
+		for (l = 1; l <= MaxCoord; l++) {
+		    if (IsNotRational)
+		        Eval -> Jcbn[j][l - 1] = DVal[j][l];
+		    else if (Val[0] != 0.0)
+		        Eval -> Jcbn[j][l - 1] = (DVal[j][l] -
+				    Eval -> Pos[l - 1] * DVal[j][0]) / Val[0];
+		}
+	    }
+	}
+    }
+
+    IritFree(Basis[0]);
+    IritFree(Left);
+    if (TVTmp != NULL)
+        TrivTVFree(TVTmp);
+
+    return Evals;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Applies a freeform deformation (FFD) to the given polygons, in place.    M
+* The vertices of Pls are considered parametric locations in the domain of   M
+* TV, and are mapped through TV.  All vertices are evaluated in one batch    M
+* using TrivTVEvalPts.  Normals, if any, are mapped using the inverse        M
+* transpose of the Jacobian of TV, and the planes of the polygons are        M
+* updated as well.						             M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   TV:       The deforming trivariate, a three space (E3/P3) function.      M
+*   Pls:      Polygons (or polylines) to deform, in place.  The vertices of  M
+*	      Pls must be in the parametric domain of TV.		     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   TrivTVEvalPts, TrivTVEval                                                M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   TrivFFDPolygons, freeform deformation, trivariates                       M
+*****************************************************************************/
+void TrivFFDPolygons(const TrivTVStruct *TV, IPPolygonStruct *Pls)
+{
+    int n,
+	NumOfParams = 0;
+    CagdBType
+	HasNormals = FALSE;
+    CagdPType *Params;
+    IPPolygonStruct *Pl;
+    IPVertexStruct *V;
+    TrivTVBlockEvalStruct *Evals;
+
+    for (Pl = Pls; Pl != NULL; Pl = Pl -> Pnext) {
+        V = Pl -> PVertex;
+	if (V == NULL)
+	    continue;
+
+	do {
+	    NumOfParams++;
+	    if (IP_HAS_NORMAL_VRTX(V))
+	        HasNormals = TRUE;
+	    V = V -> Pnext;
+	}
+	while (V != NULL && V != Pl -> PVertex);
+    }
+
+    if (NumOfParams == 0)
+        return;
+
+    Params = (CagdPType *) IritMalloc(sizeof(CagdPType) * NumOfParams);
+    for (Pl = Pls, n = 0; Pl != NULL; Pl = Pl -> Pnext) {
+        if ((V = Pl -> PVertex) == NULL)
+	    continue;
+
+	do {
+	    IRIT_PT_COPY(Params[n++], V -> Coord);
+	    V = V -> Pnext;
+	}
+	while (V != NULL && V != Pl -> PVertex);
+    }
+
+    Evals = TrivTVEvalPts(TV, (const CagdPType *) Params, NumOfParams,
+			  HasNormals);
+
+    for (Pl = Pls, n = 0; Pl != NULL; Pl = Pl -> Pnext) {
+        if ((V = Pl -> PVertex) == NULL)
+	    continue;
+
+	do {
+	    TrivTVBlockEvalStruct
+		*Eval = &Evals[n++];
+
+	    IRIT_PT_COPY(V -> Coord, Eval -> Pos);
+
+	    if (IP_HAS_NORMAL_VRTX(V)) {
+	        CagdVType Nrml, Crs;
+		CagdRType
+		    (*J)[3] = Eval -> Jcbn;
+
+		/* Map the normal by the inverse transpose of the Jacobian, */
+		/* computed as the cofactors matrix (columns are the cross  */
+		/* products below), up to a positive scale.		    */
+		IRIT_CROSS_PROD(Nrml, J[1], J[2]);
+		IRIT_VEC_SCALE(Nrml, V -> Normal[0]);
+		IRIT_CROSS_PROD(Crs, J[2], J[0]);
+		IRIT_VEC_SCALE(Crs, V -> Normal[1]);
+		IRIT_PT_ADD(Nrml, Nrml, Crs);
+		IRIT_CROSS_PROD(Crs, J[0], J[1]);
+		IRIT_VEC_SCALE(Crs, V -> Normal[2]);
+		IRIT_PT_ADD(Nrml, Nrml, Crs);
+
+		IRIT_CROSS_PROD(Crs, J[0], J[1]);
+		if (IRIT_DOT_PROD(Crs, J[2]) < 0.0)	 /* Negative det(J). */
+		    IRIT_VEC_SCALE(Nrml, -1.0);
+
+		if (!IRIT_PT_APX_EQ_ZERO_EPS(Nrml, IRIT_UEPS)) {
+		    IRIT_VEC_NORMALIZE(Nrml);
+		    IRIT_VEC_COPY(V -> Normal, Nrml);
+		}
+	    }
+
+	    V = V -> Pnext;
+	}
+	while (V != NULL && V != Pl -> PVertex);
+
+	if (IP_HAS_PLANE_POLY(Pl))
+	    IPUpdatePolyPlane(Pl);
+    }
+
+    IritFree(Params);
+    IritFree(Evals);
+}
+
 #ifdef DEBUG_TRIV_BLOCK_EVAL
 
 #define ORDER		4
@@ -39,10 +39,12 @@ CagdPolygonStruct *TrngTriSrf2Polygons(const TrngTriangSrfStruct *TriSrf,
 				       CagdBType ComputeNormals,
 				       CagdBType ComputeUV)
 {
-    int i, j;
-    CagdPtStruct *Pts;
-    CagdVecStruct *Nrml;
-    CagdRType UMin, UMax, VMin, VMax, WMin, WMax, Du, Dv, u, v;
+    int i, j,
+	NumPts = TRNG_GRID_IJ(FineNess, FineNess, 0) + 1;
+    CagdPType *Pts;
+    CagdVType
+	*Nrmls = NULL;
+    CagdRType UMin, UMax, VMin, VMax, WMin, WMax, Du, Dv;
     CagdPolygonStruct
 	*CagdPlList = NULL;
 
@@ -50,93 +52,79 @@ CagdPolygonStruct *TrngTriSrf2Polygons(const TrngTriangSrfStruct *TriSrf,
     Du = (UMax - UMin - IRIT_UEPS) / FineNess;
     Dv = (VMax - VMin - IRIT_UEPS) / FineNess;
 
-    Pts = (CagdPtStruct *) IritMalloc(sizeof(CagdPtStruct) * (FineNess + 1));
-    Nrml = (CagdVecStruct *) IritMalloc(sizeof(CagdVecStruct) * (FineNess + 1));
-
-    for (v = VMin, j = 0; j <= FineNess; v += Dv, j++) { /* Eval first row. */
-	CagdRType
-	    *R = TrngTriSrfEval2(TriSrf, UMin, v);
+    Pts = (CagdPType *) IritMalloc(sizeof(CagdPType) * NumPts);
+    if (ComputeNormals)
+        Nrmls = (CagdVType *) IritMalloc(sizeof(CagdVType) * NumPts);
+
+    /* Evaluate all lattice points at once, or one by one if not Bezier. */
+    if (!TrngTriSrfEvalGrid(TriSrf, FineNess, Pts, Nrmls)) {
+        for (i = 0; i <= FineNess; i++) {
+	    for (j = 0; i + j <= FineNess; j++) {
+	        int Idx = TRNG_GRID_IJ(FineNess, i, j);
+	        CagdRType
+		    *R = TrngTriSrfEval2(TriSrf, UMin + i * Du, VMin + j * Dv);
+
+		if (R == NULL) {
+		    IritFree(Pts);
+		    if (Nrmls != NULL)
+		        IritFree(Nrmls);
+		    return NULL;
+		}
+		CagdCoerceToE3(Pts[Idx], &R, -1, TriSrf -> PType);
 
-	CagdCoerceToE3(Pts[j].Pt, &R, -1, TriSrf -> PType);
+		if (ComputeNormals) {
+		    CagdVecStruct
+		        *N = TrngTriSrfNrml(TriSrf, UMin + i * Du,
+					    VMin + j * Dv);
 
-	if (ComputeNormals) {
-	    Nrml[j] = *TrngTriSrfNrml(TriSrf, UMin, v);
+		    IRIT_VEC_COPY(Nrmls[Idx], N -> Vec);
+		}
+	    }
 	}
     }
 
-    for (u = UMin + Du, i = 1; i <= FineNess; u += Du, i++) {
-	CagdPType LastPt;
-	CagdVType LastNrml;
-
-	for (v = VMin, j = 0; j + i <= FineNess; v += Dv, j++) {
-	    CagdRType
-	        *R = TrngTriSrfEval2(TriSrf, u, v);
-	    CagdPType NewPt;
-	    CagdVType NewNrml;
-	    CagdPolygonStruct
-	        *CagdPl = CagdPolygonNew(3);
-
-	    CagdCoerceToE3(NewPt, &R, -1, TriSrf -> PType);
-
-	    if (ComputeNormals) {
-		CagdVecStruct
-		    *N = TrngTriSrfNrml(TriSrf, u, v);
-
-		IRIT_PT_COPY(NewNrml, N -> Vec);
-	    }
-
-	    if (j > 0) {
-		IRIT_PT_COPY(CagdPl -> U.Polygon[0].Pt, LastPt);
-		IRIT_PT_COPY(CagdPl -> U.Polygon[1].Pt, NewPt);
-		IRIT_PT_COPY(CagdPl -> U.Polygon[2].Pt, Pts[j].Pt);
-		if (ComputeNormals) {
-		    IRIT_PT_COPY(CagdPl -> U.Polygon[0].Nrml, LastNrml);
-		    IRIT_PT_COPY(CagdPl -> U.Polygon[1].Nrml, NewNrml);
-		    IRIT_PT_COPY(CagdPl -> U.Polygon[2].Nrml, Nrml[j].Vec);
-		}
-		if (ComputeUV) {
-		    CagdPl -> U.Polygon[0].UV[0] = u;
-		    CagdPl -> U.Polygon[0].UV[1] = v - Dv;
-		    CagdPl -> U.Polygon[1].UV[0] = u;
-		    CagdPl -> U.Polygon[1].UV[1] = v;
-		    CagdPl -> U.Polygon[2].UV[0] = u - Du;
-		    CagdPl -> U.Polygon[2].UV[1] = v - Dv;
+    /* Every lattice point (i, j), i > 0, spans two triangles with row i-1. */
+    for (i = 1; i <= FineNess; i++) {
+	for (j = 0; j + i <= FineNess; j++) {
+	    int k, l, IJ[2][3][2];
+
+	    /* Triangles (i, j-1), (i, j), (i-1, j) & (i-1, j+1), (i-1, j), (i, j). */
+	    IJ[0][0][0] = i;
+	    IJ[0][0][1] = j - 1;
+	    IJ[0][1][0] = i;
+	    IJ[0][1][1] = j;
+	    IJ[0][2][0] = i - 1;
+	    IJ[0][2][1] = j;
+	    IJ[1][0][0] = i - 1;
+	    IJ[1][0][1] = j + 1;
+	    IJ[1][1][0] = i - 1;
+	    IJ[1][1][1] = j;
+	    IJ[1][2][0] = i;
+	    IJ[1][2][1] = j;
+
+	    for (k = j > 0 ? 0 : 1; k < 2; k++) {
+	        CagdPolygonStruct
+		    *CagdPl = CagdPolygonNew(3);
+
+		for (l = 0; l < 3; l++) {
+		    int Idx = TRNG_GRID_IJ(FineNess, IJ[k][l][0], IJ[k][l][1]);
+
+		    IRIT_PT_COPY(CagdPl -> U.Polygon[l].Pt, Pts[Idx]);
+		    if (ComputeNormals)
+		        IRIT_PT_COPY(CagdPl -> U.Polygon[l].Nrml, Nrmls[Idx]);
+		    if (ComputeUV) {
+		        CagdPl -> U.Polygon[l].UV[0] = UMin + IJ[k][l][0] * Du;
+			CagdPl -> U.Polygon[l].UV[1] = VMin + IJ[k][l][1] * Dv;
+		    }
 		}
 		IRIT_LIST_PUSH(CagdPl, CagdPlList);
-
-	        CagdPl = CagdPolygonNew(3);
-	    }
-
-	    IRIT_PT_COPY(CagdPl -> U.Polygon[0].Pt, Pts[j + 1].Pt);
-	    IRIT_PT_COPY(CagdPl -> U.Polygon[1].Pt, Pts[j].Pt);
-	    IRIT_PT_COPY(CagdPl -> U.Polygon[2].Pt, NewPt);
-	    if (ComputeNormals) {
-		IRIT_PT_COPY(CagdPl -> U.Polygon[0].Nrml, Nrml[j + 1].Vec);
-		IRIT_PT_COPY(CagdPl -> U.Polygon[1].Nrml, Nrml[j].Vec);
-		IRIT_PT_COPY(CagdPl -> U.Polygon[2].Nrml, NewNrml);
-	    }
-	    if (ComputeUV) {
-		CagdPl -> U.Polygon[0].UV[0] = u - Du;
-		CagdPl -> U.Polygon[0].UV[1] = v;
-		CagdPl -> U.Polygon[1].UV[0] = u - Du;
-		CagdPl -> U.Polygon[1].UV[1] = v - Dv;
-		CagdPl -> U.Polygon[2].UV[0] = u;
-		CagdPl -> U.Polygon[2].UV[1] = v;
 	    }
-	    IRIT_LIST_PUSH(CagdPl, CagdPlList);
-
-	    IRIT_PT_COPY(LastPt, NewPt);
-	    IRIT_PT_COPY(Pts[j].Pt, LastPt);
-	    if (ComputeNormals) {
-		IRIT_PT_COPY(LastNrml, NewNrml);
-		IRIT_PT_COPY(Nrml[j].Vec, LastNrml);
-	    }
-
 	}
     }
 
     IritFree(Pts);
-    IritFree(Nrml);
+    if (Nrmls != NULL)
+        IritFree(Nrmls);
 
     return CagdPlList;
 }
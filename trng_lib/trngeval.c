@@ -11,6 +11,16 @@
 
 #define MAX_MULTS_VAL	20  /* Maximal order of triangular Bezier supported. */
 
+IRIT_STATIC_DATA int
+    GlblGridLength = -1,
+    GlblGridFineNess = -1;
+IRIT_STATIC_DATA CagdRType
+    *GlblGridBasis = NULL;
+
+static const CagdRType *TrngBzrTriSrfGridBasis(const TrngTriangSrfStruct
+					                             *TriSrf,
+					       int FineNess);
+
 /*****************************************************************************
 * DESCRIPTION:                                                               *
 * Evaluates the following (in floating point arithmetic):		     *
@@ -79,23 +89,29 @@ CagdRType *TrngTriSrfEval(const TrngTriangSrfStruct *TriSrf,
 	Length = TriSrf -> Length;
     CagdBType
 	IsNotRational = !TRNG_IS_RATIONAL_TRISRF(TriSrf);
-    CagdRType B, uu, vv, ww,
+    CagdRType B, uu, vv, WPowers[MAX_MULTS_VAL],
 	* const *Points = TriSrf -> Points;
 
     for (j = IsNotRational; j <= MaxCoord; j++)
 	Pt[j] = 0.0;
 
     if (TRNG_IS_BEZIER_TRISRF(TriSrf)) {
+	if (Length > MAX_MULTS_VAL) {
+	    IRIT_WARNING_MSG("TrngLib: Fatal: Order of triangular Bezier too large - increase MAX_MULTS_VAL\n");
+	    return Pt;
+	}
+
+	/* Powers of w are needed in the reversed order of the loops below. */
+	for (i = 0, WPowers[0] = 1.0; i < Length - 1; i++)
+	    WPowers[i + 1] = WPowers[i] * w;
+
 	for (i = 0, uu = 1.0; i < Length; i++, uu *= u) {	    
 	    for (j = 0, vv = 1.0; j < Length - i; j++, vv *= v) {
-		int l, kk,
+		int l,
 		    k = Length - i - j - 1,
 		    Index = TRNG_MESH_IJK(TriSrf, i, j, k);
 
-		for (kk = 0, ww = 1.0; kk < k; kk++)
-		    ww *= w;
-
-		B = TrngIJChooseN(i, j, Length - 1) * uu * vv * ww;
+		B = TrngIJChooseN(i, j, Length - 1) * uu * vv * WPowers[k];
 
 		for (l = IsNotRational; l <= MaxCoord; l++)
 		    Pt[l] += B * Points[l][Index];
@@ -196,3 +212,182 @@ CagdVecStruct *TrngTriSrfNrml(const TrngTriangSrfStruct *TriSrf,
 
     return &Normal;
 }
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes, or fetches from a cache of the last computed table, the        *
+* Bernstein basis functions and their derivatives (with w = 1 - u - v) of   *
+* the given Bezier triangular surface, at all points of the lattice of      *
+* TrngTriSrfEvalGrid.  The table depends only on the order of TriSrf and    *
+* on FineNess, so successive patches of the same order share one table.     *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   TriSrf:     Bezier triangular surface to get the basis functions for.    *
+*   FineNess:   Number of samples along each edge of the domain, minus one.  *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   const CagdRType *:  Per lattice point, the NumCtl values, the NumCtl     *
+*		u derivatives and the NumCtl v derivatives of the basis      *
+*		functions, in the order of TriSrf -> Points.  NULL if error. *
+*****************************************************************************/
+static const CagdRType *TrngBzrTriSrfGridBasis(const TrngTriangSrfStruct
+					                             *TriSrf,
+					       int FineNess)
+{
+    int a, b, i, j,
+	Length = TriSrf -> Length,
+	n = Length - 1,
+	NumCtl = TRNG_TRISRF_MESH_SIZE(TriSrf);
+    CagdRType UMin, UMax, VMin, VMax, WMin, WMax, Du, Dv, *B,
+	UP[MAX_MULTS_VAL], VP[MAX_MULTS_VAL], WP[MAX_MULTS_VAL];
+
+    if (Length == GlblGridLength && FineNess == GlblGridFineNess)
+        return GlblGridBasis;
+
+    if (Length > MAX_MULTS_VAL) {
+	IRIT_WARNING_MSG("TrngLib: Fatal: Order of triangular Bezier too large - increase MAX_MULTS_VAL\n");
+	return NULL;
+    }
+
+    if (GlblGridBasis != NULL)
+        IritFree(GlblGridBasis);
+    GlblGridBasis = B = (CagdRType *)
+	IritMalloc(sizeof(CagdRType) * 3 * NumCtl *
+		   (TRNG_GRID_IJ(FineNess, FineNess, 0) + 1));
+    GlblGridLength = Length;
+    GlblGridFineNess = FineNess;
+
+    TrngTriSrfDomain(TriSrf, &UMin, &UMax, &VMin, &VMax, &WMin, &WMax);
+    Du = (UMax - UMin - IRIT_UEPS) / FineNess;
+    Dv = (VMax - VMin - IRIT_UEPS) / FineNess;
+
+    for (i = 0; i <= FineNess; i++) {
+        for (j = 0; i + j <= FineNess; j++, B += 3 * NumCtl) {
+	    CagdRType
+		u = UMin + i * Du,
+		v = VMin + j * Dv;
+
+	    for (a = 0, UP[0] = VP[0] = WP[0] = 1.0; a < n; a++) {
+	        UP[a + 1] = UP[a] * u;
+		VP[a + 1] = VP[a] * v;
+		WP[a + 1] = WP[a] * (1.0 - u - v);
+	    }
+
+	    for (a = 0; a <= n; a++) {
+	        for (b = 0; a + b <= n; b++) {
+		    int c = n - a - b,
+			Index = TRNG_MESH_IJK(TriSrf, a, b, c);
+		    CagdRType
+		        Bin = TrngIJChooseN(a, b, n),
+			DW = c > 0 ? c * UP[a] * VP[b] * WP[c - 1] : 0.0;
+
+		    B[Index] = Bin * UP[a] * VP[b] * WP[c];
+		    B[NumCtl + Index] =
+		        Bin * ((a > 0 ? a * UP[a - 1] * VP[b] * WP[c] : 0.0) -
+			       DW);
+		    B[2 * NumCtl + Index] =
+		        Bin * ((b > 0 ? b * UP[a] * VP[b - 1] * WP[c] : 0.0) -
+			       DW);
+		}
+	    }
+	}
+    }
+
+    return GlblGridBasis;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+* Evaluates the given triangular surface, and optionally its unit normals,   M
+* at all the points of a regular lattice over its domain, as is needed for   M
+* its tessellation.  Lattice point (i, j), i + j <= FineNess, is at          M
+* (UMin + i * Du, VMin + j * Dv) with Du, Dv the domain size divided by      M
+* FineNess, and is saved at index TRNG_GRID_IJ(FineNess, i, j).              M
+*   The Bernstein basis functions at the lattice points are computed once    M
+* per order and FineNess, and every patch is then evaluated as a product of  M
+* this table by its control points.                                          M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   TriSrf:     To evaluate on a lattice over its domain.                    M
+*   FineNess:   Number of samples along each edge of the domain, minus one.  M
+*   Pts:        Where to place the (FineNess + 1) * (FineNess + 2) / 2      M
+*		Euclidean evaluated points.				     M
+*   Nrmls:      Where to place the unit normals at the lattice points, or    M
+*		NULL if not needed.					     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   CagdBType:  TRUE if successful, FALSE if TriSrf is not a Bezier	     M
+*		triangular surface (in which case nothing is evaluated).    M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   TrngTriSrfEval2, TrngTriSrfNrml, TrngTriSrf2Polygons                     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   TrngTriSrfEvalGrid, evaluation, triangular surfaces                      M
+*****************************************************************************/
+CagdBType TrngTriSrfEvalGrid(const TrngTriangSrfStruct *TriSrf,
+			     int FineNess,
+			     CagdPType *Pts,
+			     CagdVType *Nrmls)
+{
+    int c, l, p,
+	NumCtl = TRNG_TRISRF_MESH_SIZE(TriSrf),
+	NumPts = TRNG_GRID_IJ(FineNess, FineNess, 0) + 1,
+	MaxCoord = IRIT_MIN(CAGD_NUM_OF_PT_COORD(TriSrf -> PType), 3);
+    CagdBType
+	IsNotRational = !TRNG_IS_RATIONAL_TRISRF(TriSrf);
+    const CagdRType *B;
+    CagdRType
+	* const *Points = TriSrf -> Points;
+
+    if (!TRNG_IS_BEZIER_TRISRF(TriSrf) ||
+	(B = TrngBzrTriSrfGridBasis(TriSrf, FineNess)) == NULL)
+        return FALSE;
+
+    for (p = 0; p < NumPts; p++, B += 3 * NumCtl) {
+        CagdRType Val[4], DU[4], DV[4];
+
+	IRIT_ZAP_MEM(Val, sizeof(Val));
+	IRIT_ZAP_MEM(DU, sizeof(DU));
+	IRIT_ZAP_MEM(DV, sizeof(DV));
+
+	for (l = IsNotRational; l <= MaxCoord; l++) {
+	    const CagdRType
+		*P = Points[l];
+
+	    for (c = 0; c < NumCtl; c++)
+	        Val[l] += B[c] * P[c];
+	    if (Nrmls != NULL) {
+	        for (c = 0; c < NumCtl; c++) {
+		    DU[l] += B[NumCtl + c] * P[c];
+		    DV[l] += B[2 * NumCtl + c] * P[c];
+		}
+	    }
+	}
+
+	IRIT_PT_RESET(Pts[p]);
+	for (l = 1; l <= MaxCoord; l++)
+	    Pts[p][l - 1] = IsNotRational ? Val[l] : Val[l] / Val[0];
+
+	if (Nrmls != NULL) {
+	    CagdVType Du, Dv;
+
+	    IRIT_VEC_RESET(Du);
+	    IRIT_VEC_RESET(Dv);
+	    for (l = 1; l <= MaxCoord; l++) {
+	        if (IsNotRational) {
+		    Du[l - 1] = DU[l];
+		    Dv[l - 1] = DV[l];
+		}
+		else {
+		    Du[l - 1] = (DU[l] - Pts[p][l - 1] * DU[0]) / Val[0];
+		    Dv[l - 1] = (DV[l] - Pts[p][l - 1] * DV[0]) / Val[0];
+		}
+	    }
+	    IRIT_CROSS_PROD(Nrmls[p], Du, Dv);
+	    IRIT_PT_NORMALIZE(Nrmls[p]);
+	}
+    }
+
+    return TRUE;
+}
@@ -1000,6 +1000,9 @@ static int UserGCSolveSetcover(UserGCProblemDefinitionStruct *Problem,
             break;
         }
         case USER_GC_EXACT: {
+            Res = MiscISCCalculateExact(Calc, 
+                Problem -> SolvingParams.SetCoverParams.Exact.SizeLimit,
+                SolutionByIndex, SolutionSize, CoverPart);
             break;
         }
         default: {
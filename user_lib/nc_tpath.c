@@ -810,6 +810,18 @@ IPObjectStruct *UserNCPocketToolPath(const IPObjectStruct *PObj,
         CagdCrvStruct *Crv,
 	    *Crvs = PRoughOffsetObj -> U.Crvs;
 	CagdPtStruct **PtsVec, *Pt;
+	CagdBBoxStruct CrvBBox;
+	IrtRType
+	    *CrvXRange = (IrtRType *)
+	        IritMalloc(sizeof(IrtRType) * 2 * CagdListLength(Crvs));
+
+	/* Keep the X range of every curve so we only intersect curves that */
+	/* can cross the current X line.				    */
+	for (i = 0, Crv = Crvs; Crv != NULL; Crv = Crv -> Pnext, i += 2) {
+	    CagdCrvBBox(Crv, &CrvBBox);
+	    CrvXRange[i] = CrvBBox.Min[0] - USER_NCPTP_SUBDIV_TOL;
+	    CrvXRange[i + 1] = CrvBBox.Max[0] + USER_NCPTP_SUBDIV_TOL;
+	}
 
         for (x = BBox.Min[0] - TPathSpace * 0.50000301060;
 	     x < BBox.Max[0];
@@ -822,7 +834,10 @@ IPObjectStruct *UserNCPocketToolPath(const IPObjectStruct *PObj,
 	    Line[1] = 0.0;
 	    Line[2] = x;
 
-	    for (Crv = Crvs; Crv != NULL; Crv = Crv -> Pnext) {
+	    for (i = 0, Crv = Crvs; Crv != NULL; Crv = Crv -> Pnext, i += 2) {
+	        if (x < CrvXRange[i] || x > CrvXRange[i + 1])
+		    continue;
+
 		Pts = SymbLclDistCrvLine(Crv, Line, USER_NCPTP_POCKET_EPS,
 					 TRUE, FALSE);
 
@@ -842,6 +857,7 @@ IPObjectStruct *UserNCPocketToolPath(const IPObjectStruct *PObj,
 	    if (((n = CagdListLength(CrvsPts)) & 0x01) != 0) {/*Must be even.*/
 	        IPFreePolygonList(Pllns);
 		CagdPtFreeList(CrvsPts);
+		IritFree(CrvXRange);
 		IPFreeObject(PRoughOffsetObj);
 		IPFreeObject(PToolOffsetObj);
 
@@ -876,6 +892,8 @@ IPObjectStruct *UserNCPocketToolPath(const IPObjectStruct *PObj,
 		CagdPtFreeList(CrvsPts);
 	    }
 	}
+
+	IritFree(CrvXRange);
     }
     else if IP_IS_POLY_OBJ(PRoughOffsetObj) {
 	if (IP_IS_POLYLINE_OBJ(PObj)) {
@@ -992,9 +1010,11 @@ IPObjectStruct *UserNCPocketToolPath(const IPObjectStruct *PObj,
 	    V2 = Pl2 -> PVertex,
 	    V2Last = IPGetLastVrtx(V2);
 
-	    /* Lets see if we are too near or too far. */
-	    if (V2 -> Coord[0] - V -> Coord[0] < TPathSpace * 0.5 ||
-		V2 -> Coord[0] - V -> Coord[0] > TPathSpace * 1.5)
+	    /* Lets see if we are too near or too far.  Polylines are      */
+	    /* ordered by X levels so once too far, all the rest are too.  */
+	    if (V2 -> Coord[0] - V -> Coord[0] > TPathSpace * 1.5)
+		break;
+	    if (V2 -> Coord[0] - V -> Coord[0] < TPathSpace * 0.5)
 		continue;
 
 	    /* We are in next X level (Dx is fixed and hence ignore it). */
@@ -1136,22 +1156,27 @@ static void UserNCPTPComputeOffset(const IPObjectStruct *PObj,
 					       OffsetTolerance,
 					       ToolRadius,
 					       TrimSelfInters));
-	*PRoughOffsettObj =
-	    IPGenCRVObject(UserNCOffsetCrvList(GlblUserNCPocketAccumCrvs,
-					       OffsetTolerance,
-					       RoughOffset,
-					       TrimSelfInters));
-	
+	if (ToolRadius == RoughOffset)   /* Reuse the tool radius offset. */
+	    *PRoughOffsettObj = IPCopyObject(NULL, *PToolOffsetObj, FALSE);
+	else
+	    *PRoughOffsettObj =
+	        IPGenCRVObject(UserNCOffsetCrvList(GlblUserNCPocketAccumCrvs,
+						   OffsetTolerance,
+						   RoughOffset,
+						   TrimSelfInters));
     }
     else if (GlblUserNCPocketAccumPls != NULL) {
         *PToolOffsetObj = UserNCOffsetPlList(GlblUserNCPocketAccumPls,
 					     OffsetTolerance,
 					     ToolRadius,
 					     TrimSelfInters);
-        *PRoughOffsettObj = UserNCOffsetPlList(GlblUserNCPocketAccumPls,
-					       OffsetTolerance,
-					       RoughOffset,
-					       TrimSelfInters);
+	if (ToolRadius == RoughOffset)   /* Reuse the tool radius offset. */
+	    *PRoughOffsettObj = IPCopyObject(NULL, *PToolOffsetObj, FALSE);
+	else
+	    *PRoughOffsettObj = UserNCOffsetPlList(GlblUserNCPocketAccumPls,
+						   OffsetTolerance,
+						   RoughOffset,
+						   TrimSelfInters);
     }
 }
 
@@ -26,6 +26,30 @@ typedef struct IntrSrfHierarchyStruct {
     CagdPolygonStruct *Triangles;
 } IntrSrfHierarchyStruct;
 
+#define INTR_SRFS_SAH_NUM_BINS	12
+#define INTR_SRFS_LEAF_MAX_TRIS	4
+#define INTR_SRFS_MAX_DEPTH	64
+
+typedef struct IntrSrfsTriStruct {
+    CagdPType Pts[3];
+    CagdUVType UVs[3];
+    int SrfIndex;
+} IntrSrfsTriStruct;
+
+/* A node of a flattened BVH.  The left child of an interior node is the    */
+/* node that follows it in the nodes' vector and Right is the right child.  */
+/* A leaf holds NumTris triangles from index First in the triangles vector. */
+typedef struct IntrSrfsNodeStruct {
+    CagdBBoxStruct BBox;
+    int Right, First, NumTris;
+} IntrSrfsNodeStruct;
+
+typedef struct IntrSrfsHierarchyStruct {
+    IntrSrfsNodeStruct *Nodes;
+    IntrSrfsTriStruct *Tris;
+    int NumNodes, NumTris;
+} IntrSrfsHierarchyStruct;
+
 IRIT_STATIC_DATA CagdRType
     GlblMinRayParam = IRIT_INFNTY,
     GlblMinDistSqr = IRIT_INFNTY,
@@ -54,6 +78,34 @@ static CagdBType PtMinMaxDist2BBox(CagdPType Pt,
 static int PtMinMaxTriangle(CagdPType Pt,
 			    CagdBType Nearest,
 			    CagdPolygonStruct *Tri);
+static void IntrSrfsTriBBox(const IntrSrfsTriStruct *Tri,
+			    CagdBBoxStruct *BBox);
+static CagdRType IntrSrfsBBoxArea(const CagdBBoxStruct *BBox);
+static void IntrSrfsSwapTris(IntrSrfsHierarchyStruct *ISH,
+			     CagdRType *Centers,
+			     int i,
+			     int j);
+static void IntrSrfsSelectMedian(IntrSrfsHierarchyStruct *ISH,
+				 CagdRType *Centers,
+				 int First,
+				 int Last,
+				 int Nth,
+				 int Axis);
+static int IntrSrfsBuildNodes(IntrSrfsHierarchyStruct *ISH,
+			      CagdRType *Centers,
+			      int First,
+			      int NumTris,
+			      int Depth);
+static CagdBType IntrSrfsRayHitBBox(const CagdPType RayOrigin,
+				    const CagdVType InvDir,
+				    const CagdBBoxStruct *BBox,
+				    CagdRType MaxT);
+static CagdBType IntrSrfsRayHitTri(const CagdPType RayOrigin,
+				   const CagdVType RayDir,
+				   const IntrSrfsTriStruct *Tri,
+				   CagdRType *t,
+				   CagdRType *u,
+				   CagdRType *v);
 
 /*****************************************************************************
 * DESCRIPTION:                                                               M
@@ -633,3 +685,690 @@ static int PtMinMaxTriangle(CagdPType Pt,
 
     return TRUE;
 }
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Preprocess a list of surfaces for fast computation of ray-surfaces       M
+* intersection.  All surfaces are polygonized into triangles that are kept   M
+* in one bounding volume hierarchy, built using the surface area heuristic   M
+* and stored as flat vectors.						     M
+*   Queries against the returned handle keep no global state and hence can   M
+* be made concurrently on the same handle.				     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Srfs:       List of surfaces to preprocess.                              M
+*   FineNess:   Tolerance of the adaptive polygonization of the surfaces,    M
+*		the smaller the finer.					     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   VoidPtr:  A handle on the preprocessed data, NULL if error.              M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IntrSrfsHierarchyFreePreprocess, IntrSrfsHierarchyTestRay,               M
+*   IntrSrfsHierarchyTestPtInside, IntrSrfHierarchyPreprocessSrf	     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IntrSrfsHierarchyPreprocess, ray surface intersection, BVH               M
+*****************************************************************************/
+VoidPtr IntrSrfsHierarchyPreprocess(const CagdSrfStruct *Srfs,
+				    IrtRType FineNess)
+{
+    int i, j, SrfIndex,
+        OldTriOnly = CagdSrfSetMakeOnlyTri(TRUE);
+    CagdRType *Centers;
+    CagdPolygonStruct *Tri,
+        *AllTris = NULL;
+    IntrSrfsHierarchyStruct *ISH;
+
+    for (SrfIndex = 0; Srfs != NULL; Srfs = Srfs -> Pnext, SrfIndex++) {
+        CagdPolygonStruct
+	    *Tris = CagdSrfAdap2Polygons(Srfs, FineNess, TRUE,
+					 TRUE, TRUE, NULL);
+
+	for (Tri = Tris; Tri != NULL; Tri = Tri -> Pnext)
+	    AttrSetIntAttrib(&Tri -> Attr, "_SrfIndex", SrfIndex);
+	AllTris = CagdListAppend(Tris, AllTris);
+    }
+
+    CagdSrfSetMakeOnlyTri(OldTriOnly);
+
+    if (AllTris == NULL)
+        return NULL;
+
+    ISH = (IntrSrfsHierarchyStruct *)
+                                IritMalloc(sizeof(IntrSrfsHierarchyStruct));
+    ISH -> NumTris = CagdListLength(AllTris);
+    ISH -> Tris = (IntrSrfsTriStruct *)
+                 IritMalloc(sizeof(IntrSrfsTriStruct) * ISH -> NumTris);
+    ISH -> Nodes = (IntrSrfsNodeStruct *)
+       IritMalloc(sizeof(IntrSrfsNodeStruct) * (2 * ISH -> NumTris - 1));
+    ISH -> NumNodes = 0;
+    Centers = (CagdRType *) IritMalloc(sizeof(CagdRType) * 3 * ISH -> NumTris);
+
+    for (Tri = AllTris, i = 0; Tri != NULL; Tri = Tri -> Pnext, i++) {
+        IntrSrfsTriStruct
+	    *T = &ISH -> Tris[i];
+
+	assert(Tri -> PolyType == CAGD_POLYGON_TYPE_TRIANGLE);
+
+        for (j = 0; j < 3; j++) {
+	    IRIT_PT_COPY(T -> Pts[j], Tri -> U.Polygon[j].Pt);
+	    IRIT_UV_COPY(T -> UVs[j], Tri -> U.Polygon[j].UV);
+	}
+	T -> SrfIndex = AttrGetIntAttrib(Tri -> Attr, "_SrfIndex");
+
+	for (j = 0; j < 3; j++)
+	    Centers[i * 3 + j] = (T -> Pts[0][j] + T -> Pts[1][j] +
+				  T -> Pts[2][j]) / 3.0;
+    }
+    CagdPolygonFreeList(AllTris);
+
+    IntrSrfsBuildNodes(ISH, Centers, 0, ISH -> NumTris, 0);
+
+    IritFree(Centers);
+
+    return ISH;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the bounding box of a triangle.                                 *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   Tri:     Triangle to compute its bbox.                                   *
+*   BBox:    Where to place the bbox.                                        *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IntrSrfsTriBBox(const IntrSrfsTriStruct *Tri,
+			    CagdBBoxStruct *BBox)
+{
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        BBox -> Min[i] = IRIT_MIN(IRIT_MIN(Tri -> Pts[0][i], Tri -> Pts[1][i]),
+				  Tri -> Pts[2][i]);
+        BBox -> Max[i] = IRIT_MAX(IRIT_MAX(Tri -> Pts[0][i], Tri -> Pts[1][i]),
+				  Tri -> Pts[2][i]);
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Computes the surface area of a bounding box, for the SAH cost.           *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   BBox:    Bounding box to compute its area.                               *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdRType:   The area, zero for an empty bbox.                           *
+*****************************************************************************/
+static CagdRType IntrSrfsBBoxArea(const CagdBBoxStruct *BBox)
+{
+    CagdVType D;
+
+    IRIT_VEC_SUB(D, BBox -> Max, BBox -> Min);
+    if (D[0] < 0.0 || D[1] < 0.0 || D[2] < 0.0)
+        return 0.0;
+
+    return 2.0 * (D[0] * D[1] + D[1] * D[2] + D[2] * D[0]);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Swaps triangles i and j, along with their centers.                       *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   ISH:       The hierarchy holding the triangles.                          *
+*   Centers:   Centers of the triangles, 3 reals per triangle.               *
+*   i, j:      Indices of the two triangles to swap.                         *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IntrSrfsSwapTris(IntrSrfsHierarchyStruct *ISH,
+			     CagdRType *Centers,
+			     int i,
+			     int j)
+{
+    int k;
+
+    IRIT_SWAP(IntrSrfsTriStruct, ISH -> Tris[i], ISH -> Tris[j]);
+    for (k = 0; k < 3; k++)
+        IRIT_SWAP(CagdRType, Centers[i * 3 + k], Centers[j * 3 + k]);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Reorders triangles First to Last (quickselect) so that triangle Nth has  *
+* the Nth smallest center along Axis, triangles before it have centers not   *
+* larger and triangles after it have centers not smaller.                    *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   ISH:       The hierarchy holding the triangles.                          *
+*   Centers:   Centers of the triangles, 3 reals per triangle.               *
+*   First:     Index of first triangle to process.                           *
+*   Last:      Index of last triangle to process.                            *
+*   Nth:       Index, between First and Last, to place in its sorted place.  *
+*   Axis:      Axis of the centers to order by.                              *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   void                                                                     *
+*****************************************************************************/
+static void IntrSrfsSelectMedian(IntrSrfsHierarchyStruct *ISH,
+				 CagdRType *Centers,
+				 int First,
+				 int Last,
+				 int Nth,
+				 int Axis)
+{
+    while (First < Last) {
+        int i = First,
+	    j = Last;
+	CagdRType
+	    Pivot = Centers[((First + Last) >> 1) * 3 + Axis];
+
+	/* Hoare partition around the middle triangle's center. */
+	while (i <= j) {
+	    while (Centers[i * 3 + Axis] < Pivot)
+	        i++;
+	    while (Centers[j * 3 + Axis] > Pivot)
+	        j--;
+	    if (i <= j)
+	        IntrSrfsSwapTris(ISH, Centers, i++, j--);
+	}
+
+	/* Continue in the part holding Nth only. */
+	if (Nth <= j)
+	    Last = j;
+	else if (Nth >= i)
+	    First = i;
+	else
+	    break;
+    }
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Recursively builds the BVH nodes of triangles First to First+NumTris-1,  *
+* in place.  Triangles are binned by their centers along each axis and the   *
+* split of minimal surface area heuristic cost is selected.  The triangles   *
+* (and their centers) are reordered so each node holds a consecutive range.  *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   ISH:       The hierarchy to build its nodes.                             *
+*   Centers:   Centers of the triangles, 3 reals per triangle.               *
+*   First:     Index of first triangle to process.                           *
+*   NumTris:   Number of triangles to process, at least one.                 *
+*   Depth:     Depth of the created node in the hierarchy.                   *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   int:      Index of the created node.                                     *
+*****************************************************************************/
+static int IntrSrfsBuildNodes(IntrSrfsHierarchyStruct *ISH,
+			      CagdRType *Centers,
+			      int First,
+			      int NumTris,
+			      int Depth)
+{
+    int i, j, Axis, Mid,
+	BestAxis = -1,
+	BestBin = -1,
+	Index = ISH -> NumNodes++;
+    CagdRType Cost, BestCost, CMin[3], CMax[3];
+    CagdBBoxStruct TriBBox;
+    IntrSrfsNodeStruct
+        *Node = &ISH -> Nodes[Index];
+
+    CAGD_RESET_BBOX((&Node -> BBox));
+    for (i = 0; i < 3; i++) {
+        CMin[i] = IRIT_INFNTY;
+	CMax[i] = -IRIT_INFNTY;
+    }
+    for (i = First; i < First + NumTris; i++) {
+        IntrSrfsTriBBox(&ISH -> Tris[i], &TriBBox);
+	CagdMergeBBox(&Node -> BBox, &TriBBox);
+	for (j = 0; j < 3; j++) {
+	    CMin[j] = IRIT_MIN(CMin[j], Centers[i * 3 + j]);
+	    CMax[j] = IRIT_MAX(CMax[j], Centers[i * 3 + j]);
+	}
+    }
+    Node -> Right = -1;
+    Node -> First = First;
+    Node -> NumTris = NumTris;
+
+    if (NumTris <= INTR_SRFS_LEAF_MAX_TRIS / 2 || Depth >= INTR_SRFS_MAX_DEPTH)
+        return Index;
+
+    /* Cost of keeping all triangles in this node as a leaf. */
+    BestCost = NumTris * IntrSrfsBBoxArea(&Node -> BBox);
+
+    for (Axis = 0; Axis < 3; Axis++) {
+        int Counts[INTR_SRFS_SAH_NUM_BINS];
+	CagdRType Scale, RightArea[INTR_SRFS_SAH_NUM_BINS];
+	CagdBBoxStruct BBoxes[INTR_SRFS_SAH_NUM_BINS], Acc;
+
+        if (CMax[Axis] - CMin[Axis] < IRIT_UEPS)
+	    continue;
+	Scale = INTR_SRFS_SAH_NUM_BINS / (CMax[Axis] - CMin[Axis]);
+
+	for (i = 0; i < INTR_SRFS_SAH_NUM_BINS; i++) {
+	    Counts[i] = 0;
+	    CAGD_RESET_BBOX((&BBoxes[i]));
+	}
+	for (i = First; i < First + NumTris; i++) {
+	    int b = (int) ((Centers[i * 3 + Axis] - CMin[Axis]) * Scale);
+
+	    b = IRIT_BOUND(b, 0, INTR_SRFS_SAH_NUM_BINS - 1);
+	    Counts[b]++;
+	    IntrSrfsTriBBox(&ISH -> Tris[i], &TriBBox);
+	    CagdMergeBBox(&BBoxes[b], &TriBBox);
+	}
+
+	/* Sweep from the right to get the area right of each split. */
+	CAGD_RESET_BBOX((&Acc));
+	for (i = INTR_SRFS_SAH_NUM_BINS - 1; i > 0; i--) {
+	    CagdMergeBBox(&Acc, &BBoxes[i]);
+	    RightArea[i] = IntrSrfsBBoxArea(&Acc);
+	}
+
+	/* And from the left, evaluating the cost of splitting before bin i. */
+	CAGD_RESET_BBOX((&Acc));
+	for (i = 1, j = 0; i < INTR_SRFS_SAH_NUM_BINS; i++) {
+	    int k,
+	        NumRight = 0;
+
+	    CagdMergeBBox(&Acc, &BBoxes[i - 1]);
+	    j += Counts[i - 1];
+	    for (k = i; k < INTR_SRFS_SAH_NUM_BINS; k++)
+	        NumRight += Counts[k];
+	    if (j == 0 || NumRight == 0)
+	        continue;
+
+	    Cost = j * IntrSrfsBBoxArea(&Acc) + NumRight * RightArea[i];
+	    if (Cost < BestCost) {
+	        BestCost = Cost;
+		BestAxis = Axis;
+		BestBin = i;
+	    }
+	}
+    }
+
+    if (BestAxis < 0) {
+        if (NumTris <= INTR_SRFS_LEAF_MAX_TRIS)
+	    return Index;
+
+	/* Too many triangles with no good split - split at the median. */
+	BestAxis = 0;
+	for (i = 1; i < 3; i++)
+	    if (CMax[i] - CMin[i] > CMax[BestAxis] - CMin[BestAxis])
+	        BestAxis = i;
+	Mid = First + NumTris / 2;
+	IntrSrfsSelectMedian(ISH, Centers, First, First + NumTris - 1,
+			     Mid, BestAxis);
+    }
+    else {
+        CagdRType
+	    Scale = INTR_SRFS_SAH_NUM_BINS / (CMax[BestAxis] - CMin[BestAxis]);
+
+        /* Partition the triangles in place, left of the best split first. */
+        for (i = First, Mid = First + NumTris; i < Mid; ) {
+	    int b = (int) ((Centers[i * 3 + BestAxis] - CMin[BestAxis]) *
+								       Scale);
+
+	    if (IRIT_BOUND(b, 0, INTR_SRFS_SAH_NUM_BINS - 1) < BestBin)
+	        i++;
+	    else {
+	        Mid--;
+		IntrSrfsSwapTris(ISH, Centers, i, Mid);
+	    }
+	}
+    }
+
+    /* The left child is always the next node, built first. */
+    Node -> First = -1;
+    Node -> NumTris = 0;
+    IntrSrfsBuildNodes(ISH, Centers, First, Mid - First, Depth + 1);
+    Node -> Right = IntrSrfsBuildNodes(ISH, Centers, Mid,
+				       First + NumTris - Mid, Depth + 1);
+
+    return Index;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Releases the pre processed data structed created by the function         M
+* IntrSrfsHierarchyPreprocess.                                               M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Handle:    As returned by IntrSrfsHierarchyPreprocess to release.        M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   void                                                                     M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IntrSrfsHierarchyPreprocess, IntrSrfsHierarchyTestRay,                   M
+*   IntrSrfsHierarchyTestPtInside					     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IntrSrfsHierarchyFreePreprocess, ray surface intersection                M
+*****************************************************************************/
+void IntrSrfsHierarchyFreePreprocess(VoidPtr Handle)
+{
+    IntrSrfsHierarchyStruct
+	*ISH = (IntrSrfsHierarchyStruct *) Handle;
+
+    IritFree(ISH -> Nodes);
+    IritFree(ISH -> Tris);
+    IritFree(ISH);
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Tests if the given ray hits the given bounding box before parameter MaxT.*
+*                                                                            *
+* PARAMETERS:                                                                *
+*   RayOrigin: Starting point of ray.                                        *
+*   InvDir:    Reciprocals of the coefficients of the direction of ray.      *
+*   BBox:      To test against ray.                                          *
+*   MaxT:      Maximal ray parameter of interest.                            *
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdBType:  TRUE if intersects, FALSE otherwise.                         *
+*****************************************************************************/
+static CagdBType IntrSrfsRayHitBBox(const CagdPType RayOrigin,
+				    const CagdVType InvDir,
+				    const CagdBBoxStruct *BBox,
+				    CagdRType MaxT)
+{
+    int i;
+    CagdRType
+	TMin = 0.0;
+
+    for (i = 0; i < 3; i++) {
+	CagdRType
+	    T1 = (BBox -> Min[i] - IRIT_EPS - RayOrigin[i]) * InvDir[i],
+	    T2 = (BBox -> Max[i] + IRIT_EPS - RayOrigin[i]) * InvDir[i];
+
+	if (T1 > T2)
+	    IRIT_SWAP(CagdRType, T1, T2);
+	if (T1 > TMin)
+	    TMin = T1;
+	if (T2 < MaxT)
+	    MaxT = T2;
+	if (TMin > MaxT)
+	    return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               *
+*   Tests if the given ray hits the given triangle at a positive parameter.  *
+*                                                                            *
+* PARAMETERS:                                                                *
+*   RayOrigin: Starting point of ray.                                        *
+*   RayDir:    Direction of ray.                                             *
+*   Tri:       Triangle to test against ray for intersection.                *
+*   t:         Ray parameter of the intersection is returned here.           *
+*   u, v:      Barycentric coordinates of the intersection of Pts[1], Pts[2].*
+*                                                                            *
+* RETURN VALUE:                                                              *
+*   CagdBType:  TRUE if intersects, FALSE otherwise.                         *
+*****************************************************************************/
+static CagdBType IntrSrfsRayHitTri(const CagdPType RayOrigin,
+				   const CagdVType RayDir,
+				   const IntrSrfsTriStruct *Tri,
+				   CagdRType *t,
+				   CagdRType *u,
+				   CagdRType *v)
+{
+    CagdRType Det, InvDet;
+    CagdVType E1, E2, P, Q, T;
+
+    IRIT_VEC_SUB(E1, Tri -> Pts[1], Tri -> Pts[0]);
+    IRIT_VEC_SUB(E2, Tri -> Pts[2], Tri -> Pts[0]);
+    IRIT_CROSS_PROD(P, RayDir, E2);
+    if (IRIT_FABS(Det = IRIT_DOT_PROD(E1, P)) < IRIT_UEPS)
+        return FALSE;			     /* Ray is parallel to triangle. */
+    InvDet = 1.0 / Det;
+
+    IRIT_VEC_SUB(T, RayOrigin, Tri -> Pts[0]);
+    *u = IRIT_DOT_PROD(T, P) * InvDet;
+    if (*u < -IRIT_UEPS || *u > 1.0 + IRIT_UEPS)
+        return FALSE;
+
+    IRIT_CROSS_PROD(Q, T, E1);
+    *v = IRIT_DOT_PROD(RayDir, Q) * InvDet;
+    if (*v < -IRIT_UEPS || *u + *v > 1.0 + IRIT_UEPS)
+        return FALSE;
+
+    *t = IRIT_DOT_PROD(E2, Q) * InvDet;
+
+    return *t > IRIT_UEPS;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Computes the first intersection of a given ray with the preprocessed     M
+* surfaces, if any, or just tests if any intersection exists.  Only          M
+* intersections at positive ray parameters are considered.		     M
+*   This function keeps no global state and can be invoked concurrently.     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Handle:    As returned by IntrSrfsHierarchyPreprocess.                   M
+*   RayOrigin: Starting point of ray.                                        M
+*   RayDir:    Direction of ray.                                             M
+*   AnyHit:    If TRUE, returns as soon as any intersection is found, which  M
+*	       is not necessarily the first one.			     M
+*   SrfIndex:  Index, in the preprocessed list, of the intersected surface.  M
+*	       Can be NULL if not needed.				     M
+*   InterUV:   The UV surface coordinates of the ray surface intersection    M
+*	       location is saved here.  Can be NULL if not needed.	     M
+*   InterT:    The ray parameter of the intersection location. Can be NULL.  M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   CagdBType: TRUE if found intersection, FALSE otherwise.                  M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IntrSrfsHierarchyPreprocess, IntrSrfsHierarchyTestPtInside,              M
+*   IntrSrfHierarchyTestRay						     M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IntrSrfsHierarchyTestRay, ray surface intersection                       M
+*****************************************************************************/
+CagdBType IntrSrfsHierarchyTestRay(VoidPtr Handle,
+				   const CagdPType RayOrigin,
+				   const CagdVType RayDir,
+				   CagdBType AnyHit,
+				   int *SrfIndex,
+				   CagdUVType InterUV,
+				   CagdRType *InterT)
+{
+    int i,
+	StackSize = 0,
+	Stack[INTR_SRFS_MAX_DEPTH + 2],
+	HitTri = -1;
+    CagdRType u, v, t,
+        HitU = 0.0,
+        HitV = 0.0,
+        MinT = IRIT_INFNTY;
+    CagdVType InvDir;
+    IntrSrfsHierarchyStruct
+	*ISH = (IntrSrfsHierarchyStruct *) Handle;
+
+    for (i = 0; i < 3; i++)
+        InvDir[i] = RayDir[i] == 0.0 ? IRIT_INFNTY : 1.0 / RayDir[i];
+
+    Stack[StackSize++] = 0;
+    while (StackSize > 0) {
+        const IntrSrfsNodeStruct
+	    *Node = &ISH -> Nodes[Stack[--StackSize]];
+
+	if (!IntrSrfsRayHitBBox(RayOrigin, InvDir, &Node -> BBox, MinT))
+	    continue;
+
+	if (Node -> Right < 0) {
+	    for (i = Node -> First; i < Node -> First + Node -> NumTris; i++) {
+	        if (IntrSrfsRayHitTri(RayOrigin, RayDir, &ISH -> Tris[i],
+				      &t, &u, &v) && t < MinT) {
+		    MinT = t;
+		    HitTri = i;
+		    HitU = u;
+		    HitV = v;
+		    if (AnyHit)
+		        break;
+		}
+	    }
+	    if (AnyHit && HitTri >= 0)
+	        break;
+	}
+	else {
+	    Stack[StackSize++] = Node -> Right;
+	    Stack[StackSize++] = (int) (Node - ISH -> Nodes) + 1;
+	}
+    }
+
+    if (HitTri < 0)
+        return FALSE;
+
+    if (SrfIndex != NULL)
+        *SrfIndex = ISH -> Tris[HitTri].SrfIndex;
+    if (InterUV != NULL) {
+        const IntrSrfsTriStruct
+	    *Tri = &ISH -> Tris[HitTri];
+
+        for (i = 0; i < 2; i++)
+	    InterUV[i] = Tri -> UVs[0][i] * (1.0 - HitU - HitV) +
+	                 Tri -> UVs[1][i] * HitU +
+	                 Tri -> UVs[2][i] * HitV;
+    }
+    if (InterT != NULL)
+        *InterT = MinT;
+
+    return TRUE;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Batched version of IntrSrfsHierarchyTestRay, intersecting NumRays rays   M
+* with the preprocessed surfaces.  The rays' results are independent and so  M
+* the batch can be split between threads, each invoking this function over   M
+* its own slice of the arrays.						     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Handle:     As returned by IntrSrfsHierarchyPreprocess.                  M
+*   NumRays:    Number of rays in RayOrigins/RayDirs.                        M
+*   RayOrigins: Starting points of the rays.                                 M
+*   RayDirs:    Directions of the rays.                                      M
+*   AnyHit:     If TRUE, only tests each ray for any intersection, which is  M
+*		not necessarily the first one.				     M
+*   SrfIndices: Index, in the preprocessed list, of the surface each ray     M
+*		intersects, or -1 if it misses.  Can be NULL if not needed.  M
+*   InterUVs:   The UV coordinates of each ray's intersection location.      M
+*		Unset for missing rays.  Can be NULL if not needed.	     M
+*   InterTs:    The ray parameter of each ray's intersection location, or    M
+*		IRIT_INFNTY if it misses.  Can be NULL if not needed.	     M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   int:    Number of rays that intersect the surfaces.                      M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IntrSrfsHierarchyPreprocess, IntrSrfsHierarchyTestRay                    M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IntrSrfsHierarchyTestRays, ray surface intersection                      M
+*****************************************************************************/
+int IntrSrfsHierarchyTestRays(VoidPtr Handle,
+			      int NumRays,
+			      const CagdPType *RayOrigins,
+			      const CagdVType *RayDirs,
+			      CagdBType AnyHit,
+			      int *SrfIndices,
+			      CagdUVType *InterUVs,
+			      CagdRType *InterTs)
+{
+    int i, SrfIndex,
+	NumHits = 0;
+    CagdRType InterT;
+    CagdUVType InterUV;
+
+    for (i = 0; i < NumRays; i++) {
+        if (IntrSrfsHierarchyTestRay(Handle, RayOrigins[i], RayDirs[i],
+				     AnyHit, &SrfIndex, InterUV, &InterT)) {
+	    NumHits++;
+	    if (InterUVs != NULL)
+	        IRIT_UV_COPY(InterUVs[i], InterUV);
+	}
+	else {
+	    SrfIndex = -1;
+	    InterT = IRIT_INFNTY;
+	}
+
+	if (SrfIndices != NULL)
+	    SrfIndices[i] = SrfIndex;
+	if (InterTs != NULL)
+	    InterTs[i] = InterT;
+    }
+
+    return NumHits;
+}
+
+/*****************************************************************************
+* DESCRIPTION:                                                               M
+*   Tests if the given point is inside the closed volume bounded by the      M
+* preprocessed surfaces, by counting the intersections of a ray from Pt.     M
+*   This function keeps no global state and can be invoked concurrently.     M
+*                                                                            *
+* PARAMETERS:                                                                M
+*   Handle:    As returned by IntrSrfsHierarchyPreprocess.                   M
+*   Pt:        Point to classify.                                            M
+*                                                                            *
+* RETURN VALUE:                                                              M
+*   CagdBType: TRUE if Pt is inside, FALSE otherwise.                        M
+*                                                                            *
+* SEE ALSO:                                                                  M
+*   IntrSrfsHierarchyPreprocess, IntrSrfsHierarchyTestRay                    M
+*                                                                            *
+* KEYWORDS:                                                                  M
+*   IntrSrfsHierarchyTestPtInside, point inclusion                           M
+*****************************************************************************/
+CagdBType IntrSrfsHierarchyTestPtInside(VoidPtr Handle, const CagdPType Pt)
+{
+    int i,
+        StackSize = 0,
+	Stack[INTR_SRFS_MAX_DEPTH + 2],
+	NumInters = 0;
+    CagdRType u, v, t;
+    CagdVType InvDir,
+        /* A direction unlikely to be aligned with edges or vertices. */
+        RayDir = { 0.5773125, 0.5773807, 0.5773571 };
+    IntrSrfsHierarchyStruct
+	*ISH = (IntrSrfsHierarchyStruct *) Handle;
+
+    for (i = 0; i < 3; i++)
+        InvDir[i] = 1.0 / RayDir[i];
+
+    Stack[StackSize++] = 0;
+    while (StackSize > 0) {
+        const IntrSrfsNodeStruct
+	    *Node = &ISH -> Nodes[Stack[--StackSize]];
+
+	if (!IntrSrfsRayHitBBox(Pt, InvDir, &Node -> BBox, IRIT_INFNTY))
+	    continue;
+
+	if (Node -> Right < 0) {
+	    for (i = Node -> First; i < Node -> First + Node -> NumTris; i++)
+	        if (IntrSrfsRayHitTri(Pt, RayDir, &ISH -> Tris[i], &t, &u, &v))
+		    NumInters++;
+	}
+	else {
+	    Stack[StackSize++] = Node -> Right;
+	    Stack[StackSize++] = (int) (Node - ISH -> Nodes) + 1;
+	}
+    }
+
+    return NumInters & 0x01;
+}